@@ -0,0 +1,1100 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_BIG_INTEGER_H_
+#define AM_NUMERIC_BIG_INTEGER_H_
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <limits>
+#include <string>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <istream>
+
+#include "traits.h"
+#include "gcd.h"
+#include "overflow.h"
+#include "block_pool.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * MAGNITUDE ARITHMETIC
+ *
+ * on little-endian arrays of 32-bit limbs
+ *
+ *****************************************************************************/
+namespace detail {
+
+using limb_t  = std::uint32_t;
+using dlimb_t = std::uint64_t;
+
+constexpr int limb_bits = 32;
+
+
+//-------------------------------------------------------------------
+/// @brief pooled scratch buffer
+class limb_buffer
+{
+public:
+    explicit
+    limb_buffer(std::size_t n):
+        cap_{n}, p_{block_pool<limb_t>::allocate(cap_)}
+    {}
+
+    ~limb_buffer() {
+        if(p_) block_pool<limb_t>::deallocate(p_, cap_);
+    }
+
+    limb_buffer(const limb_buffer&) = delete;
+    limb_buffer& operator = (const limb_buffer&) = delete;
+
+    limb_t* data() noexcept { return p_; }
+    std::size_t capacity() const noexcept { return cap_; }
+
+    /// @brief transfers ownership
+    limb_t* release() noexcept {
+        auto p = p_;
+        p_ = nullptr;
+        return p;
+    }
+
+private:
+    std::size_t cap_;
+    limb_t* p_;
+};
+
+
+//-------------------------------------------------------------------
+inline std::size_t
+trimmed_size(const limb_t* a, std::size_t n) noexcept
+{
+    while(n > 0 && a[n-1] == 0) --n;
+    return n;
+}
+
+
+//-------------------------------------------------------------------
+inline int
+compare_limbs(const limb_t* a, std::size_t an,
+              const limb_t* b, std::size_t bn) noexcept
+{
+    if(an != bn) return (an < bn) ? -1 : 1;
+    for(std::size_t i = an; i-- > 0; ) {
+        if(a[i] != b[i]) return (a[i] < b[i]) ? -1 : 1;
+    }
+    return 0;
+}
+
+
+//-------------------------------------------------------------------
+/// @brief out[0,an] = a + b; requires an >= bn
+inline void
+add_limbs(const limb_t* a, std::size_t an,
+          const limb_t* b, std::size_t bn, limb_t* out) noexcept
+{
+    dlimb_t carry = 0;
+    std::size_t i = 0;
+    for(; i < bn; ++i) {
+        carry += dlimb_t(a[i]) + dlimb_t(b[i]);
+        out[i] = limb_t(carry);
+        carry >>= limb_bits;
+    }
+    for(; i < an; ++i) {
+        carry += dlimb_t(a[i]);
+        out[i] = limb_t(carry);
+        carry >>= limb_bits;
+    }
+    out[an] = limb_t(carry);
+}
+
+
+//-------------------------------------------------------------------
+/// @brief out[0,an) = a - b; requires a >= b
+inline void
+sub_limbs(const limb_t* a, std::size_t an,
+          const limb_t* b, std::size_t bn, limb_t* out) noexcept
+{
+    dlimb_t borrow = 0;
+    std::size_t i = 0;
+    for(; i < bn; ++i) {
+        const dlimb_t d = dlimb_t(a[i]) - dlimb_t(b[i]) - borrow;
+        out[i] = limb_t(d);
+        borrow = d >> 63;
+    }
+    for(; i < an; ++i) {
+        const dlimb_t d = dlimb_t(a[i]) - borrow;
+        out[i] = limb_t(d);
+        borrow = d >> 63;
+    }
+}
+
+
+//-------------------------------------------------------------------
+/// @brief out[0,an+bn) = a * b (schoolbook)
+inline void
+mul_limbs(const limb_t* a, std::size_t an,
+          const limb_t* b, std::size_t bn, limb_t* out) noexcept
+{
+    std::fill(out, out + an + bn, limb_t(0));
+    for(std::size_t i = 0; i < an; ++i) {
+        const dlimb_t ai = a[i];
+        if(ai == 0) continue;
+        dlimb_t carry = 0;
+        for(std::size_t j = 0; j < bn; ++j) {
+            carry += ai * b[j] + out[i+j];
+            out[i+j] = limb_t(carry);
+            carry >>= limb_bits;
+        }
+        out[i+bn] = limb_t(carry);
+    }
+}
+
+
+//-------------------------------------------------------------------
+/// @brief q[0,an) = a / v; returns remainder
+inline limb_t
+div_limbs(const limb_t* a, std::size_t an, limb_t v, limb_t* q) noexcept
+{
+    dlimb_t r = 0;
+    for(std::size_t i = an; i-- > 0; ) {
+        const dlimb_t x = (r << limb_bits) | a[i];
+        q[i] = limb_t(x / v);
+        r = x % v;
+    }
+    return limb_t(r);
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief long division (Knuth, TAOCP Vol. 2, Algorithm D)
+ *        q[0,un-vn] = u / v, r[0,vn) = u % v; requires un >= vn >= 2
+ *        and v[vn-1] != 0
+ */
+inline void
+divmod_limbs(const limb_t* u, std::size_t un,
+             const limb_t* v, std::size_t vn, limb_t* q, limb_t* r)
+{
+    constexpr dlimb_t b = dlimb_t(1) << limb_bits;
+
+    //normalize: shift v so that its top bit is set
+    int s = 0;
+    while(!(v[vn-1] & (limb_t(1) << (limb_bits - 1 - s)))) ++s;
+
+    limb_buffer vbuf {vn};
+    limb_buffer ubuf {un + 1};
+    auto vs = vbuf.data();
+    auto us = ubuf.data();
+
+    if(s > 0) {
+        for(std::size_t i = vn - 1; i > 0; --i) {
+            vs[i] = (v[i] << s) | (v[i-1] >> (limb_bits - s));
+        }
+        vs[0] = v[0] << s;
+        us[un] = u[un-1] >> (limb_bits - s);
+        for(std::size_t i = un - 1; i > 0; --i) {
+            us[i] = (u[i] << s) | (u[i-1] >> (limb_bits - s));
+        }
+        us[0] = u[0] << s;
+    } else {
+        std::copy(v, v + vn, vs);
+        std::copy(u, u + un, us);
+        us[un] = 0;
+    }
+
+    for(std::size_t j = un - vn + 1; j-- > 0; ) {
+        //estimate quotient digit from the top two limbs
+        const dlimb_t num = (dlimb_t(us[j+vn]) << limb_bits) | us[j+vn-1];
+        dlimb_t qhat = num / vs[vn-1];
+        dlimb_t rhat = num % vs[vn-1];
+        while(qhat >= b ||
+              qhat * vs[vn-2] > ((rhat << limb_bits) | us[j+vn-2]))
+        {
+            --qhat;
+            rhat += vs[vn-1];
+            if(rhat >= b) break;
+        }
+
+        //multiply and subtract
+        std::int64_t k = 0;
+        std::int64_t t = 0;
+        for(std::size_t i = 0; i < vn; ++i) {
+            const dlimb_t p = qhat * vs[i];
+            t = std::int64_t(us[i+j]) - k - std::int64_t(p & 0xFFFFFFFFu);
+            us[i+j] = limb_t(t);
+            k = std::int64_t(p >> limb_bits) - (t >> limb_bits);
+        }
+        t = std::int64_t(us[j+vn]) - k;
+        us[j+vn] = limb_t(t);
+
+        q[j] = limb_t(qhat);
+        //qhat was one too large: add back
+        if(t < 0) {
+            --q[j];
+            dlimb_t c = 0;
+            for(std::size_t i = 0; i < vn; ++i) {
+                c += dlimb_t(us[i+j]) + vs[i];
+                us[i+j] = limb_t(c);
+                c >>= limb_bits;
+            }
+            us[j+vn] = limb_t(us[j+vn] + c);
+        }
+    }
+
+    //unnormalize remainder
+    if(s > 0) {
+        for(std::size_t i = 0; i < vn - 1; ++i) {
+            r[i] = (us[i] >> s) | (us[i+1] << (limb_bits - s));
+        }
+        r[vn-1] = us[vn-1] >> s;
+    } else {
+        std::copy(us, us + vn, r);
+    }
+}
+
+}  // namespace detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief arbitrary-precision signed integer
+ *
+ * Values that fit into 64 bits are stored inline and handled with
+ * native arithmetic (overflow is detected with compiler builtins);
+ * only larger values spill to heap limbs taken from a thread-local pool.
+ *
+ * Division truncates towards zero, the remainder has the sign
+ * of the dividend (like builtin integers).
+ *
+ *****************************************************************************/
+class big_integer
+{
+    using limb_t = detail::limb_t;
+    using pool   = detail::block_pool<limb_t>;
+
+public:
+    //---------------------------------------------------------------
+    using numeric_type = big_integer;
+
+
+    //---------------------------------------------------------------
+    big_integer() noexcept:
+        u_{0}, size_{0}, cap_{0}, neg_{false}
+    {}
+
+    template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
+    big_integer(T x):
+        u_{0}, size_{0}, cap_{0}, neg_{false}
+    {
+        assign_integral(x, std::is_signed<T>{});
+    }
+
+    explicit
+    big_integer(const std::string& digits):
+        big_integer{}
+    {
+        from_string(digits);
+    }
+
+    //---------------------------------------------------------------
+    big_integer(const big_integer& src):
+        u_(src.u_), size_{0}, cap_{0}, neg_{src.neg_}
+    {
+        if(!src.is_small()) {
+            std::size_t cap = src.size_;
+            u_.limbs = pool::allocate(cap);
+            std::copy(src.u_.limbs, src.u_.limbs + src.size_, u_.limbs);
+            size_ = src.size_;
+            cap_ = std::uint32_t(cap);
+        }
+    }
+
+    big_integer(big_integer&& src) noexcept:
+        u_(src.u_), size_{src.size_}, cap_{src.cap_}, neg_{src.neg_}
+    {
+        src.u_.small = 0;
+        src.size_ = 0;
+        src.cap_ = 0;
+        src.neg_ = false;
+    }
+
+
+    //---------------------------------------------------------------
+    big_integer&
+    operator = (const big_integer& src) {
+        if(this != &src) {
+            big_integer tmp {src};
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    big_integer&
+    operator = (big_integer&& src) noexcept {
+        swap(src);
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    ~big_integer() {
+        release();
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief true, if the value is stored inline
+    bool
+    is_small() const noexcept {
+        return cap_ == 0;
+    }
+
+    int
+    sign() const noexcept {
+        if(is_small()) return (u_.small > 0) - (u_.small < 0);
+        return neg_ ? -1 : 1;
+    }
+
+    /// @brief number of significant bits of the magnitude
+    std::size_t
+    bit_length() const noexcept {
+        if(is_small()) {
+            return std::size_t(detail::bit_length(detail::unsigned_abs(u_.small)));
+        }
+        return (size_ - 1) * detail::limb_bits +
+            std::size_t(detail::bit_length(std::uint64_t(u_.limbs[size_-1])));
+    }
+
+
+    //---------------------------------------------------------------
+    template<class T, class = std::enable_if_t<std::is_arithmetic<T>::value>>
+    explicit operator
+    T() const {
+        if(is_small()) return T(u_.small);
+        return to_arithmetic<T>(std::is_floating_point<T>{});
+    }
+
+    explicit operator
+    bool() const noexcept {
+        return !is_small() || u_.small != 0;
+    }
+
+
+    //---------------------------------------------------------------
+    void
+    swap(big_integer& o) noexcept {
+        using std::swap;
+        swap(u_, o.u_);
+        swap(size_, o.size_);
+        swap(cap_, o.cap_);
+        swap(neg_, o.neg_);
+    }
+
+
+    //---------------------------------------------------------------
+    big_integer&
+    negate() noexcept {
+        if(is_small()) {
+            if(u_.small != std::numeric_limits<std::int64_t>::min()) {
+                u_.small = -u_.small;
+            } else {
+                assign_magnitude(std::uint64_t(1) << 63, false);
+            }
+        } else {
+            neg_ = !neg_;
+            shrink();
+        }
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    big_integer&
+    operator += (const big_integer& o) {
+        std::int64_t r;
+        if(is_small() && o.is_small() &&
+           !detail::add_overflow(u_.small, o.u_.small, r))
+        {
+            u_.small = r;
+            return *this;
+        }
+        return add_big(o, o.sign() < 0);
+    }
+
+    big_integer&
+    operator -= (const big_integer& o) {
+        std::int64_t r;
+        if(is_small() && o.is_small() &&
+           !detail::sub_overflow(u_.small, o.u_.small, r))
+        {
+            u_.small = r;
+            return *this;
+        }
+        return add_big(o, o.sign() > 0);
+    }
+
+    big_integer&
+    operator *= (const big_integer& o) {
+        std::int64_t r;
+        if(is_small() && o.is_small() &&
+           !detail::mul_overflow(u_.small, o.u_.small, r))
+        {
+            u_.small = r;
+            return *this;
+        }
+        return mul_big(o);
+    }
+
+    big_integer&
+    operator /= (const big_integer& o) {
+        assert(o.sign() != 0);
+        if(is_small() && o.is_small() &&
+           (u_.small != std::numeric_limits<std::int64_t>::min() || o.u_.small != -1))
+        {
+            u_.small /= o.u_.small;
+            return *this;
+        }
+        big_integer q, r;
+        divmod_big(*this, o, q, r);
+        return (*this = std::move(q));
+    }
+
+    big_integer&
+    operator %= (const big_integer& o) {
+        assert(o.sign() != 0);
+        if(is_small() && o.is_small()) {
+            u_.small = (o.u_.small == -1) ? 0 : (u_.small % o.u_.small);
+            return *this;
+        }
+        big_integer q, r;
+        divmod_big(*this, o, q, r);
+        return (*this = std::move(r));
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief multiplies by 2^k
+    big_integer&
+    operator <<= (std::size_t k) {
+        if(k == 0 || sign() == 0) return *this;
+        if(is_small() && k < 62 &&
+           detail::unsigned_abs(u_.small) < (std::uint64_t(1) << (62 - k)))
+        {
+            u_.small *= (std::int64_t(1) << k);
+            return *this;
+        }
+        mag m {*this};
+        const auto ls = k / detail::limb_bits;
+        const auto bs = int(k % detail::limb_bits);
+        detail::limb_buffer out {m.n + ls + 1};
+        auto o = out.data();
+        std::fill(o, o + ls, limb_t(0));
+        o[m.n + ls] = 0;
+        if(bs == 0) {
+            std::copy(m.p, m.p + m.n, o + ls);
+        } else {
+            limb_t carry = 0;
+            for(std::size_t i = 0; i < m.n; ++i) {
+                o[i+ls] = (m.p[i] << bs) | carry;
+                carry = m.p[i] >> (detail::limb_bits - bs);
+            }
+            o[m.n + ls] = carry;
+        }
+        adopt(out, m.n + ls + 1, m.neg);
+        return *this;
+    }
+
+    /// @brief divides by 2^k (truncating towards zero)
+    big_integer&
+    operator >>= (std::size_t k) {
+        if(k == 0) return *this;
+        if(is_small()) {
+            const auto m = detail::unsigned_abs(u_.small);
+            const auto r = (k < 64) ? std::int64_t(m >> k) : std::int64_t(0);
+            u_.small = (u_.small < 0) ? -r : r;
+            return *this;
+        }
+        const auto ls = k / detail::limb_bits;
+        const auto bs = int(k % detail::limb_bits);
+        if(ls >= size_) return (*this = big_integer{});
+        const auto n = size_ - ls;
+        detail::limb_buffer out {n};
+        auto o = out.data();
+        for(std::size_t i = 0; i < n; ++i) {
+            const auto hi = (bs > 0 && i + ls + 1 < size_)
+                ? (u_.limbs[i+ls+1] << (detail::limb_bits - bs)) : limb_t(0);
+            o[i] = (u_.limbs[i+ls] >> bs) | hi;
+        }
+        adopt(out, n, neg_);
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    big_integer& operator ++ () { return (*this += big_integer{1}); }
+    big_integer& operator -- () { return (*this -= big_integer{1}); }
+
+    big_integer operator ++ (int) { auto old = *this; ++*this; return old; }
+    big_integer operator -- (int) { auto old = *this; --*this; return old; }
+
+
+    //---------------------------------------------------------------
+    friend big_integer
+    operator + (big_integer a, const big_integer& b) { return a += b; }
+
+    friend big_integer
+    operator - (big_integer a, const big_integer& b) { return a -= b; }
+
+    friend big_integer
+    operator * (big_integer a, const big_integer& b) { return a *= b; }
+
+    friend big_integer
+    operator / (big_integer a, const big_integer& b) { return a /= b; }
+
+    friend big_integer
+    operator % (big_integer a, const big_integer& b) { return a %= b; }
+
+    friend big_integer
+    operator << (big_integer a, std::size_t k) { return a <<= k; }
+
+    friend big_integer
+    operator >> (big_integer a, std::size_t k) { return a >>= k; }
+
+    friend big_integer
+    operator - (big_integer a) { return a.negate(); }
+
+    friend big_integer
+    operator + (const big_integer& a) { return a; }
+
+
+    //---------------------------------------------------------------
+    friend int
+    compare(const big_integer& a, const big_integer& b) noexcept {
+        if(a.is_small() && b.is_small()) {
+            return (a.u_.small < b.u_.small) ? -1 : ((b.u_.small < a.u_.small) ? 1 : 0);
+        }
+        const int sa = a.sign();
+        const int sb = b.sign();
+        if(sa != sb) return (sa < sb) ? -1 : 1;
+        //same sign, at least one is big => magnitudes decide
+        mag ma {a};
+        mag mb {b};
+        const int c = detail::compare_limbs(ma.p, ma.n, mb.p, mb.n);
+        return (sa < 0) ? -c : c;
+    }
+
+    friend bool
+    operator == (const big_integer& a, const big_integer& b) noexcept {
+        return compare(a, b) == 0;
+    }
+    friend bool
+    operator != (const big_integer& a, const big_integer& b) noexcept {
+        return compare(a, b) != 0;
+    }
+    friend bool
+    operator <  (const big_integer& a, const big_integer& b) noexcept {
+        return compare(a, b) < 0;
+    }
+    friend bool
+    operator <= (const big_integer& a, const big_integer& b) noexcept {
+        return compare(a, b) <= 0;
+    }
+    friend bool
+    operator >  (const big_integer& a, const big_integer& b) noexcept {
+        return compare(a, b) > 0;
+    }
+    friend bool
+    operator >= (const big_integer& a, const big_integer& b) noexcept {
+        return compare(a, b) >= 0;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief quotient and remainder in one go
+    friend void
+    divmod(const big_integer& a, const big_integer& b,
+           big_integer& quot, big_integer& rem)
+    {
+        assert(b.sign() != 0);
+        if(a.is_small() && b.is_small() &&
+           (a.u_.small != std::numeric_limits<std::int64_t>::min() || b.u_.small != -1))
+        {
+            quot = big_integer{a.u_.small / b.u_.small};
+            rem  = big_integer{a.u_.small % b.u_.small};
+            return;
+        }
+        divmod_big(a, b, quot, rem);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief decimal representation
+    std::string
+    str() const {
+        if(is_small()) return std::to_string(u_.small);
+
+        detail::limb_buffer buf {size_};
+        auto q = buf.data();
+        std::copy(u_.limbs, u_.limbs + size_, q);
+        std::size_t n = size_;
+
+        std::string s;
+        while(n > 0) {
+            auto r = detail::div_limbs(q, n, 1000000000u, q);
+            n = detail::trimmed_size(q, n);
+            for(int i = 0; i < 9 && (n > 0 || r > 0); ++i) {
+                s.push_back(char('0' + (r % 10)));
+                r /= 10;
+            }
+        }
+        if(neg_) s.push_back('-');
+        std::reverse(s.begin(), s.end());
+        return s;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    /// @brief read-only view of the magnitude of any value
+    struct mag {
+        explicit
+        mag(const big_integer& x) noexcept {
+            if(x.is_small()) {
+                const auto m = detail::unsigned_abs(x.u_.small);
+                buf[0] = limb_t(m);
+                buf[1] = limb_t(m >> detail::limb_bits);
+                p = buf;
+                n = detail::trimmed_size(buf, 2);
+                neg = x.u_.small < 0;
+            } else {
+                p = x.u_.limbs;
+                n = x.size_;
+                neg = x.neg_;
+            }
+        }
+        mag(const mag&) = delete;
+        mag& operator = (const mag&) = delete;
+
+        limb_t buf[2];
+        const limb_t* p;
+        std::size_t n;
+        bool neg;
+    };
+
+
+    //---------------------------------------------------------------
+    template<class T>
+    void
+    assign_integral(T x, std::true_type /* signed */) {
+        u_.small = std::int64_t(x);
+    }
+
+    template<class T>
+    void
+    assign_integral(T x, std::false_type /* unsigned */) {
+        if(std::uint64_t(x) > std::uint64_t(std::numeric_limits<std::int64_t>::max())) {
+            assign_magnitude(std::uint64_t(x), false);
+        } else {
+            u_.small = std::int64_t(x);
+        }
+    }
+
+    /// @brief for magnitudes that don't fit into int64
+    void
+    assign_magnitude(std::uint64_t m, bool negative) {
+        detail::limb_buffer out {2};
+        out.data()[0] = limb_t(m);
+        out.data()[1] = limb_t(m >> detail::limb_bits);
+        adopt(out, 2, negative);
+    }
+
+
+    //---------------------------------------------------------------
+    void
+    release() noexcept {
+        if(!is_small()) {
+            pool::deallocate(u_.limbs, cap_);
+            cap_ = 0;
+            size_ = 0;
+            u_.small = 0;
+        }
+    }
+
+    /// @brief takes over the limbs in 'buf' as new magnitude
+    void
+    adopt(detail::limb_buffer& buf, std::size_t n, bool negative) {
+        release();
+        size_ = std::uint32_t(detail::trimmed_size(buf.data(), n));
+        cap_ = std::uint32_t(buf.capacity());
+        u_.limbs = buf.release();
+        neg_ = negative;
+        shrink();
+    }
+
+    /// @brief moves the value back inline if it fits
+    void
+    shrink() noexcept {
+        if(is_small() || size_ > 2) return;
+        std::uint64_t m = 0;
+        if(size_ > 0) m = u_.limbs[0];
+        if(size_ > 1) m |= std::uint64_t(u_.limbs[1]) << detail::limb_bits;
+        constexpr auto max = std::uint64_t(std::numeric_limits<std::int64_t>::max());
+        if(m <= max || (neg_ && m == max + 1)) {
+            const bool negative = neg_;
+            pool::deallocate(u_.limbs, cap_);
+            cap_ = 0;
+            size_ = 0;
+            neg_ = false;
+            u_.small = negative ? std::int64_t(std::uint64_t(0) - m) : std::int64_t(m);
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief *this += (negative ? -|o| : |o|)
+    big_integer&
+    add_big(const big_integer& o, bool negative) {
+        mag a {*this};
+        mag b {o};
+        if(a.neg == negative) {
+            //same sign: add magnitudes
+            const bool swapped = a.n < b.n;
+            const auto& x = swapped ? b : a;
+            const auto& y = swapped ? a : b;
+            detail::limb_buffer out {x.n + 1};
+            detail::add_limbs(x.p, x.n, y.p, y.n, out.data());
+            adopt(out, x.n + 1, negative);
+        } else {
+            //different signs: subtract smaller from larger magnitude
+            const int c = detail::compare_limbs(a.p, a.n, b.p, b.n);
+            if(c == 0) return (*this = big_integer{});
+            const auto& x = (c > 0) ? a : b;
+            const auto& y = (c > 0) ? b : a;
+            detail::limb_buffer out {x.n};
+            detail::sub_limbs(x.p, x.n, y.p, y.n, out.data());
+            adopt(out, x.n, (c > 0) ? a.neg : negative);
+        }
+        return *this;
+    }
+
+    //---------------------------------------------------------------
+    big_integer&
+    mul_big(const big_integer& o) {
+        mag a {*this};
+        mag b {o};
+        if(a.n == 0 || b.n == 0) return (*this = big_integer{});
+        detail::limb_buffer out {a.n + b.n};
+        detail::mul_limbs(a.p, a.n, b.p, b.n, out.data());
+        adopt(out, a.n + b.n, a.neg != b.neg);
+        return *this;
+    }
+
+    //---------------------------------------------------------------
+    static void
+    divmod_big(const big_integer& x, const big_integer& y,
+               big_integer& quot, big_integer& rem)
+    {
+        mag a {x};
+        mag b {y};
+        const bool qneg = a.neg != b.neg;
+        const bool rneg = a.neg;
+
+        if(detail::compare_limbs(a.p, a.n, b.p, b.n) < 0) {
+            rem = x;
+            quot = big_integer{};
+            return;
+        }
+
+        detail::limb_buffer q {a.n};
+        if(b.n == 1) {
+            const auto r = detail::div_limbs(a.p, a.n, b.p[0], q.data());
+            big_integer rr {r};
+            if(rneg) rr.negate();
+            quot.adopt(q, a.n, qneg);
+            rem = std::move(rr);
+        } else {
+            detail::limb_buffer r {b.n};
+            detail::divmod_limbs(a.p, a.n, b.p, b.n, q.data(), r.data());
+            big_integer qq, rr;
+            qq.adopt(q, a.n - b.n + 1, qneg);
+            rr.adopt(r, b.n, rneg);
+            quot = std::move(qq);
+            rem = std::move(rr);
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    template<class T>
+    T
+    to_arithmetic(std::true_type /* floating point */) const {
+        using std::ldexp;
+        T r = T(0);
+        for(std::size_t i = size_; i-- > 0; ) {
+            r = ldexp(r, detail::limb_bits) + T(u_.limbs[i]);
+        }
+        return neg_ ? -r : r;
+    }
+
+    template<class T>
+    T
+    to_arithmetic(std::false_type) const {
+        //wraps around like builtin conversions
+        std::uint64_t m = u_.limbs[0];
+        if(size_ > 1) m |= std::uint64_t(u_.limbs[1]) << detail::limb_bits;
+        return T(neg_ ? std::uint64_t(0) - m : m);
+    }
+
+
+    //---------------------------------------------------------------
+    void
+    from_string(const std::string& s) {
+        std::size_t i = 0;
+        bool negative = false;
+        if(i < s.size() && (s[i] == '-' || s[i] == '+')) {
+            negative = (s[i] == '-');
+            ++i;
+        }
+        const big_integer chunk_base {1000000000};
+        while(i < s.size()) {
+            std::int64_t chunk = 0;
+            std::int64_t scale = 1;
+            for(int k = 0; k < 9 && i < s.size(); ++k, ++i) {
+                assert(s[i] >= '0' && s[i] <= '9');
+                chunk = chunk * 10 + (s[i] - '0');
+                scale *= 10;
+            }
+            *this *= (scale == 1000000000) ? chunk_base : big_integer{scale};
+            *this += big_integer{chunk};
+        }
+        if(negative) negate();
+    }
+
+
+    //---------------------------------------------------------------
+    union storage {
+        std::int64_t small;
+        limb_t* limbs;
+    };
+
+    storage u_;
+    std::uint32_t size_;
+    std::uint32_t cap_;     //0 => value is stored inline in u_.small
+    bool neg_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * FUNCTIONS
+ *
+ *****************************************************************************/
+inline void
+swap(big_integer& a, big_integer& b) noexcept
+{
+    a.swap(b);
+}
+
+
+//-------------------------------------------------------------------
+inline big_integer
+abs(const big_integer& x)
+{
+    return (x.sign() < 0) ? -x : x;
+}
+
+
+//-------------------------------------------------------------------
+/// @brief greatest common divisor (always non-negative)
+inline big_integer
+gcd(big_integer a, big_integer b)
+{
+    if(a.is_small() && b.is_small()) {
+        const auto g = detail::binary_gcd(
+            detail::unsigned_abs(static_cast<std::int64_t>(a)),
+            detail::unsigned_abs(static_cast<std::int64_t>(b)));
+        return big_integer{g};
+    }
+    if(a.sign() < 0) a.negate();
+    if(b.sign() < 0) b.negate();
+    while(b.sign() != 0) {
+        //finish natively as soon as both fit into 64 bits
+        if(a.is_small() && b.is_small()) return gcd(a, b);
+        a %= b;
+        a.swap(b);
+    }
+    return a;
+}
+
+
+//-------------------------------------------------------------------
+inline big_integer
+lcm(const big_integer& a, const big_integer& b)
+{
+    if(a.sign() == 0 || b.sign() == 0) return big_integer{};
+    return abs((a / gcd(a, b)) * b);
+}
+
+
+//-------------------------------------------------------------------
+/// @brief b^e by repeated squaring
+inline big_integer
+pow(big_integer b, std::uint64_t e)
+{
+    big_integer r {1};
+    while(e > 0) {
+        if(e & 1) r *= b;
+        e >>= 1;
+        if(e > 0) b *= b;
+    }
+    return r;
+}
+
+
+//-------------------------------------------------------------------
+inline std::string
+to_string(const big_integer& x)
+{
+    return x.str();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * I/O
+ *
+ *****************************************************************************/
+template<class Ostream>
+inline Ostream&
+operator << (Ostream& os, const big_integer& x)
+{
+    os << x.str();
+    return os;
+}
+
+//-------------------------------------------------------------------
+template<class Istream>
+inline Istream&
+operator >> (Istream& is, big_integer& x)
+{
+    std::string s;
+    is >> std::ws;
+    auto c = is.peek();
+    if(c == '-' || c == '+') {
+        s.push_back(char(is.get()));
+        c = is.peek();
+    }
+    while(c >= '0' && c <= '9') {
+        s.push_back(char(is.get()));
+        c = is.peek();
+    }
+    if(s.empty() || s.back() < '0' || s.back() > '9') {
+        is.setstate(std::ios::failbit);
+        return is;
+    }
+    x = big_integer{s};
+    return is;
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * TRAITS SPECIALIZATIONS
+ *
+ *****************************************************************************/
+template<>
+struct is_number<big_integer> : std::true_type {};
+
+template<>
+struct is_integral<big_integer> : std::true_type {};
+
+
+}  // namespace num
+}  // namespace am
+
+
+
+
+namespace std {
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<>
+class numeric_limits<am::num::big_integer>
+{
+    using val_t = am::num::big_integer;
+
+public:
+    static constexpr bool is_specialized = true;
+
+    static val_t min() { return val_t{}; }
+    static val_t max() { return val_t{}; }
+    static val_t lowest() { return val_t{}; }
+
+    static constexpr int digits = std::numeric_limits<int>::max();
+    static constexpr int digits10 = std::numeric_limits<int>::max();
+    static constexpr int max_digits10 = 0;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = true;
+    static constexpr bool is_exact = true;
+    static constexpr int radix = 2;
+
+    static val_t epsilon() noexcept { return val_t{}; }
+    static val_t round_error() noexcept { return val_t{}; }
+
+    static constexpr int min_exponent   = 0;
+    static constexpr int min_exponent10 = 0;
+    static constexpr int max_exponent   = 0;
+    static constexpr int max_exponent10 = 0;
+
+    static constexpr bool has_infinity = false;
+    static constexpr bool has_quiet_NaN = false;
+    static constexpr bool has_signaling_NaN = false;
+    static constexpr std::float_denorm_style has_denorm = std::denorm_absent;
+    static constexpr bool has_denorm_loss = false;
+
+    static val_t infinity() noexcept { return val_t{}; }
+    static val_t quiet_NaN() noexcept { return val_t{}; }
+    static val_t signaling_NaN() noexcept { return val_t{}; }
+    static val_t denorm_min() noexcept { return val_t{}; }
+
+    static constexpr bool is_iec559 = false;
+    static constexpr bool is_bounded = false;
+    static constexpr bool is_modulo = false;
+
+    static constexpr bool traps = false;
+    static constexpr bool tinyness_before = false;
+    static constexpr std::float_round_style round_style = std::round_toward_zero;
+};
+
+}  // namespace std
+
+
+#endif
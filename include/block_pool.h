@@ -0,0 +1,106 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_BLOCK_POOL_H_
+#define AM_NUMERIC_BLOCK_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+
+namespace am {
+namespace num {
+
+
+namespace detail {
+
+/*************************************************************************//***
+ *
+ * @brief thread-local recycling of power-of-two sized blocks
+ *
+ *****************************************************************************/
+template<class Entry>
+class block_pool
+{
+    static constexpr std::size_t num_classes = 8 * sizeof(std::size_t);
+
+    struct free_lists {
+        std::vector<Entry*> blocks[num_classes];
+
+        ~free_lists() {
+            destroyed() = true;
+            std::allocator<Entry> alloc;
+            for(std::size_t k = 0; k < num_classes; ++k) {
+                for(auto p : blocks[k]) alloc.deallocate(p, std::size_t(1) << k);
+            }
+        }
+    };
+
+    /// @brief true after the thread's pool has been torn down
+    static bool&
+    destroyed() noexcept {
+        thread_local bool d = false;
+        return d;
+    }
+
+    static free_lists&
+    lists() {
+        thread_local free_lists fl;
+        return fl;
+    }
+
+    static std::size_t
+    size_class(std::size_t n) noexcept {
+        std::size_t k = 0;
+        while((std::size_t(1) << k) < n) ++k;
+        return k;
+    }
+
+public:
+    /// @brief returns block for at least n entries; n is set to capacity
+    static Entry*
+    allocate(std::size_t& n) {
+        const auto k = size_class(n);
+        n = std::size_t(1) << k;
+        auto& fl = lists().blocks[k];
+        if(!fl.empty()) {
+            auto p = fl.back();
+            fl.pop_back();
+            return p;
+        }
+        return std::allocator<Entry>{}.allocate(n);
+    }
+
+    /// @brief n must be the capacity returned by allocate
+    /// @note  noexcept, because it is called from destructors;
+    ///        blocks that can't be recycled are freed directly
+    static void
+    deallocate(Entry* p, std::size_t n) noexcept {
+        if(!destroyed()) {
+            try {
+                lists().blocks[size_class(n)].push_back(p);
+                return;
+            }
+            catch(std::bad_alloc&) {}
+        }
+        std::allocator<Entry>{}.deallocate(p, n);
+    }
+};
+
+}  // namespace detail
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
@@ -14,15 +14,233 @@
 #include <type_traits>
 #include <limits>
 #include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
 
 
 #include "limits.h"
+#include "overflow.h"
 
 
 namespace am {
 namespace num {
 
 
+/*****************************************************************************
+ *
+ * MODULAR REDUCTION WITH COMPILE-TIME MODULUS
+ *
+ * Residues are handled as unsigned integers of at least 32 bits.
+ * Reductions use masking if the modulus is a power of two and Barrett
+ * reduction otherwise (one high multiplication, one low multiplication
+ * and one conditional subtraction); no integer divisions are needed.
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief high half of the double-width product a*b
+template<class U>
+inline constexpr U
+mul_high(U a, U b) noexcept
+{
+    constexpr int h = std::numeric_limits<U>::digits / 2;
+    constexpr U lo = U(~U(0)) >> h;
+
+    const U a0 = U(a & lo), a1 = U(a >> h);
+    const U b0 = U(b & lo), b1 = U(b >> h);
+    const U m  = U(U(a1 * b0) + U(U(a0 * b0) >> h));
+    const U c  = U(U(a0 * b1) + U(m & lo));
+    return U(U(a1 * b1) + U(m >> h) + U(c >> h));
+}
+
+inline constexpr std::uint32_t
+mul_high(std::uint32_t a, std::uint32_t b) noexcept
+{
+    return std::uint32_t((std::uint64_t(a) * b) >> 32);
+}
+
+#ifdef __SIZEOF_INT128__
+inline constexpr std::uint64_t
+mul_high(std::uint64_t a, std::uint64_t b) noexcept
+{
+    return std::uint64_t((uint128_t(a) * b) >> 64);
+}
+
+/// @brief 4 64x64 bit products instead of 128x128 bit products
+inline constexpr uint128_t
+mul_high(uint128_t a, uint128_t b) noexcept
+{
+    const auto a0 = std::uint64_t(a), a1 = std::uint64_t(a >> 64);
+    const auto b0 = std::uint64_t(b), b1 = std::uint64_t(b >> 64);
+    const auto m  = uint128_t(a1) * b0 + ((uint128_t(a0) * b0) >> 64);
+    const auto c  = uint128_t(a0) * b1 + std::uint64_t(m);
+    return uint128_t(a1) * b1 + (m >> 64) + (c >> 64);
+}
+#endif
+
+
+//-------------------------------------------------------------------
+template<class IntT, IntT n>
+struct choice_modulus
+{
+    using uint_t = std::conditional_t<(sizeof(IntT) <= 4),
+                                      std::uint32_t, std::uint64_t>;
+    //void, if there is no wider builtin type
+    using wide_t = wider_integer_t<uint_t>;
+
+    static constexpr uint_t value = uint_t(n);
+    static constexpr uint_t mask  = uint_t(value - 1);
+    static constexpr bool   pow2  = (value & mask) == 0;
+    static constexpr int    bits  = std::numeric_limits<uint_t>::digits;
+
+    /// @brief products of residues fit into uint_t
+    static constexpr bool   small = value <= (uint_t(1) << (bits / 2));
+
+    /// @brief floor((2^bits - 1) / n)
+    static constexpr uint_t factor = uint_t(~uint_t(0) / value);
+
+    static constexpr uint_t
+    modulus() noexcept {
+        return value;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief u mod n
+    static constexpr uint_t
+    reduce(uint_t u) noexcept {
+        return pow2 ? uint_t(u & mask)
+                    : barrett(u, std::integral_constant<bool,
+                                    !std::is_void<wide_t>::value>{});
+    }
+
+    //-----------------------------------------------------
+    /// @brief x mod n for any builtin integer x; result in [0,n)
+    template<class T>
+    static constexpr uint_t
+    reduce_signed(T x) noexcept {
+        return negate(reduce_unsigned(unsigned_magnitude(x),
+                          std::integral_constant<bool,
+                              (sizeof(T) > sizeof(uint_t))>{}),
+                      x < T(0));
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief (a + b) mod n for a,b in [0,n); can't overflow
+    static constexpr uint_t
+    add(uint_t a, uint_t b) noexcept {
+        return (a >= uint_t(value - b)) ? uint_t(a - (value - b))
+                                        : uint_t(a + b);
+    }
+
+    //-----------------------------------------------------
+    /// @brief (a - b) mod n for a,b in [0,n)
+    static constexpr uint_t
+    sub(uint_t a, uint_t b) noexcept {
+        return (a >= b) ? uint_t(a - b) : uint_t(a + (value - b));
+    }
+
+    //-----------------------------------------------------
+    /// @brief (a * b) mod n for a,b in [0,n); can't overflow
+    static constexpr uint_t
+    mul(uint_t a, uint_t b) noexcept {
+        //a power of two modulus divides 2^bits
+        return (small || pow2) ? reduce(uint_t(a * b))
+                               : mul_wide(a, b, has_wide{});
+    }
+
+
+private:
+    using has_wide = std::integral_constant<bool, !std::is_void<wide_t>::value>;
+
+    //---------------------------------------------------------------
+    static constexpr uint_t
+    mul_wide(uint_t a, uint_t b, std::true_type) noexcept {
+        return reduce_wide(wide_t(wide_t(a) * b));
+    }
+
+    static constexpr uint_t
+    mul_wide(uint_t a, uint_t b, std::false_type) noexcept {
+        //binary method; only additions
+        uint_t r = 0;
+        for(; b > 0; b >>= 1) {
+            if(b & 1) r = add(r, a);
+            a = add(a, a);
+        }
+        return r;
+    }
+
+    //-----------------------------------------------------
+    /// @brief w mod n for 64 bit w
+    static constexpr uint_t
+    reduce_wide(std::uint64_t w) noexcept {
+        //constant divisor: all major compilers emit an exact
+        //multiply-shift sequence which is faster than Barrett + correction
+        return uint_t(w % value);
+    }
+
+    //-----------------------------------------------------
+    /// @brief Barrett reduction of a 128 bit value
+    template<class W>
+    static constexpr uint_t
+    reduce_wide(W w) noexcept {
+        constexpr auto f = W(~W(0) / W(value));
+        //remainder is < 2n which might not fit into uint_t
+        const auto r = W(w - W(mul_high(w, f) * W(value)));
+        return uint_t((r >= W(value)) ? W(r - W(value)) : r);
+    }
+
+
+    //---------------------------------------------------------------
+    static constexpr uint_t
+    barrett(uint_t u, std::true_type) noexcept {
+        //q is at most 1 smaller than floor(u/n)
+        return correct(uint_t(u - uint_t(wide_t(wide_t(u) * factor) >> bits)
+                                  * value));
+    }
+
+    static constexpr uint_t
+    barrett(uint_t u, std::false_type) noexcept {
+        return uint_t(u % value);
+    }
+
+    static constexpr uint_t
+    correct(uint_t r) noexcept {
+        return (r >= value) ? uint_t(r - value) : r;
+    }
+
+    //---------------------------------------------------------------
+    template<class U>
+    static constexpr uint_t
+    reduce_unsigned(U u, std::false_type /* fits into uint_t */) noexcept {
+        return reduce(uint_t(u));
+    }
+
+    template<class U>
+    static constexpr uint_t
+    reduce_unsigned(U u, std::true_type) noexcept {
+        return reduce_wide(u);
+    }
+
+    template<class T>
+    static constexpr std::make_unsigned_t<T>
+    unsigned_magnitude(T x) noexcept {
+        using u_t = std::make_unsigned_t<T>;
+        return (x < T(0)) ? u_t(u_t(0) - u_t(x)) : u_t(x);
+    }
+
+    static constexpr uint_t
+    negate(uint_t r, bool neg) noexcept {
+        return (neg && r != 0) ? uint_t(value - r) : r;
+    }
+};
+
+}  // namespace detail
+
+
 /*************************************************************************//***
  *
  * @brief represents an element of IN / IN(numChoices)
@@ -41,6 +259,11 @@ class choice
     static_assert(numChoices > 0,
         "choice<T,n> : n must be > 0");
 
+    template<class T, T> friend class choice;
+
+    using mod_t  = detail::choice_modulus<IntT,numChoices>;
+    using uint_t = typename mod_t::uint_t;
+
 public:
     //---------------------------------------------------------------
     using value_type   = IntT;
@@ -50,8 +273,7 @@ public:
     //-----------------------------------------------------
     constexpr explicit
     choice(const value_type& x):
-        x_(x < 0 ? value_type(numChoices + value_type(x % numChoices)) 
-                 : value_type(x % numChoices) )
+        x_(value_type(mod_t::reduce_signed(x)))
     {}
 
     constexpr
@@ -60,7 +282,7 @@ public:
     template<value_type m>
     explicit constexpr
     choice(const choice<value_type,m>& c):
-        x_(c.x_ % numChoices)
+        x_(value_type(mod_t::reduce_signed(c.x_)))
     {}
 
 
@@ -71,9 +293,7 @@ public:
     choice&
     operator = (const value_type& x)
     {
-        x_ = x < 0 ? value_type(numChoices + value_type(x % numChoices)) 
-                   : value_type(x % numChoices);
-
+        x_ = value_type(mod_t::reduce_signed(x));
         return *this;
     }
 
@@ -115,8 +335,7 @@ public:
     choice&
     operator += (const choice& c)
     {
-        x_ += c.x_;
-        if(x_ > numChoices) x_ -= numChoices;
+        x_ = value_type(mod_t::add(uint_t(x_), uint_t(c.x_)));
         return *this;
     }
 
@@ -127,11 +346,11 @@ public:
         return (*this += value_type(c));
     }
 
+    template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
     choice&
-    operator += (const value_type& x)
+    operator += (const T& x)
     {
-        auto v = (x_ + x) % numChoices;
-        x_ = (v >= 0) ? value_type(v) : value_type(numChoices+v);
+        x_ = value_type(mod_t::add(uint_t(x_), mod_t::reduce_signed(x)));
         return *this;
     }
 
@@ -139,11 +358,7 @@ public:
     //---------------------------------------------------------------
     choice&
     operator -= (const choice& c) {
-        if(x_ > c.x_) {
-            x_ -= c.x_;
-        } else {
-            x_ = numChoices - c.x_ + x_;
-        }
+        x_ = value_type(mod_t::sub(uint_t(x_), uint_t(c.x_)));
         return *this;
     }
 
@@ -154,29 +369,37 @@ public:
         return (*this -= value_type(c));
     }
 
+    template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
     choice&
-    operator -= (const value_type& x)
+    operator -= (const T& x)
     {
-        auto v = (x_ - x) % numChoices;
-        x_ = (v >= 0) ? value_type(v) : value_type(numChoices+v);
+        x_ = value_type(mod_t::sub(uint_t(x_), mod_t::reduce_signed(x)));
         return *this;
     }
 
 
     //---------------------------------------------------------------
     choice&
-    operator *= (const value_type& x)
+    operator *= (const choice& c)
     {
-        auto v = (x_ * x) % numChoices;
-        x_ = (v >= 0) ? value_type(v) : value_type(numChoices+v);
+        x_ = value_type(mod_t::mul(uint_t(x_), uint_t(c.x_)));
+        return *this;
+    }
+
+    template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
+    choice&
+    operator *= (const T& x)
+    {
+        x_ = value_type(mod_t::mul(uint_t(x_), mod_t::reduce_signed(x)));
         return *this;
     }
 
     choice&
     operator /= (const value_type& x)
     {
-        auto v = (x_ / x) % numChoices;
-        x_ = (v >= 0) ? value_type(v) : value_type(numChoices+v);
+        //integer division of the residue; |x_ / x| < numChoices
+        const auto v = value_type(x_ / x);
+        x_ = (v >= 0) ? v : value_type(numChoices + v);
         return *this;
     }
 
@@ -184,17 +407,20 @@ public:
     //---------------------------------------------------------------
     choice
     operator + (const choice& c) const {
-        auto nx = x_ + c.x_;
-        if(nx > numChoices) nx -= numChoices;
         //use special non-mod ctor
-        return choice{value_type(nx), 0};
+        return choice{value_type(mod_t::add(uint_t(x_), uint_t(c.x_))), 0};
     }
 
     choice
     operator - (const choice& c) const {
         //use special non-mod ctor
-        return choice{
-            value_type((x_ > c.x_) ? (x_ - c.x_) : (numChoices - c.x_ + x_)), 0};
+        return choice{value_type(mod_t::sub(uint_t(x_), uint_t(c.x_))), 0};
+    }
+
+    choice
+    operator * (const choice& c) const {
+        //use special non-mod ctor
+        return choice{value_type(mod_t::mul(uint_t(x_), uint_t(c.x_))), 0};
     }
 
 
@@ -202,12 +428,13 @@ public:
     constexpr choice
     operator - () const {
         //use special non-mod ctor
-        return choice{value_type(numChoices - x_), 0};
+        return choice{value_type(mod_t::sub(0, uint_t(x_))), 0};
     }
 
+    /// @brief in-place additive inverse (negation)
     choice&
     invert() {
-        x_ = value_type(numChoices - x_);
+        x_ = value_type(mod_t::sub(0, uint_t(x_)));
         return *this;
     }
 
@@ -235,7 +462,7 @@ public:
     choice
     operator -- (int) {
         auto old = *this;
-        ++*this;
+        --*this;
         return old;
     }
 
@@ -262,40 +489,179 @@ private:
  *
  *****************************************************************************/
 
-#define AM_CHOICE_ARITHMETIC_OP(OPERATOR) \
-\
-template<class T, class IntT, IntT n, class = \
-    std::enable_if_t<is_number<T>::value>\
-> \
-inline constexpr choice<IntT,n> \
-operator OPERATOR (const T& x, const choice<IntT,n>& c) \
-{ \
-    static_assert(is_integral<T>::value, \
-        "T has to be an integral number type"); \
-\
-    return choice<IntT,n>{x OPERATOR c.value()}; \
-} \
-\
-\
-template<class T, class IntT, IntT n, class = \
-    std::enable_if_t<is_number<T>::value> \
-> \
-inline constexpr choice<IntT,n> \
-operator OPERATOR (const choice<IntT,n>& c, const T& x) \
-{ \
-    static_assert(is_integral<T>::value, \
-        "T has to be an integral number type"); \
-\
-    return choice<IntT,n>{c.value() OPERATOR x}; \
+template<class T, class IntT, IntT n,
+         class = std::enable_if_t<std::is_integral<T>::value>>
+inline choice<IntT,n>
+operator + (const T& x, choice<IntT,n> c)
+{
+    return (c += x);
+}
+
+template<class T, class IntT, IntT n,
+         class = std::enable_if_t<std::is_integral<T>::value>>
+inline choice<IntT,n>
+operator + (choice<IntT,n> c, const T& x)
+{
+    return (c += x);
+}
+
+
+//-------------------------------------------------------------------
+template<class T, class IntT, IntT n,
+         class = std::enable_if_t<std::is_integral<T>::value>>
+inline choice<IntT,n>
+operator - (const T& x, const choice<IntT,n>& c)
+{
+    auto r = -c;
+    return (r += x);
+}
+
+template<class T, class IntT, IntT n,
+         class = std::enable_if_t<std::is_integral<T>::value>>
+inline choice<IntT,n>
+operator - (choice<IntT,n> c, const T& x)
+{
+    return (c -= x);
+}
+
+
+//-------------------------------------------------------------------
+template<class T, class IntT, IntT n,
+         class = std::enable_if_t<std::is_integral<T>::value>>
+inline choice<IntT,n>
+operator * (const T& x, choice<IntT,n> c)
+{
+    return (c *= x);
+}
+
+template<class T, class IntT, IntT n,
+         class = std::enable_if_t<std::is_integral<T>::value>>
+inline choice<IntT,n>
+operator * (choice<IntT,n> c, const T& x)
+{
+    return (c *= x);
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * MULTIPLICATIVE GROUP
+ *
+ *****************************************************************************/
+//-------------------------------------------------------------------
+namespace detail {
+
+/**
+ * @brief extended Euclidean algorithm
+ *        (measured to be faster than the extended binary gcd,
+ *        because it needs far fewer unpredictable branches)
+ */
+template<class M>
+inline bool
+choice_inverse(const M& m, typename M::uint_t a,
+               typename M::uint_t& inv) noexcept
+{
+    using u_t = typename M::uint_t;
+
+    //coefficients of a; track them mod n
+    u_t r0 = m.modulus(), r1 = a, t0 = 0, t1 = 1;
+    while(r1 != 0) {
+        const u_t q = r0 / r1;
+        const u_t r2 = u_t(r0 - q * r1);
+        const u_t t2 = m.sub(t0, m.mul(m.reduce(q), t1));
+        r0 = r1; r1 = r2;
+        t0 = t1; t1 = t2;
+    }
+    if(r0 != 1) return false;
+    inv = t0;
+    return true;
+}
+
+}  // namespace detail
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief multiplicative inverse
+ * @throws std::domain_error if c and n are not coprime
+ */
+template<class Int, Int n>
+inline choice<Int,n>
+inverse(const choice<Int,n>& c)
+{
+    using mod_t = detail::choice_modulus<Int,n>;
+    using u_t = typename mod_t::uint_t;
+
+    u_t inv = 0;
+    if(!detail::choice_inverse(mod_t{}, u_t(c.value()), inv)) {
+        throw std::domain_error{"choice: element is not invertible"};
+    }
+    return choice<Int,n>{Int(inv)};
 }
 
 
-AM_CHOICE_ARITHMETIC_OP(+)
-AM_CHOICE_ARITHMETIC_OP(-)
-AM_CHOICE_ARITHMETIC_OP(*)
+//-------------------------------------------------------------------
+/**
+ * @brief c^e by square-and-multiply
+ *        negative exponents use the multiplicative inverse of c
+ */
+template<class Int, Int n, class E,
+         class = std::enable_if_t<std::is_integral<E>::value>>
+inline choice<Int,n>
+pow(choice<Int,n> c, E e)
+{
+    using u_t = std::make_unsigned_t<E>;
 
+    if(e < E(0)) c = inverse(c);
+    auto u = (e < E(0)) ? u_t(u_t(0) - u_t(e)) : u_t(e);
 
-#undef AM_CHOICE_ARITHMETIC_OP
+    auto r = choice<Int,n>{Int(1)};
+    for(; u > 0; u >>= 1) {
+        if(u & 1) r *= c;
+        c *= c;
+    }
+    return r;
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief replaces all elements in [first,last) by their multiplicative
+ *        inverses with only one inversion (Montgomery's trick)
+ *
+ * @throws std::domain_error if an element is not invertible;
+ *         the range is not modified in that case
+ */
+template<class BidirIt>
+inline void
+batch_inverse(BidirIt first, BidirIt last)
+{
+    using value_t = typename std::iterator_traits<BidirIt>::value_type;
+
+    if(first == last) return;
+
+    //prefix products p[i] = x[0] * ... * x[i]
+    std::vector<value_t> p;
+    auto acc = *first;
+    p.push_back(acc);
+    for(auto i = std::next(first); i != last; ++i) {
+        acc *= *i;
+        p.push_back(acc);
+    }
+
+    //(x[0] * ... * x[i])^-1
+    auto inv = inverse(p.back());
+
+    auto k = p.size() - 1;
+    for(auto i = last; --i != first; --k) {
+        const auto x = *i;
+        *i = inv * p[k-1];
+        inv *= x;
+    }
+    *first = inv;
+}
 
 
 
@@ -403,19 +769,6 @@ print(Ostream& os, const choice<Int,n>& c)
 
 
 
-/*****************************************************************************
- *
- *
- *
- *****************************************************************************/
-template<class Int, Int n>
-inline constexpr choice<Int,n>
-inverse(choice<Int,n> c)
-{
-    return choice<Int,n>{-c};
-}
-
-
 }  // namespace num
 }  // namespace am
 
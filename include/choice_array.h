@@ -0,0 +1,462 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_CHOICE_ARRAY_H_
+#define AM_NUMERIC_CHOICE_ARRAY_H_
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <limits>
+#include <type_traits>
+#include <initializer_list>
+
+#include "choice.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief
+ * sequence of choice<T,n> values stored as raw residues in [0,n)
+ *
+ * The bulk kernels below are plain loops over contiguous arrays of
+ * builtin integers without branches or divisions so that they can be
+ * vectorized by the compiler. Results are identical to the
+ * corresponding choice<T,n> operators.
+ *
+ *****************************************************************************/
+template<class IntT, IntT numChoices>
+class choice_array
+{
+public:
+    //---------------------------------------------------------------
+    using value_type      = choice<IntT,numChoices>;
+    using numeric_type    = IntT;
+    using size_type       = std::size_t;
+
+
+    //---------------------------------------------------------------
+    choice_array() = default;
+
+    explicit
+    choice_array(size_type n):
+        v_(n, numeric_type(0))
+    {}
+
+    choice_array(size_type n, const value_type& x):
+        v_(n, x.value())
+    {}
+
+    choice_array(std::initializer_list<value_type> il):
+        v_()
+    {
+        reserve(il.size());
+        for(const auto& x : il) push_back(x);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        return v_.size();
+    }
+
+    bool
+    empty() const noexcept {
+        return v_.empty();
+    }
+
+    void
+    resize(size_type n) {
+        v_.resize(n, numeric_type(0));
+    }
+
+    void
+    reserve(size_type n) {
+        v_.reserve(n);
+    }
+
+    void
+    clear() noexcept {
+        v_.clear();
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator [] (size_type i) const noexcept {
+        return value_type{v_[i]};
+    }
+
+    void
+    set(size_type i, const value_type& x) noexcept {
+        v_[i] = x.value();
+    }
+
+    void
+    push_back(const value_type& x) {
+        v_.push_back(x.value());
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief raw residues; must stay in [0,n)
+    const numeric_type*
+    data() const noexcept {
+        return v_.data();
+    }
+
+    numeric_type*
+    data() noexcept {
+        return v_.data();
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    std::vector<numeric_type> v_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * ELEMENT KERNELS
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+/**
+ * @brief branch-free residue arithmetic in lanes of the storage width
+ *
+ * Moduli n < 2^(bits-1) with residues of at most 32 bits use
+ *  - conditional subtraction via unsigned minimum for add/sub
+ *  - Barrett reduction with only lane x lane -> double width products
+ *  - Shoup's precomputed quotients for multiplication by a constant
+ * Powers of two are masked; other moduli use compare & select for
+ * add/sub and choice_modulus for multiplication.
+ */
+template<class IntT, IntT n>
+struct choice_lanes
+{
+    using mod_t  = choice_modulus<IntT,n>;
+    using lane_t = std::make_unsigned_t<IntT>;
+    using prod_t = std::conditional_t<(sizeof(lane_t) <= 4),
+                                      wider_integer_t<lane_t>, lane_t>;
+
+    static constexpr int    bits  = std::numeric_limits<lane_t>::digits;
+    static constexpr lane_t value = lane_t(n);
+    static constexpr lane_t mask  = lane_t(value - 1);
+    static constexpr bool   pow2  = mod_t::pow2;
+
+    /// @brief number of significant bits of n
+    static constexpr int
+    bit_width(std::uint64_t x) noexcept {
+        return (x > 0) ? 1 + bit_width(x >> 1) : 0;
+    }
+
+    static constexpr int  width = bit_width(value);
+
+    static constexpr bool simple = !pow2 && (width < bits) &&
+                                   (sizeof(lane_t) <= 4);
+
+    /// @brief Barrett remainder (< 3n) fits into a lane
+    static constexpr bool narrow = value <= lane_t(~lane_t(0) / 3);
+
+    /// @brief Barrett remainder type; narrower types are promoted anyway
+    using rem_t = std::conditional_t<(sizeof(lane_t) < 4), std::uint32_t,
+                  std::conditional_t<narrow, lane_t, prod_t>>;
+
+    /// @brief floor(2^(2 width) / n) * 2^(bits - width - 1) < 2^bits
+    static constexpr lane_t mu = simple
+        ? lane_t(((std::uint64_t(1) << (2 * width)) / value)
+                 << (bits - width - 1))
+        : lane_t(0);
+
+
+    //---------------------------------------------------------------
+    static constexpr lane_t
+    add(lane_t a, lane_t b) noexcept {
+        return add(a, b, kind{});
+    }
+
+    static constexpr lane_t
+    sub(lane_t a, lane_t b) noexcept {
+        return sub(a, b, kind{});
+    }
+
+    static constexpr lane_t
+    mul(lane_t a, lane_t b) noexcept {
+        return mul(a, b, kind{});
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief precomputed quotient for multiplications with w in [0,n)
+    static constexpr lane_t
+    shoup(lane_t w) noexcept {
+        return shoup(w, kind{});
+    }
+
+    /// @brief (a * w) mod n with s = shoup(w)
+    static constexpr lane_t
+    mul_shoup(lane_t a, lane_t w, lane_t s) noexcept {
+        return mul_shoup(a, w, s, kind{});
+    }
+
+
+private:
+    using kind = std::integral_constant<int, simple ? 0 : (pow2 ? 1 : 2)>;
+    using simple_t   = std::integral_constant<int,0>;
+    using pow2_t     = std::integral_constant<int,1>;
+
+
+    //---------------------------------------------------------------
+    template<class T>
+    static constexpr T
+    min(T x, T y) noexcept {
+        return (y < x) ? y : x;
+    }
+
+    /// @brief x - n if x >= n; x must be < n + 2^bits(T)
+    template<class T>
+    static constexpr T
+    correct(T x) noexcept {
+        return min(x, T(x - value));
+    }
+
+
+    //---------------------------------------------------------------
+    static constexpr lane_t
+    add(lane_t a, lane_t b, simple_t) noexcept {
+        return correct(lane_t(a + b));
+    }
+
+    static constexpr lane_t
+    add(lane_t a, lane_t b, pow2_t) noexcept {
+        return lane_t(lane_t(a + b) & mask);
+    }
+
+    /// @brief a + b might overflow
+    template<class Kind>
+    static constexpr lane_t
+    add(lane_t a, lane_t b, Kind) noexcept {
+        return (a >= lane_t(value - b)) ? lane_t(a - lane_t(value - b))
+                                        : lane_t(a + b);
+    }
+
+    //-----------------------------------------------------
+    static constexpr lane_t
+    sub(lane_t a, lane_t b, simple_t) noexcept {
+        return min(lane_t(a - b), lane_t(lane_t(a - b) + value));
+    }
+
+    static constexpr lane_t
+    sub(lane_t a, lane_t b, pow2_t) noexcept {
+        return lane_t(lane_t(a - b) & mask);
+    }
+
+    template<class Kind>
+    static constexpr lane_t
+    sub(lane_t a, lane_t b, Kind) noexcept {
+        return (a >= b) ? lane_t(a - b) : lane_t(lane_t(a - b) + value);
+    }
+
+    //-----------------------------------------------------
+    static constexpr lane_t
+    mul(lane_t a, lane_t b, simple_t) noexcept {
+        //Barrett: q is at most 2 smaller than floor(a*b/n)
+        return barrett(prod_t(prod_t(a) * b));
+    }
+
+    static constexpr lane_t
+    mul(lane_t a, lane_t b, pow2_t) noexcept {
+        return lane_t(lane_t(a * b) & mask);
+    }
+
+    template<class Kind>
+    static constexpr lane_t
+    mul(lane_t a, lane_t b, Kind) noexcept {
+        return lane_t(mod_t::mul(a, b));
+    }
+
+    //-----------------------------------------------------
+    static constexpr lane_t
+    shoup(lane_t w, simple_t) noexcept {
+        return lane_t((prod_t(w) << bits) / value);
+    }
+
+    template<class Kind>
+    static constexpr lane_t
+    shoup(lane_t, Kind) noexcept {
+        return 0;
+    }
+
+    //-----------------------------------------------------
+    static constexpr lane_t
+    mul_shoup(lane_t a, lane_t w, lane_t s, simple_t) noexcept {
+        //q is at most 1 smaller than floor(a*w/n) => remainder < 2n
+        return correct(lane_t(lane_t(a * w) -
+                              lane_t(lane_t((prod_t(a) * s) >> bits) * value)));
+    }
+
+    template<class Kind>
+    static constexpr lane_t
+    mul_shoup(lane_t a, lane_t w, lane_t, Kind k) noexcept {
+        return mul(a, w, k);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief p mod n for p < n^2
+    static constexpr lane_t
+    barrett(prod_t p) noexcept {
+        //high half of a lane x lane product
+        return barrett(p, lane_t((prod_t(lane_t(p >> (width - 1))) * mu)
+                                 >> bits));
+    }
+
+    static constexpr lane_t
+    barrett(prod_t p, lane_t q) noexcept {
+        //remainder < 3n; modular arithmetic in rem_t is exact
+        return lane_t(correct(correct(
+                   rem_t(rem_t(p) - rem_t(rem_t(q) * value)))));
+    }
+};
+
+template<class IntT, IntT n>
+constexpr int choice_lanes<IntT,n>::bits;
+
+template<class IntT, IntT n>
+constexpr typename choice_lanes<IntT,n>::lane_t choice_lanes<IntT,n>::value;
+
+template<class IntT, IntT n>
+constexpr typename choice_lanes<IntT,n>::lane_t choice_lanes<IntT,n>::mask;
+
+template<class IntT, IntT n>
+constexpr bool choice_lanes<IntT,n>::pow2;
+
+template<class IntT, IntT n>
+constexpr int choice_lanes<IntT,n>::width;
+
+template<class IntT, IntT n>
+constexpr bool choice_lanes<IntT,n>::simple;
+
+template<class IntT, IntT n>
+constexpr bool choice_lanes<IntT,n>::narrow;
+
+template<class IntT, IntT n>
+constexpr typename choice_lanes<IntT,n>::lane_t choice_lanes<IntT,n>::mu;
+
+
+//-------------------------------------------------------------------
+template<class T, T n, class BinaryOp>
+inline void
+choice_transform(const choice_array<T,n>& a, const choice_array<T,n>& b,
+                 choice_array<T,n>& out, BinaryOp op)
+{
+    using lane_t = typename choice_lanes<T,n>::lane_t;
+
+    assert(a.size() == b.size());
+    const auto size = a.size();
+    if(out.size() != size) out.resize(size);
+
+    const auto pa = a.data();
+    const auto pb = b.data();
+    auto po = out.data();
+    for(std::size_t k = 0; k < size; ++k) {
+        po[k] = T(op(lane_t(pa[k]), lane_t(pb[k])));
+    }
+}
+
+}  // namespace detail
+
+
+
+
+/*****************************************************************************
+ *
+ * BULK KERNELS
+ *
+ * @note output arrays are resized if necessary and may be identical
+ *       to one of the inputs
+ *
+ *****************************************************************************/
+template<class T, T n>
+inline void
+add(const choice_array<T,n>& a, const choice_array<T,n>& b,
+    choice_array<T,n>& out)
+{
+    using lanes = detail::choice_lanes<T,n>;
+    using lane_t = typename lanes::lane_t;
+    detail::choice_transform(a, b, out,
+        [](lane_t x, lane_t y) { return lanes::add(x, y); });
+}
+
+//---------------------------------------------------------
+template<class T, T n>
+inline void
+subtract(const choice_array<T,n>& a, const choice_array<T,n>& b,
+         choice_array<T,n>& out)
+{
+    using lanes = detail::choice_lanes<T,n>;
+    using lane_t = typename lanes::lane_t;
+    detail::choice_transform(a, b, out,
+        [](lane_t x, lane_t y) { return lanes::sub(x, y); });
+}
+
+//---------------------------------------------------------
+template<class T, T n>
+inline void
+multiply(const choice_array<T,n>& a, const choice_array<T,n>& b,
+         choice_array<T,n>& out)
+{
+    using lanes = detail::choice_lanes<T,n>;
+    using lane_t = typename lanes::lane_t;
+    detail::choice_transform(a, b, out,
+        [](lane_t x, lane_t y) { return lanes::mul(x, y); });
+}
+
+//---------------------------------------------------------
+/// @brief multiplies all elements with the same factor
+template<class T, T n>
+inline void
+scale(const choice_array<T,n>& a, const choice<T,n>& factor,
+      choice_array<T,n>& out)
+{
+    using lanes = detail::choice_lanes<T,n>;
+    using lane_t = typename lanes::lane_t;
+
+    const auto size = a.size();
+    if(out.size() != size) out.resize(size);
+
+    const auto w = lane_t(factor.value());
+    const auto s = lanes::shoup(w);
+
+    const auto pa = a.data();
+    auto po = out.data();
+    for(std::size_t k = 0; k < size; ++k) {
+        po[k] = T(lanes::mul_shoup(lane_t(pa[k]), w, s));
+    }
+}
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,63 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_DIGAMMA_H_
+#define AM_NUMERIC_DIGAMMA_H_
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+
+namespace am {
+namespace num {
+
+
+//-------------------------------------------------------------------
+/// @brief digamma function psi(x) = d/dx log(gamma(x))
+///        for builtin floating-point numbers
+template<class T, class = std::enable_if_t<std::is_floating_point<T>::value>>
+inline T
+digamma(T x)
+{
+    using std::tan;
+    using std::log;
+    using std::floor;
+
+    const T pi = T(3.1415926535897932384626433832795028841971693993751);
+
+    //poles at non-positive integers
+    if(x <= T(0) && x == floor(x)) return std::numeric_limits<T>::quiet_NaN();
+
+    //reflection: psi(x) = psi(1-x) - pi / tan(pi*x)
+    T res = T(0);
+    if(x < T(0)) {
+        res = -pi / tan(pi * x);
+        x = T(1) - x;
+    }
+    //recurrence: psi(x) = psi(x+1) - 1/x
+    for(; x < T(10); x += T(1)) res -= T(1) / x;
+
+    //asymptotic expansion
+    const auto ix2 = T(1) / (x*x);
+    const auto series = ix2 * (T(1)/T(12) - ix2 * (T(1)/T(120) -
+                        ix2 * (T(1)/T(252) - ix2 * (T(1)/T(240) -
+                        ix2 * (T(1)/T(132) - ix2 * (T(691)/T(32760) -
+                        ix2 * (T(1)/T(12))))))));
+
+    return res + log(x) - (T(0.5) / x) - series;
+}
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
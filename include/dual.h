@@ -13,11 +13,14 @@
 
 #include <cmath>
 #include <cfloat>
+#include <iterator>
 
 #include "constants.h"
 #include "traits.h"
 #include "limits.h"
 #include "equality.h"
+#include "digamma.h"
+#include "sincos.h"
 
 
 namespace am {
@@ -981,9 +984,9 @@ template<class T>
 inline auto
 sin(const dual<T>& x)
 {
-    using std::sin;
-    using std::cos;
-    return dual<T>{sin(x.real()), x.imag() * cos(x.real())};
+    T s, c;
+    detail::sin_cos(x.real(), s, c);
+    return dual<T>{s, x.imag() * c};
 }
 
 //---------------------------------------------------------
@@ -991,21 +994,32 @@ template<class T>
 inline auto
 cos(const dual<T>& x)
 {
-    using std::sin;
-    using std::cos;
-    return dual<T>{cos(x.real()), -x.imag() * sin(x.real())};
+    T s, c;
+    detail::sin_cos(x.real(), s, c);
+    return dual<T>{c, -x.imag() * s};
 }
 
 //---------------------------------------------------------
+/// @brief sine and cosine sharing one evaluation of the real part
+template<class T>
+inline void
+sincos(const dual<T>& x, dual<T>& s, dual<T>& c)
+{
+    T sr, cr;
+    detail::sin_cos(x.real(), sr, cr);
+    s = dual<T>{sr, x.imag() * cr};
+    c = dual<T>{cr, -x.imag() * sr};
+}
+
+//---------------------------------------------------------
+/// @note tan' = 1 + tan^2, so no second transcendental call is needed
 template<class T>
 inline auto
 tan(const dual<T>& x)
 {
-    using std::cos;
     using std::tan;
-    auto cosr2 = cos(x.real());
-    cosr2 *= cosr2;
-    return dual<T>{tan(x.real()), x.imag() / cosr2};
+    const auto tanr = tan(x.real());
+    return dual<T>{tanr, x.imag() * (T(1) + (tanr * tanr))};
 }
 
 
@@ -1051,9 +1065,9 @@ template<class T>
 inline auto
 sinh(const dual<T>& x)
 {
-    using std::sinh;
-    using std::cosh;
-    return dual<T>{sinh(x.real()), x.imag() * cosh(x.real())};
+    T s, c;
+    detail::sinh_cosh(x.real(), s, c);
+    return dual<T>{s, x.imag() * c};
 }
 
 //---------------------------------------------------------
@@ -1061,9 +1075,21 @@ template<class T>
 inline auto
 cosh(const dual<T>& x)
 {
-    using std::sinh;
-    using std::cosh;
-    return dual<T>{cosh(x.real()), x.imag() * sinh(x.real())};
+    T s, c;
+    detail::sinh_cosh(x.real(), s, c);
+    return dual<T>{c, x.imag() * s};
+}
+
+//---------------------------------------------------------
+/// @brief hyperbolic sine and cosine sharing one evaluation of the real part
+template<class T>
+inline void
+sinhcosh(const dual<T>& x, dual<T>& s, dual<T>& c)
+{
+    T sr, cr;
+    detail::sinh_cosh(x.real(), sr, cr);
+    s = dual<T>{sr, x.imag() * cr};
+    c = dual<T>{cr, x.imag() * sr};
 }
 
 //---------------------------------------------------------
@@ -1071,11 +1097,10 @@ template<class T>
 inline auto
 tanh(const dual<T>& x)
 {
-    using std::cosh;
     using std::tanh;
-    auto coshr2 = cosh(x.real());
-    coshr2 *= coshr2;
-    return dual<T>{tanh(x.real()), x.imag() / coshr2};
+    //s / c would give inf / inf for large |x|
+    const auto t = tanh(x.real());
+    return dual<T>{t, x.imag() * (T(1) - t * t)};
 }
 
 
@@ -1142,24 +1167,95 @@ erfc(const dual<T>& x)
 
 //---------------------------------------------------------
 ///@brief gamma function
-//template<class T>
-//inline dual<T>
-//tgamma(const dual<T>& x)
-//{
-//    using std::tgamma;
-//    auto tgamma_r = tgamma(x.real());
-//    return dual<T>{tgamma_r, x.imag() * tgamma_r * digamma(x.real())};
-//}
+template<class T>
+inline auto
+tgamma(const dual<T>& x)
+{
+    using std::tgamma;
+    const auto tgamma_r = tgamma(x.real());
+    return dual<T>{tgamma_r, x.imag() * tgamma_r * digamma(x.real())};
+}
 
 //---------------------------------------------------------
 ///@brief log-gamma function
-//template<class T>
-//inline dual<T>
-//lgamma(const dual<T>& x)
-//{
-//    using std::lgamma;
-//    return dual<T>{lgamma(x.real()), x.imag() * digamma(x.real())};
-//}
+template<class T>
+inline auto
+lgamma(const dual<T>& x)
+{
+    using std::lgamma;
+    return dual<T>{lgamma(x.real()), x.imag() * digamma(x.real())};
+}
+
+//---------------------------------------------------------
+///@brief beta function B(a,b) = gamma(a) gamma(b) / gamma(a+b)
+///       for positive a and b; psi(a+b) is shared by both partials
+template<class T>
+inline auto
+beta(const dual<T>& a, const dual<T>& b)
+{
+    using std::lgamma;
+    using std::exp;
+
+    const auto ab = a.real() + b.real();
+    const auto beta_r = exp(lgamma(a.real()) + lgamma(b.real()) - lgamma(ab));
+    const auto psi_ab = digamma(ab);
+
+    return dual<T>{beta_r, beta_r * (
+        (a.imag() * (digamma(a.real()) - psi_ab)) +
+        (b.imag() * (digamma(b.real()) - psi_ab)) )};
+}
+
+
+
+//-------------------------------------------------------------------
+// TWO-ARGUMENT FUNCTIONS
+//-------------------------------------------------------------------
+/// @brief angle of the point (x,y); both partials share 1/(x^2+y^2)
+template<class T>
+inline auto
+atan2(const dual<T>& y, const dual<T>& x)
+{
+    using std::atan2;
+    const auto inv_r2 = T(1) / ((x.real() * x.real()) + (y.real() * y.real()));
+    return dual<T>{atan2(y.real(), x.real()),
+        ((x.real() * y.imag()) - (y.real() * x.imag())) * inv_r2};
+}
+
+//---------------------------------------------------------
+/// @brief sqrt(x^2 + y^2) without undue overflow;
+///        both partials share 1/hypot(x,y)
+template<class T>
+inline auto
+hypot(const dual<T>& x, const dual<T>& y)
+{
+    using std::hypot;
+    const auto h = hypot(x.real(), y.real());
+    return dual<T>{h,
+        ((x.real() * x.imag()) + (y.real() * y.imag())) / h};
+}
+
+//---------------------------------------------------------
+/// @brief fused multiply-add a*b + c
+template<class T>
+inline auto
+fma(const dual<T>& a, const dual<T>& b, const dual<T>& c)
+{
+    using std::fma;
+    return dual<T>{fma(a.real(), b.real(), c.real()),
+        fma(a.real(), b.imag(), fma(a.imag(), b.real(), c.imag()))};
+}
+
+//---------------------------------------------------------
+/// @brief floating-point remainder x - trunc(x/y) * y
+template<class T>
+inline auto
+fmod(const dual<T>& x, const dual<T>& y)
+{
+    using std::fmod;
+    using std::trunc;
+    return dual<T>{fmod(x.real(), y.real()),
+        x.imag() - (trunc(x.real() / y.real()) * y.imag())};
+}
 
 
 
@@ -1202,6 +1298,194 @@ isnormal(const dual<T>& x)
 
 
 
+/*****************************************************************************
+ *
+ * BATCHED EVALUATION
+ *
+ * @brief apply a function to a range of dual numbers;
+ *        return the end of the output range (like std::transform)
+ *
+ *****************************************************************************/
+namespace detail {
+
+template<class InputIter>
+using enable_if_dual_iter_t = std::enable_if_t<is_dual<
+    typename std::iterator_traits<InputIter>::value_type>::value>;
+
+}  // namespace detail
+
+
+//-------------------------------------------------------------------
+template<class InputIter, class OutputIter,
+         class = detail::enable_if_dual_iter_t<InputIter>>
+inline OutputIter
+sin(InputIter first, InputIter last, OutputIter out)
+{
+    for(; first != last; ++first, ++out) *out = sin(*first);
+    return out;
+}
+
+//---------------------------------------------------------
+template<class InputIter, class OutputIter,
+         class = detail::enable_if_dual_iter_t<InputIter>>
+inline OutputIter
+cos(InputIter first, InputIter last, OutputIter out)
+{
+    for(; first != last; ++first, ++out) *out = cos(*first);
+    return out;
+}
+
+//---------------------------------------------------------
+template<class InputIter, class OutputIter,
+         class = detail::enable_if_dual_iter_t<InputIter>>
+inline OutputIter
+tan(InputIter first, InputIter last, OutputIter out)
+{
+    for(; first != last; ++first, ++out) *out = tan(*first);
+    return out;
+}
+
+//---------------------------------------------------------
+template<class InputIter, class OutputIter1, class OutputIter2,
+         class = detail::enable_if_dual_iter_t<InputIter>>
+inline void
+sincos(InputIter first, InputIter last,
+       OutputIter1 sinOut, OutputIter2 cosOut)
+{
+    for(; first != last; ++first, ++sinOut, ++cosOut) {
+        sincos(*first, *sinOut, *cosOut);
+    }
+}
+
+//---------------------------------------------------------
+template<class InputIter, class OutputIter,
+         class = detail::enable_if_dual_iter_t<InputIter>>
+inline OutputIter
+sinh(InputIter first, InputIter last, OutputIter out)
+{
+    for(; first != last; ++first, ++out) *out = sinh(*first);
+    return out;
+}
+
+//---------------------------------------------------------
+template<class InputIter, class OutputIter,
+         class = detail::enable_if_dual_iter_t<InputIter>>
+inline OutputIter
+cosh(InputIter first, InputIter last, OutputIter out)
+{
+    for(; first != last; ++first, ++out) *out = cosh(*first);
+    return out;
+}
+
+//---------------------------------------------------------
+template<class InputIter, class OutputIter,
+         class = detail::enable_if_dual_iter_t<InputIter>>
+inline OutputIter
+tanh(InputIter first, InputIter last, OutputIter out)
+{
+    for(; first != last; ++first, ++out) *out = tanh(*first);
+    return out;
+}
+
+//---------------------------------------------------------
+template<class InputIter, class OutputIter1, class OutputIter2,
+         class = detail::enable_if_dual_iter_t<InputIter>>
+inline void
+sinhcosh(InputIter first, InputIter last,
+         OutputIter1 sinhOut, OutputIter2 coshOut)
+{
+    for(; first != last; ++first, ++sinhOut, ++coshOut) {
+        sinhcosh(*first, *sinhOut, *coshOut);
+    }
+}
+
+
+
+
+//---------------------------------------------------------
+template<class InputIter, class OutputIter,
+         class = detail::enable_if_dual_iter_t<InputIter>>
+inline OutputIter
+tgamma(InputIter first, InputIter last, OutputIter out)
+{
+    for(; first != last; ++first, ++out) *out = tgamma(*first);
+    return out;
+}
+
+//---------------------------------------------------------
+template<class InputIter, class OutputIter,
+         class = detail::enable_if_dual_iter_t<InputIter>>
+inline OutputIter
+lgamma(InputIter first, InputIter last, OutputIter out)
+{
+    for(; first != last; ++first, ++out) *out = lgamma(*first);
+    return out;
+}
+
+//---------------------------------------------------------
+template<class InputIter1, class InputIter2, class OutputIter,
+         class = detail::enable_if_dual_iter_t<InputIter1>>
+inline OutputIter
+atan2(InputIter1 firstY, InputIter1 lastY, InputIter2 firstX, OutputIter out)
+{
+    for(; firstY != lastY; ++firstY, ++firstX, ++out) {
+        *out = atan2(*firstY, *firstX);
+    }
+    return out;
+}
+
+//---------------------------------------------------------
+template<class InputIter1, class InputIter2, class OutputIter,
+         class = detail::enable_if_dual_iter_t<InputIter1>>
+inline OutputIter
+hypot(InputIter1 firstX, InputIter1 lastX, InputIter2 firstY, OutputIter out)
+{
+    for(; firstX != lastX; ++firstX, ++firstY, ++out) {
+        *out = hypot(*firstX, *firstY);
+    }
+    return out;
+}
+
+//---------------------------------------------------------
+template<class InputIter1, class InputIter2, class OutputIter,
+         class = detail::enable_if_dual_iter_t<InputIter1>>
+inline OutputIter
+fmod(InputIter1 firstX, InputIter1 lastX, InputIter2 firstY, OutputIter out)
+{
+    for(; firstX != lastX; ++firstX, ++firstY, ++out) {
+        *out = fmod(*firstX, *firstY);
+    }
+    return out;
+}
+
+//---------------------------------------------------------
+template<class InputIter1, class InputIter2, class InputIter3,
+         class OutputIter, class = detail::enable_if_dual_iter_t<InputIter1>>
+inline OutputIter
+fma(InputIter1 firstA, InputIter1 lastA, InputIter2 firstB, InputIter3 firstC,
+    OutputIter out)
+{
+    for(; firstA != lastA; ++firstA, ++firstB, ++firstC, ++out) {
+        *out = fma(*firstA, *firstB, *firstC);
+    }
+    return out;
+}
+
+//---------------------------------------------------------
+template<class InputIter1, class InputIter2, class OutputIter,
+         class = detail::enable_if_dual_iter_t<InputIter1>>
+inline OutputIter
+beta(InputIter1 firstA, InputIter1 lastA, InputIter2 firstB, OutputIter out)
+{
+    for(; firstA != lastA; ++firstA, ++firstB, ++out) {
+        *out = beta(*firstA, *firstB);
+    }
+    return out;
+}
+
+
+
+
 /*****************************************************************************
  *
  * TRAITS SPECIALIZATIONS
@@ -0,0 +1,215 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_DUAL_ARRAY_H_
+#define AM_NUMERIC_DUAL_ARRAY_H_
+
+#include <vector>
+#include <cstddef>
+#include <initializer_list>
+
+#include "dual.h"
+#include "simd_pack.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief
+ * sequence of dual numbers stored as two separate arrays
+ * (real parts and dual parts; "structure of arrays")
+ *
+ * Blocks of W consecutive elements can be loaded as one
+ * dual<simd_pack<T,W>>, so that elementary functions process
+ * W samples per call.
+ *
+ *****************************************************************************/
+template<class NumberType>
+class dual_array
+{
+public:
+
+    static_assert(std::is_arithmetic<NumberType>::value,
+        "dual_array<T>: T must be a builtin arithmetic type");
+
+
+    //---------------------------------------------------------------
+    using value_type      = dual<NumberType>;
+    using numeric_type    = NumberType;
+    using size_type       = std::size_t;
+
+    template<std::size_t W>
+    using pack_type = dual<simd_pack<numeric_type,W>>;
+
+
+    //---------------------------------------------------------------
+    dual_array() = default;
+
+    explicit
+    dual_array(size_type n):
+        r_(n), i_(n)
+    {}
+
+    dual_array(size_type n, const value_type& x):
+        r_(n, x.real()), i_(n, x.imag())
+    {}
+
+    dual_array(std::initializer_list<value_type> il):
+        r_(), i_()
+    {
+        reserve(il.size());
+        for(const auto& x : il) push_back(x);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        return r_.size();
+    }
+
+    bool
+    empty() const noexcept {
+        return r_.empty();
+    }
+
+    void
+    resize(size_type n) {
+        r_.resize(n);
+        i_.resize(n);
+    }
+
+    void
+    reserve(size_type n) {
+        r_.reserve(n);
+        i_.reserve(n);
+    }
+
+    void
+    clear() noexcept {
+        r_.clear();
+        i_.clear();
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator [] (size_type i) const noexcept {
+        return value_type{r_[i], i_[i]};
+    }
+
+    void
+    set(size_type i, const value_type& x) noexcept {
+        r_[i] = x.real();
+        i_[i] = x.imag();
+    }
+
+    void
+    push_back(const value_type& x) {
+        r_.push_back(x.real());
+        i_.push_back(x.imag());
+    }
+
+
+    //---------------------------------------------------------------
+    const numeric_type*
+    real_data() const noexcept {
+        return r_.data();
+    }
+
+    numeric_type*
+    real_data() noexcept {
+        return r_.data();
+    }
+
+    const numeric_type*
+    imag_data() const noexcept {
+        return i_.data();
+    }
+
+    numeric_type*
+    imag_data() noexcept {
+        return i_.data();
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief loads elements [i,i+W) as one pack
+    template<std::size_t W>
+    pack_type<W>
+    load(size_type i) const noexcept {
+        using P = simd_pack<numeric_type,W>;
+        return pack_type<W>{P::load(r_.data() + i), P::load(i_.data() + i)};
+    }
+
+    /// @brief stores all lanes of x at positions [i,i+W)
+    template<std::size_t W>
+    void
+    store(size_type i, const pack_type<W>& x) noexcept {
+        x.real().store(r_.data() + i);
+        x.imag().store(i_.data() + i);
+    }
+
+
+private:
+
+    //---------------------------------------------------------------
+    std::vector<numeric_type> r_;
+    std::vector<numeric_type> i_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+/**
+ * @brief out[i] = f(in[i]) for all i;
+ *        processes W elements per call of f;
+ *        the remaining elements are passed to f as scalar dual numbers,
+ *        so f should be a generic function object
+ *        (e.g. [](const auto& x) { return sin(x) * x; })
+ */
+template<std::size_t W, class T, class UnaryOp>
+inline void
+transform(const dual_array<T>& in, dual_array<T>& out, UnaryOp f)
+{
+    const auto n = in.size();
+    if(out.size() != n) out.resize(n);
+
+    std::size_t i = 0;
+    for(; i + W <= n; i += W) {
+        out.template store<W>(i, f(in.template load<W>(i)));
+    }
+    for(; i < n; ++i) {
+        out.set(i, f(in[i]));
+    }
+}
+
+//---------------------------------------------------------
+template<class T, class UnaryOp>
+inline void
+transform(const dual_array<T>& in, dual_array<T>& out, UnaryOp f)
+{
+    transform<default_simd_width<T>>(in, out, f);
+}
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,671 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_DYNAMIC_CHOICE_H_
+#define AM_NUMERIC_DYNAMIC_CHOICE_H_
+
+#include <type_traits>
+#include <limits>
+#include <cstdint>
+#include <cassert>
+#include <stdexcept>
+
+#include "choice.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief modulus that is only known at runtime
+ *
+ * Precomputes reciprocals once, so that reductions need no
+ * integer divisions:
+ *   - power of two moduli: masking
+ *   - values up to 64 bits: Barrett reduction (one 64 bit high
+ *     multiplication, one low multiplication, one conditional subtraction)
+ *   - 128 bit products of 64 bit residues: division by invariant integers
+ *     (Möller & Granlund 2011; one widening multiplication,
+ *     one low multiplication, two conditional corrections)
+ *
+ * Can be used directly on raw residues in [0,n) or through dynamic_choice.
+ *
+ *****************************************************************************/
+template<class IntT>
+class dynamic_modulus
+{
+    static_assert(is_integral<IntT>::value,
+        "dynamic_modulus<T> : T has to be an integral number type");
+
+public:
+    //---------------------------------------------------------------
+    using value_type = IntT;
+    using uint_t = std::conditional_t<(sizeof(IntT) <= 4),
+                                      std::uint32_t, std::uint64_t>;
+    //void, if there is no wider builtin type
+    using wide_t = detail::wider_integer_t<uint_t>;
+
+
+    //---------------------------------------------------------------
+    /// @pre n > 0
+    explicit constexpr
+    dynamic_modulus(value_type n = value_type(1)) noexcept:
+        n_(uint_t(n)), mask_(uint_t(uint_t(n) - 1)),
+        pow2_((uint_t(n) & uint_t(uint_t(n) - 1)) == 0),
+        f_(~std::uint64_t(0) / std::uint64_t(n)),
+        s_(leading_zeros(uint_t(n))),
+        d_(uint_t(uint_t(n) << s_)),
+        v_(reciprocal(d_, has_wide{}))
+    {
+        assert(n > value_type(0));
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr uint_t
+    modulus() const noexcept {
+        return n_;
+    }
+
+    constexpr bool
+    power_of_two() const noexcept {
+        return pow2_;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief u mod n
+    constexpr uint_t
+    reduce(uint_t u) const noexcept {
+        return pow2_ ? uint_t(u & mask_) : barrett(u);
+    }
+
+    //-----------------------------------------------------
+    /// @brief x mod n for any builtin integer x; result in [0,n)
+    template<class T>
+    constexpr uint_t
+    reduce_signed(T x) const noexcept {
+        return negate(reduce_unsigned(unsigned_magnitude(x),
+                          std::integral_constant<bool,
+                              (sizeof(T) > sizeof(uint_t))>{}),
+                      x < T(0));
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief (a + b) mod n for a,b in [0,n); can't overflow
+    constexpr uint_t
+    add(uint_t a, uint_t b) const noexcept {
+        return (a >= uint_t(n_ - b)) ? uint_t(a - (n_ - b)) : uint_t(a + b);
+    }
+
+    //-----------------------------------------------------
+    /// @brief (a - b) mod n for a,b in [0,n)
+    constexpr uint_t
+    sub(uint_t a, uint_t b) const noexcept {
+        return (a >= b) ? uint_t(a - b) : uint_t(a + (n_ - b));
+    }
+
+    //-----------------------------------------------------
+    /// @brief (a * b) mod n for a,b in [0,n); can't overflow
+    constexpr uint_t
+    mul(uint_t a, uint_t b) const noexcept {
+        //a power of two modulus divides 2^bits
+        return pow2_ ? uint_t(uint_t(a * b) & mask_)
+                     : mul_wide(a, b, std::integral_constant<int,
+                                          (bits <= 32) ? 0 : has_wide::value ? 1 : 2>{});
+    }
+
+
+private:
+    using has_wide = std::integral_constant<bool, !std::is_void<wide_t>::value>;
+    using wide_or_uint_t = std::conditional_t<has_wide::value, wide_t, uint_t>;
+
+    static constexpr int bits = std::numeric_limits<uint_t>::digits;
+
+    //---------------------------------------------------------------
+    static constexpr int
+    leading_zeros(uint_t d) noexcept {
+        int s = 0;
+        for(; d < (uint_t(1) << (bits - 1)); d <<= 1) ++s;
+        return s;
+    }
+
+    /// @brief floor((2^(2*bits) - 1) / d) - 2^bits for normalized d
+    static constexpr uint_t
+    reciprocal(uint_t d, std::true_type) noexcept {
+        return uint_t(~wide_or_uint_t(0) / d);
+    }
+
+    static constexpr uint_t
+    reciprocal(uint_t, std::false_type) noexcept {
+        return uint_t(0);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief products of 32 bit residues fit into 64 bits
+    constexpr uint_t
+    mul_wide(uint_t a, uint_t b, std::integral_constant<int,0>) const noexcept {
+        return barrett(std::uint64_t(std::uint64_t(a) * b));
+    }
+
+    constexpr uint_t
+    mul_wide(uint_t a, uint_t b, std::integral_constant<int,1>) const noexcept {
+        return reduce_wide(wide_or_uint_t(wide_or_uint_t(a) * b));
+    }
+
+    constexpr uint_t
+    mul_wide(uint_t a, uint_t b, std::integral_constant<int,2>) const noexcept {
+        //binary method; only additions
+        uint_t r = 0;
+        for(; b > 0; b >>= 1) {
+            if(b & 1) r = add(r, a);
+            a = add(a, a);
+        }
+        return r;
+    }
+
+    //-----------------------------------------------------
+    /// @brief w mod n for any 64 bit value w
+    constexpr uint_t
+    barrett(std::uint64_t w) const noexcept {
+        //remainder is < 2n
+        const auto r = std::uint64_t(w - detail::mul_high(w, f_) * n_);
+        return uint_t((r >= n_) ? r - n_ : r);
+    }
+
+    //-----------------------------------------------------
+    /// @brief w mod n for w < n * 2^bits
+    constexpr uint_t
+    reduce_wide(wide_or_uint_t w) const noexcept {
+        //normalized: the divisor d = n * 2^s has its highest bit set
+        const auto u = wide_or_uint_t(w << s_);
+        const auto u1 = uint_t(u >> bits);
+        const auto u0 = uint_t(u);
+        //quotient estimate
+        const auto q = wide_or_uint_t(wide_or_uint_t(v_) * u1 + u);
+        const auto q1 = uint_t(uint_t(q >> bits) + 1);
+        const auto q0 = uint_t(q);
+        auto r = uint_t(u0 - q1 * d_);
+        if(r > q0) r = uint_t(r + d_);
+        if(r >= d_) r = uint_t(r - d_);
+        return uint_t(r >> s_);
+    }
+
+    //---------------------------------------------------------------
+    template<class U>
+    constexpr uint_t
+    reduce_unsigned(U u, std::false_type /* fits into uint_t */) const noexcept {
+        return reduce(uint_t(u));
+    }
+
+    template<class U>
+    constexpr uint_t
+    reduce_unsigned(U u, std::true_type) const noexcept {
+        //only 32 bit residues: U has 64 bits
+        return barrett(std::uint64_t(u));
+    }
+
+    template<class T>
+    static constexpr std::make_unsigned_t<T>
+    unsigned_magnitude(T x) noexcept {
+        using u_t = std::make_unsigned_t<T>;
+        return (x < T(0)) ? u_t(u_t(0) - u_t(x)) : u_t(x);
+    }
+
+    constexpr uint_t
+    negate(uint_t r, bool neg) const noexcept {
+        return (neg && r != 0) ? uint_t(n_ - r) : r;
+    }
+
+
+    //---------------------------------------------------------------
+    uint_t n_;
+    uint_t mask_;
+    bool pow2_;
+    /// @brief floor((2^64 - 1) / n)
+    std::uint64_t f_;
+    /// @brief normalization shift, normalized modulus and its reciprocal
+    ///        (only used for products of 64 bit residues)
+    int s_;
+    uint_t d_;
+    uint_t v_;
+};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief represents an element of IN / IN(n) with a runtime modulus n
+ *
+ * All values with the same tag type share one modulus object,
+ * so a value only stores its residue (same size as IntT) and
+ * arithmetic is as cheap as with a compile-time modulus
+ * apart from loading the precomputed constants.
+ *
+ * @note  set_modulus is not synchronized and invalidates all existing
+ *        values with the same tag; use different tags for
+ *        independent moduli.
+ *
+ * @tparam IntT  an integral type
+ * @tparam Tag   distinguishes independent moduli
+ *
+ *****************************************************************************/
+template<class IntT, class Tag = void>
+class dynamic_choice
+{
+    using mod_t  = dynamic_modulus<IntT>;
+    using uint_t = typename mod_t::uint_t;
+
+public:
+    //---------------------------------------------------------------
+    using value_type   = IntT;
+    using numeric_type = value_type;
+    using modulus_type = mod_t;
+
+
+    //---------------------------------------------------------------
+    /// @pre n > 0
+    static void
+    set_modulus(const value_type& n) noexcept {
+        mod_ = mod_t{n};
+    }
+
+    static const modulus_type&
+    modulus() noexcept {
+        return mod_;
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr
+    dynamic_choice() = default;
+
+    explicit
+    dynamic_choice(const value_type& x):
+        x_(value_type(mod_.reduce_signed(x)))
+    {}
+
+
+    //---------------------------------------------------------------
+    dynamic_choice&
+    operator = (const value_type& x)
+    {
+        x_ = value_type(mod_.reduce_signed(x));
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr
+    value_type
+    value() const noexcept {
+        return x_;
+    }
+
+    template<class T>
+    explicit
+    operator T () const noexcept
+    {
+        return x_;
+    }
+
+
+    //---------------------------------------------------------------
+    static constexpr value_type
+    min() noexcept {
+        return 0;
+    }
+
+    static value_type
+    max() noexcept {
+        return value_type(mod_.modulus() - 1);
+    }
+
+    //-----------------------------------------------------
+    static value_type
+    choices() noexcept {
+        return value_type(mod_.modulus());
+    }
+
+
+    //---------------------------------------------------------------
+    dynamic_choice&
+    operator += (const dynamic_choice& c)
+    {
+        x_ = value_type(mod_.add(uint_t(x_), uint_t(c.x_)));
+        return *this;
+    }
+
+    template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
+    dynamic_choice&
+    operator += (const T& x)
+    {
+        x_ = value_type(mod_.add(uint_t(x_), mod_.reduce_signed(x)));
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    dynamic_choice&
+    operator -= (const dynamic_choice& c) {
+        x_ = value_type(mod_.sub(uint_t(x_), uint_t(c.x_)));
+        return *this;
+    }
+
+    template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
+    dynamic_choice&
+    operator -= (const T& x)
+    {
+        x_ = value_type(mod_.sub(uint_t(x_), mod_.reduce_signed(x)));
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    dynamic_choice&
+    operator *= (const dynamic_choice& c)
+    {
+        x_ = value_type(mod_.mul(uint_t(x_), uint_t(c.x_)));
+        return *this;
+    }
+
+    template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
+    dynamic_choice&
+    operator *= (const T& x)
+    {
+        x_ = value_type(mod_.mul(uint_t(x_), mod_.reduce_signed(x)));
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    dynamic_choice
+    operator + (const dynamic_choice& c) const {
+        //use special non-mod ctor
+        return dynamic_choice{value_type(mod_.add(uint_t(x_), uint_t(c.x_))), 0};
+    }
+
+    dynamic_choice
+    operator - (const dynamic_choice& c) const {
+        //use special non-mod ctor
+        return dynamic_choice{value_type(mod_.sub(uint_t(x_), uint_t(c.x_))), 0};
+    }
+
+    dynamic_choice
+    operator * (const dynamic_choice& c) const {
+        //use special non-mod ctor
+        return dynamic_choice{value_type(mod_.mul(uint_t(x_), uint_t(c.x_))), 0};
+    }
+
+
+    //---------------------------------------------------------------
+    dynamic_choice
+    operator - () const {
+        //use special non-mod ctor
+        return dynamic_choice{value_type(mod_.sub(0, uint_t(x_))), 0};
+    }
+
+    /// @brief in-place additive inverse (negation)
+    dynamic_choice&
+    invert() {
+        x_ = value_type(mod_.sub(0, uint_t(x_)));
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    dynamic_choice&
+    operator ++ () {
+        x_ = value_type(mod_.add(uint_t(x_), mod_.reduce(1)));
+        return *this;
+    }
+
+    dynamic_choice
+    operator ++ (int) {
+        auto old = *this;
+        ++*this;
+        return old;
+    }
+
+    dynamic_choice&
+    operator -- () {
+        x_ = value_type(mod_.sub(uint_t(x_), mod_.reduce(1)));
+        return *this;
+    }
+
+    dynamic_choice
+    operator -- (int) {
+        auto old = *this;
+        --*this;
+        return old;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    /// @brief special ctor without modulo operation
+    constexpr explicit
+    dynamic_choice(const value_type& x, int):
+        x_{x}
+    {}
+
+    value_type x_ = value_type(0);
+
+    static mod_t mod_;
+};
+
+
+//-------------------------------------------------------------------
+template<class IntT, class Tag>
+dynamic_modulus<IntT> dynamic_choice<IntT,Tag>::mod_ {};
+
+
+
+
+
+
+/*****************************************************************************
+ *
+ * ARITHMETIC
+ *
+ *****************************************************************************/
+template<class T, class IntT, class Tag,
+         class = std::enable_if_t<std::is_integral<T>::value>>
+inline dynamic_choice<IntT,Tag>
+operator + (const T& x, dynamic_choice<IntT,Tag> c)
+{
+    return (c += x);
+}
+
+template<class T, class IntT, class Tag,
+         class = std::enable_if_t<std::is_integral<T>::value>>
+inline dynamic_choice<IntT,Tag>
+operator + (dynamic_choice<IntT,Tag> c, const T& x)
+{
+    return (c += x);
+}
+
+
+//-------------------------------------------------------------------
+template<class T, class IntT, class Tag,
+         class = std::enable_if_t<std::is_integral<T>::value>>
+inline dynamic_choice<IntT,Tag>
+operator - (const T& x, const dynamic_choice<IntT,Tag>& c)
+{
+    auto r = -c;
+    return (r += x);
+}
+
+template<class T, class IntT, class Tag,
+         class = std::enable_if_t<std::is_integral<T>::value>>
+inline dynamic_choice<IntT,Tag>
+operator - (dynamic_choice<IntT,Tag> c, const T& x)
+{
+    return (c -= x);
+}
+
+
+//-------------------------------------------------------------------
+template<class T, class IntT, class Tag,
+         class = std::enable_if_t<std::is_integral<T>::value>>
+inline dynamic_choice<IntT,Tag>
+operator * (const T& x, dynamic_choice<IntT,Tag> c)
+{
+    return (c *= x);
+}
+
+template<class T, class IntT, class Tag,
+         class = std::enable_if_t<std::is_integral<T>::value>>
+inline dynamic_choice<IntT,Tag>
+operator * (dynamic_choice<IntT,Tag> c, const T& x)
+{
+    return (c *= x);
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * MULTIPLICATIVE GROUP
+ *
+ * batch_inverse from choice.h works with dynamic_choice, too
+ *
+ *****************************************************************************/
+/**
+ * @brief multiplicative inverse
+ * @throws std::domain_error if c and n are not coprime
+ */
+template<class IntT, class Tag>
+inline dynamic_choice<IntT,Tag>
+inverse(const dynamic_choice<IntT,Tag>& c)
+{
+    using u_t = typename dynamic_modulus<IntT>::uint_t;
+
+    const auto& m = dynamic_choice<IntT,Tag>::modulus();
+    u_t inv = 0;
+    if(!detail::choice_inverse(m, u_t(c.value()), inv)) {
+        throw std::domain_error{"dynamic_choice: element is not invertible"};
+    }
+    return dynamic_choice<IntT,Tag>{IntT(inv)};
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief c^e by square-and-multiply
+ *        negative exponents use the multiplicative inverse of c
+ */
+template<class IntT, class Tag, class E,
+         class = std::enable_if_t<std::is_integral<E>::value>>
+inline dynamic_choice<IntT,Tag>
+pow(dynamic_choice<IntT,Tag> c, E e)
+{
+    using u_t = std::make_unsigned_t<E>;
+
+    if(e < E(0)) c = inverse(c);
+    auto u = (e < E(0)) ? u_t(u_t(0) - u_t(e)) : u_t(e);
+
+    auto r = dynamic_choice<IntT,Tag>{IntT(1)};
+    for(; u > 0; u >>= 1) {
+        if(u & 1) r *= c;
+        c *= c;
+    }
+    return r;
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * COMPARISON
+ *
+ *****************************************************************************/
+template<class IntT, class Tag>
+inline constexpr bool
+operator == (dynamic_choice<IntT,Tag> a, dynamic_choice<IntT,Tag> b) {
+    return (a.value() == b.value());
+}
+
+//---------------------------------------------------------
+template<class IntT, class Tag>
+inline constexpr bool
+operator != (dynamic_choice<IntT,Tag> a, dynamic_choice<IntT,Tag> b) {
+    return (a.value() != b.value());
+}
+
+
+//-------------------------------------------------------------------
+template<class IntT, class Tag>
+inline constexpr bool
+operator <  (dynamic_choice<IntT,Tag> a, dynamic_choice<IntT,Tag> b) {
+    return (a.value() < b.value());
+}
+
+//---------------------------------------------------------
+template<class IntT, class Tag>
+inline constexpr bool
+operator <= (dynamic_choice<IntT,Tag> a, dynamic_choice<IntT,Tag> b) {
+    return (a.value() <= b.value());
+}
+
+
+//-------------------------------------------------------------------
+template<class IntT, class Tag>
+inline constexpr bool
+operator >  (dynamic_choice<IntT,Tag> a, dynamic_choice<IntT,Tag> b) {
+    return (a.value() > b.value());
+}
+
+//---------------------------------------------------------
+template<class IntT, class Tag>
+inline constexpr bool
+operator >= (dynamic_choice<IntT,Tag> a, dynamic_choice<IntT,Tag> b) {
+    return (a.value() >= b.value());
+}
+
+
+
+
+
+
+/*****************************************************************************
+ *
+ * I/O
+ *
+ *****************************************************************************/
+template<class Ostream, class IntT, class Tag>
+inline Ostream&
+operator << (Ostream& os, const dynamic_choice<IntT,Tag>& c)
+{
+    return (os << std::intmax_t(c));
+}
+
+//---------------------------------------------------------
+template<class Ostream, class IntT, class Tag>
+inline Ostream&
+print(Ostream& os, const dynamic_choice<IntT,Tag>& c)
+{
+    return (os << "[" << std::intmax_t(c) << "/"
+               << std::intmax_t(dynamic_choice<IntT,Tag>::choices()) << "]");
+}
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,380 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_EXACT_SOLVE_H_
+#define AM_NUMERIC_EXACT_SOLVE_H_
+
+#include <cstddef>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "traits.h"
+#include "overflow.h"
+#include "gcd.h"
+#include "rational.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * FRACTION-FREE (BAREISS) ELIMINATION
+ *
+ * All matrices are dense, square and stored row-major in a std::vector.
+ *
+ * Every intermediate entry is a minor of the input matrix, so all
+ * divisions are exact and the numbers only grow linearly with the
+ * number of eliminated columns instead of exponentially as with
+ * plain Gaussian elimination over rationals.
+ * No gcd computations are needed except for reducing the final results.
+ *
+ * For builtin integer types products are computed in the next wider
+ * builtin type (if there is one) and std::overflow_error is thrown
+ * if an intermediate minor does not fit into the integer type.
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief (a*b - c*d) / p; the division must be exact
+template<class T>
+inline T
+bareiss_update(const T& a, const T& b, const T& c, const T& d, const T& p,
+               std::true_type /* has wider builtin type */)
+{
+    using w_t = wider_integer_t<T>;
+    using lim = std::numeric_limits<T>;
+
+    const w_t r = (w_t(a) * w_t(b) - w_t(c) * w_t(d)) / w_t(p);
+
+    if(r < w_t(lim::min()) || r > w_t(lim::max())) {
+        throw std::overflow_error{"bareiss elimination: integer overflow"};
+    }
+    return static_cast<T>(r);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline T
+bareiss_update(const T& a, const T& b, const T& c, const T& d, const T& p,
+               std::false_type)
+{
+    T ab, cd;
+    if(mul_overflow(a, b, ab) || mul_overflow(c, d, cd) ||
+       sub_overflow(ab, cd, ab))
+    {
+        throw std::overflow_error{"bareiss elimination: integer overflow"};
+    }
+    ab /= p;
+    return ab;
+}
+
+//---------------------------------------------------------
+template<class T>
+inline T
+bareiss_update(const T& a, const T& b, const T& c, const T& d, const T& p)
+{
+    return bareiss_update(a, b, c, d, p, std::integral_constant<bool,
+        std::is_integral<T>::value &&
+        !std::is_void<wider_integer_t<T>>::value>{});
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline T
+checked_product(const T& a, const T& b)
+{
+    T r;
+    if(mul_overflow(a, b, r)) {
+        throw std::overflow_error{"exact_solve: integer overflow"};
+    }
+    return r;
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief swaps first row with non-zero entry in column k (at or below
+ *        row k) into row k
+ *
+ * @return false, if there is no such row
+ */
+template<class T>
+inline bool
+bareiss_pivot(std::vector<T>& a, std::size_t n, std::size_t m,
+              std::size_t k, bool& negate)
+{
+    std::size_t p = k;
+    while(p < n && a[p*m + k] == T(0)) ++p;
+    if(p == n) return false;
+
+    if(p != k) {
+        using std::swap;
+        for(std::size_t j = k; j < m; ++j) swap(a[k*m + j], a[p*m + j]);
+        negate = !negate;
+    }
+    return true;
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief forward elimination of a n x n matrix in-place
+ * @return determinant
+ */
+template<class T>
+T bareiss_determinant(std::vector<T>& a, std::size_t n)
+{
+    if(n == 0) return T(1);
+
+    T prev {1};
+    bool negate = false;
+
+    for(std::size_t k = 0; k+1 < n; ++k) {
+        if(!bareiss_pivot(a, n, n, k, negate)) return T(0);
+
+        const T& akk = a[k*n + k];
+        for(std::size_t i = k+1; i < n; ++i) {
+            const T& aik = a[i*n + k];
+            for(std::size_t j = k+1; j < n; ++j) {
+                a[i*n + j] = bareiss_update(akk, a[i*n + j],
+                                            aik, a[k*n + j], prev);
+            }
+        }
+        prev = akk;
+    }
+
+    T det = a[n*n - 1];
+    if(negate) det = T(-det);
+    return det;
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief fraction-free Gauss-Jordan elimination of a n x m matrix
+ *        (n <= m) in-place
+ *
+ * After successful elimination all diagonal entries of the left n x n
+ * block are equal to d = +/-det(A), all other entries of that block
+ * are zero and the remaining columns contain d times the solutions.
+ *
+ * @return d; zero, if the left n x n block is singular
+ */
+template<class T>
+T bareiss_jordan(std::vector<T>& a, std::size_t n, std::size_t m)
+{
+    assert(n <= m);
+
+    T prev {1};
+    bool negate = false;
+
+    for(std::size_t k = 0; k < n; ++k) {
+        if(!bareiss_pivot(a, n, m, k, negate)) return T(0);
+
+        //rows only depend on themselves and on pivot row k
+        const T& akk = a[k*m + k];
+        for(std::size_t i = 0; i < n; ++i) {
+            if(i == k) continue;
+            const T& aik = a[i*m + k];
+            for(std::size_t j = k+1; j < m; ++j) {
+                a[i*m + j] = bareiss_update(akk, a[i*m + j],
+                                            aik, a[k*m + j], prev);
+            }
+            a[i*m + k] = T(0);
+            if(i < k) a[i*m + i] = akk;
+        }
+        prev = akk;
+    }
+
+    return prev;
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief multiplies each row of a (n x m) by the lcm of its denominators
+ * @param scales receives the row factors
+ */
+template<class T, class P>
+inline std::vector<T>
+scale_to_integers(const std::vector<rational<T,P>>& a,
+                  std::size_t n, std::size_t m, std::vector<T>& scales)
+{
+    std::vector<T> s;
+    s.reserve(n*m);
+    scales.clear();
+    scales.reserve(n);
+
+    for(std::size_t i = 0; i < n; ++i) {
+        T l {1};
+        //lcm of denominators
+        for(std::size_t j = 0; j < m; ++j) {
+            const auto& d = a[i*m + j].denom();
+            T f = d / gcd(l, d);
+            if(f < T(0)) f = -f;
+            l = checked_product(l, f);
+        }
+        for(std::size_t j = 0; j < m; ++j) {
+            const auto& x = a[i*m + j];
+            const T f = l / x.denom();
+            s.push_back(checked_product(x.numer(), f));
+        }
+        scales.push_back(std::move(l));
+    }
+    return s;
+}
+
+}  // namespace detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief determinant of an integer n x n matrix (row-major)
+ *
+ *****************************************************************************/
+template<class IntT, class = std::enable_if_t<is_integral<IntT>::value>>
+inline IntT
+exact_determinant(std::vector<IntT> a, std::size_t n)
+{
+    assert(a.size() == n*n);
+    return detail::bareiss_determinant(a, n);
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief determinant of a rational n x n matrix (row-major)
+ *
+ * Rows are scaled to integers by the lcm of their denominators,
+ * so the elimination itself runs on integers only.
+ * The result is normalized.
+ */
+template<class T, class P>
+inline rational<T,P>
+exact_determinant(const std::vector<rational<T,P>>& a, std::size_t n)
+{
+    assert(a.size() == n*n);
+
+    std::vector<T> scales;
+    auto s = detail::scale_to_integers(a, n, n, scales);
+
+    T num = detail::bareiss_determinant(s, n);
+    T den {1};
+    if(num != T(0)) {
+        for(auto& l : scales) {
+            const T g = gcd(num, l);
+            const T f = l / g;
+            num /= g;
+            den = detail::checked_product(den, f);
+        }
+    }
+    return rational<T,P>{std::move(num), std::move(den)};
+}
+
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief solves A x = b for an integer n x n matrix A (row-major)
+ *
+ * @return normalized solution vector;
+ *         empty, if A is singular
+ */
+template<class IntT, class = std::enable_if_t<is_integral<IntT>::value>>
+std::vector<rational<IntT>>
+exact_solve(const std::vector<IntT>& A, const std::vector<IntT>& b,
+            std::size_t n)
+{
+    assert(A.size() == n*n);
+    assert(b.size() == n);
+
+    //augmented matrix [A|b]
+    const std::size_t m = n + 1;
+    std::vector<IntT> a;
+    a.reserve(n*m);
+    for(std::size_t i = 0; i < n; ++i) {
+        a.insert(a.end(), A.begin() + i*n, A.begin() + (i+1)*n);
+        a.push_back(b[i]);
+    }
+
+    const IntT d = detail::bareiss_jordan(a, n, m);
+
+    std::vector<rational<IntT>> x;
+    if(d == IntT(0)) return x;
+
+    x.reserve(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        x.emplace_back(std::move(a[i*m + n]), d);
+        x.back().normalize();
+    }
+    return x;
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief solves A x = b for a rational n x n matrix A (row-major)
+ *
+ * Rows of [A|b] are scaled to integers by the lcm of their denominators
+ * (which doesn't change the solution), so the elimination itself runs
+ * on integers only.
+ *
+ * @return normalized solution vector;
+ *         empty, if A is singular
+ */
+template<class T, class P>
+std::vector<rational<T,P>>
+exact_solve(const std::vector<rational<T,P>>& A,
+            const std::vector<rational<T,P>>& b,
+            std::size_t n)
+{
+    assert(A.size() == n*n);
+    assert(b.size() == n);
+
+    const std::size_t m = n + 1;
+    std::vector<rational<T,P>> ab;
+    ab.reserve(n*m);
+    for(std::size_t i = 0; i < n; ++i) {
+        ab.insert(ab.end(), A.begin() + i*n, A.begin() + (i+1)*n);
+        ab.push_back(b[i]);
+    }
+
+    std::vector<T> scales;
+    auto a = detail::scale_to_integers(ab, n, m, scales);
+
+    const T d = detail::bareiss_jordan(a, n, m);
+
+    std::vector<rational<T,P>> x;
+    if(d == T(0)) return x;
+
+    x.reserve(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        x.emplace_back(std::move(a[i*m + n]), d);
+        x.back().normalize();
+    }
+    return x;
+}
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
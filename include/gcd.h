@@ -0,0 +1,256 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_GCD_H_
+#define AM_NUMERIC_GCD_H_
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "overflow.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * BIT HELPERS
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief number of trailing zero bits; x must not be zero
+template<class UIntT>
+inline constexpr int
+count_trailing_zeros(UIntT x) noexcept
+{
+    static_assert(std::is_unsigned<UIntT>::value,
+        "count_trailing_zeros: argument type must be unsigned");
+
+#if defined(__GNUC__)
+    if(sizeof(UIntT) <= sizeof(unsigned int)) {
+        return __builtin_ctz(static_cast<unsigned int>(x));
+    }
+    else if(sizeof(UIntT) <= sizeof(unsigned long)) {
+        return __builtin_ctzl(static_cast<unsigned long>(x));
+    }
+    else {
+        return __builtin_ctzll(static_cast<unsigned long long>(x));
+    }
+#else
+    int n = 0;
+    while(!(x & UIntT(1))) { x >>= 1; ++n; }
+    return n;
+#endif
+}
+
+#ifdef __SIZEOF_INT128__
+inline constexpr int
+count_trailing_zeros(uint128_t x) noexcept
+{
+    const auto lo = static_cast<std::uint64_t>(x);
+    return lo ? count_trailing_zeros(lo)
+              : 64 + count_trailing_zeros(static_cast<std::uint64_t>(x >> 64));
+}
+#endif
+
+
+//-------------------------------------------------------------------
+/// @brief number of significant bits (position of highest set bit + 1)
+inline int
+bit_length(std::uint64_t x) noexcept
+{
+#if defined(__GNUC__)
+    return x ? 64 - __builtin_clzll(x) : 0;
+#else
+    int n = 0;
+    while(x) { x >>= 1; ++n; }
+    return n;
+#endif
+}
+
+#ifdef __SIZEOF_INT128__
+inline int
+bit_length(uint128_t x) noexcept
+{
+    const auto hi = static_cast<std::uint64_t>(x >> 64);
+    return hi ? 64 + bit_length(hi)
+              : bit_length(static_cast<std::uint64_t>(x));
+}
+#endif
+
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief binary (Stein) gcd
+ *
+ * Replaces divisions by shifts and subtractions; runs of zero bits are
+ * removed in one step using ctz. The trailing zeros are counted on the
+ * wrapped-around difference (same count as for its absolute value),
+ * which takes ctz off the critical path of the loop.
+ */
+template<class UIntT>
+inline constexpr UIntT
+binary_gcd(UIntT a, UIntT b) noexcept
+{
+    //keeps ctz argument non-zero without changing the result
+    constexpr auto top = UIntT(UIntT(1) << (std::numeric_limits<UIntT>::digits - 1));
+
+    if(a == UIntT(0)) return b;
+    if(b == UIntT(0)) return a;
+
+    int az = count_trailing_zeros(a);
+    const int bz = count_trailing_zeros(b);
+    const int shift = (az < bz) ? az : bz;
+    b = UIntT(b >> bz);
+
+    while(a != UIntT(0)) {
+        a = UIntT(a >> az);
+        const auto diff = UIntT(b - a);
+        az = count_trailing_zeros(UIntT(diff | top));
+        const auto bmin = (a < b) ? a : b;
+        a = (a < b) ? diff : UIntT(a - b);
+        b = bmin;
+    }
+
+    return UIntT(b << shift);
+}
+
+
+#ifdef __SIZEOF_INT128__
+//-------------------------------------------------------------------
+/**
+ * @brief Lehmer gcd (Knuth, TAOCP Vol. 2, Algorithm L) for 128-bit integers
+ *
+ * Simulates runs of Euclidean steps on the leading 62 bits using
+ * 64-bit arithmetic only and applies the accumulated cofactors
+ * to the full-width numbers in one go.
+ * Switches to the binary gcd as soon as both values fit into 64 bits.
+ */
+inline uint128_t
+lehmer_gcd(uint128_t a, uint128_t b) noexcept
+{
+    using u128 = uint128_t;
+
+    if(a < b) std::swap(a, b);
+
+    while((b >> 64) != 0) {
+        const int shift = bit_length(a) - 62;
+        auto ah = static_cast<std::int64_t>(a >> shift);
+        auto bh = static_cast<std::int64_t>(b >> shift);
+
+        std::int64_t A = 1, B = 0, C = 0, D = 1;
+        while((bh + C) != 0 && (bh + D) != 0) {
+            const auto q = (ah + A) / (bh + C);
+            if(q != (ah + B) / (bh + D)) break;
+            auto t = A - q * C; A = C; C = t;
+            t = B - q * D; B = D; D = t;
+            t = ah - q * bh; ah = bh; bh = t;
+        }
+
+        if(B == 0) {
+            //no progress on leading digits: one full-width step
+            const u128 t = a % b;
+            a = b;
+            b = t;
+        } else {
+            //results are non-negative and smaller than a,
+            //so wrap-around arithmetic yields the exact values
+            const u128 t = u128(A) * a + u128(B) * b;
+            const u128 w = u128(C) * a + u128(D) * b;
+            a = t;
+            b = w;
+        }
+    }
+
+    if(b == 0) return a;
+    //a might still be wider than 64 bits
+    a %= b;
+    return u128(binary_gcd(static_cast<std::uint64_t>(b),
+                           static_cast<std::uint64_t>(a)));
+}
+#endif
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline constexpr std::make_unsigned_t<T>
+unsigned_abs(const T& x) noexcept
+{
+    using u_t = std::make_unsigned_t<T>;
+    return (x < T(0)) ? u_t(u_t(0) - u_t(x)) : u_t(x);
+}
+
+}  // namespace detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief greatest common divisor (always non-negative)
+ *
+ *****************************************************************************/
+template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
+inline constexpr T
+gcd(const T& a, const T& b) noexcept
+{
+    return T(detail::binary_gcd(detail::unsigned_abs(a),
+                                detail::unsigned_abs(b)));
+}
+
+#ifdef __SIZEOF_INT128__
+//---------------------------------------------------------
+inline detail::uint128_t
+gcd(const detail::uint128_t& a, const detail::uint128_t& b) noexcept
+{
+    return detail::lehmer_gcd(a, b);
+}
+
+//---------------------------------------------------------
+inline detail::int128_t
+gcd(const detail::int128_t& a, const detail::int128_t& b) noexcept
+{
+    using u128 = detail::uint128_t;
+    const auto ua = (a < 0) ? u128(0) - u128(a) : u128(a);
+    const auto ub = (b < 0) ? u128(0) - u128(b) : u128(b);
+    return static_cast<detail::int128_t>(detail::lehmer_gcd(ua, ub));
+}
+#endif
+
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief least common multiple (always non-negative)
+ *        0 if one of the arguments is 0
+ */
+template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
+inline constexpr T
+lcm(const T& a, const T& b) noexcept
+{
+    if(a == T(0) || b == T(0)) return T(0);
+    const auto ua = detail::unsigned_abs(a);
+    const auto ub = detail::unsigned_abs(b);
+    return T((ua / detail::binary_gcd(ua, ub)) * ub);
+}
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,1053 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_JET_H_
+#define AM_NUMERIC_JET_H_
+
+#include <cmath>
+#include <array>
+#include <cstddef>
+
+#include "constants.h"
+#include "traits.h"
+#include "limits.h"
+#include "equality.h"
+#include "dual.h"
+#include "sincos.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class,std::size_t> class jet;
+
+template<class>
+struct is_jet :
+    std::false_type
+{};
+
+template<class T, std::size_t K>
+struct is_jet<jet<T,K>> :
+    std::true_type
+{};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief
+ * truncated Taylor series a0 + a1*t + a2*t^2 + ... + a(K-1)*t^(K-1)
+ * where a_k = f^(k)(x) / k!
+ *
+ * jet<T,2> has the same semantics as dual<T>
+ *
+ *****************************************************************************/
+template<class NumberType, std::size_t K>
+class jet
+{
+    static_assert(K > 0, "jet<T,K>: K must be at least 1");
+
+public:
+
+    static_assert(is_number<NumberType>::value,
+        "jet<T,K>: T must be a number type");
+
+    static_assert(!is_jet<NumberType>::value,
+        "jet<T,K>: T must not be a jet<> type itself");
+
+    static_assert(!is_dual<NumberType>::value,
+        "jet<T,K>: T must not be a dual<> type");
+
+
+    //---------------------------------------------------------------
+    using value_type      = NumberType;
+    using numeric_type    = value_type;
+    using size_type       = std::size_t;
+
+
+    //---------------------------------------------------------------
+    /// @brief default constructor
+    constexpr
+    jet() = default;
+
+    /// @brief constant (all higher order coefficients are zero)
+    explicit
+    jet(const value_type& a):
+        c_{}
+    {
+        c_[0] = a;
+    }
+
+    /// @brief value and first order coefficient
+    jet(const value_type& a, const value_type& da):
+        c_{}
+    {
+        c_[0] = a;
+        if(K > 1) c_[1] = da;
+    }
+
+    /// @brief from dual number (value and first derivative)
+    jet(const dual<value_type>& d):
+        jet(d.real(), d.imag())
+    {}
+
+    /// @brief conversion from jet with different value type
+    template<class T>
+    explicit
+    jet(const jet<T,K>& o):
+        c_{}
+    {
+        for(size_type i = 0; i < K; ++i) c_[i] = value_type(o[i]);
+    }
+
+
+    //---------------------------------------------------------------
+    jet&
+    operator = (const value_type& a)
+    {
+        c_.fill(value_type(0));
+        c_[0] = a;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    static constexpr size_type
+    size() noexcept {
+        return K;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief k-th Taylor coefficient
+    constexpr const value_type&
+    operator [] (size_type k) const noexcept {
+        return c_[k];
+    }
+
+    value_type&
+    operator [] (size_type k) noexcept {
+        return c_[k];
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief function value
+    constexpr const value_type&
+    real() const noexcept {
+        return c_[0];
+    }
+
+    /// @brief first derivative
+    constexpr value_type
+    imag() const noexcept {
+        return K > 1 ? c_[1] : value_type(0);
+    }
+
+    /// @brief k-th derivative (k! * k-th coefficient)
+    value_type
+    derivative(size_type k) const noexcept {
+        auto d = c_[k];
+        for(size_type i = 2; i <= k; ++i) d *= value_type(i);
+        return d;
+    }
+
+
+    //---------------------------------------------------------------
+    jet&
+    negate() noexcept {
+        for(auto& x : c_) x = -x;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // jet (op)= number
+    //---------------------------------------------------------------
+    jet&
+    operator += (const value_type& v) {
+        c_[0] += v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    jet&
+    operator -= (const value_type& v) {
+        c_[0] -= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    jet&
+    operator *= (const value_type& v) {
+        for(auto& x : c_) x *= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    jet&
+    operator /= (const value_type& v) {
+        for(auto& x : c_) x /= v;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // jet (op)= jet
+    //---------------------------------------------------------------
+    jet&
+    operator += (const jet& o) {
+        for(size_type i = 0; i < K; ++i) c_[i] += o[i];
+        return *this;
+    }
+    //-----------------------------------------------------
+    jet&
+    operator -= (const jet& o) {
+        for(size_type i = 0; i < K; ++i) c_[i] -= o[i];
+        return *this;
+    }
+    //-----------------------------------------------------
+    /// @brief truncated Cauchy product
+    jet&
+    operator *= (const jet& o)
+    {
+        //descending k: c_[k] only depends on c_[0..k]
+        for(size_type k = K; k-- > 0; ) {
+            auto s = c_[k] * o[0];
+            for(size_type j = 0; j < k; ++j) s += c_[j] * o[k-j];
+            c_[k] = s;
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    jet&
+    operator /= (const jet& o)
+    {
+        for(size_type k = 0; k < K; ++k) {
+            auto s = c_[k];
+            for(size_type j = 0; j < k; ++j) s -= c_[j] * o[k-j];
+            c_[k] = s / o[0];
+        }
+        return *this;
+    }
+
+
+private:
+
+    //---------------------------------------------------------------
+    std::array<value_type,K> c_;
+
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+/// @brief independent variable at x with derivative seed dx
+template<std::size_t K, class T, class = std::enable_if_t<
+    !is_jet<T>::value && !is_dual<T>::value && is_number<T>::value>>
+inline auto
+make_jet(const T& x, const T& dx = T(1))
+{
+    return jet<T,K>{x, dx};
+}
+
+//---------------------------------------------------------
+template<std::size_t K, class T>
+inline auto
+make_jet(const dual<T>& x)
+{
+    return jet<T,K>{x};
+}
+
+//---------------------------------------------------------
+/// @brief value and first derivative of a jet
+template<class T, std::size_t K>
+inline auto
+make_dual(const jet<T,K>& x)
+{
+    return dual<T>{x.real(), x.imag()};
+}
+
+
+
+//-------------------------------------------------------------------
+// I/O
+//-------------------------------------------------------------------
+template<class Ostream, class T, std::size_t K>
+inline Ostream&
+operator << (Ostream& os, const jet<T,K>& x)
+{
+    os << x[0];
+    for(std::size_t i = 1; i < K; ++i) os << " " << x[i];
+    return os;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K, class Ostream>
+inline Ostream&
+print(Ostream& os, const jet<T,K>& x)
+{
+    os << "(" << x[0];
+    for(std::size_t i = 1; i < K; ++i) os << "," << x[i];
+    return (os << ")");
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * ACCESS
+ *
+ *****************************************************************************/
+template<class T, std::size_t K>
+inline constexpr decltype(auto)
+real(const jet<T,K>& x) noexcept
+{
+    return x.real();
+}
+
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline constexpr decltype(auto)
+imag(const jet<T,K>& x) noexcept
+{
+    return x.imag();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * COMPARISON
+ *
+ *****************************************************************************/
+template<class T1, class T2, std::size_t K>
+inline bool
+operator == (const jet<T1,K>& a, const jet<T2,K>& b)
+{
+    for(std::size_t i = 0; i < K; ++i) {
+        if(a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+template<class T1, class T2, std::size_t K>
+inline bool
+operator != (const jet<T1,K>& a, const jet<T2,K>& b)
+{
+    return !(a == b);
+}
+
+
+//-------------------------------------------------------------------
+template<class T1, class T2, std::size_t K,
+         class T3 = common_numeric_t<T1,T2>>
+inline bool
+approx_equal(const jet<T1,K>& a, const jet<T2,K>& b,
+    const T3& tol = tolerance<T3>)
+{
+    for(std::size_t i = 0; i < K; ++i) {
+        if(!approx_equal(a[i], b[i], tol)) return false;
+    }
+    return true;
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * ARITHMETIC
+ *
+ *****************************************************************************/
+template<class T, std::size_t K>
+inline auto
+operator + (jet<T,K> x, const jet<T,K>& y)
+{
+    return x += y;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline auto
+operator + (const jet<T,K>& x, const T2& y)
+{
+    using R = common_numeric_t<T,T2>;
+    return jet<R,K>{x} += R(y);
+}
+//---------------------------------------------------------
+template<class T, std::size_t K, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline auto
+operator + (const T2& y, const jet<T,K>& x)
+{
+    return x + y;
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+operator - (jet<T,K> x, const jet<T,K>& y)
+{
+    return x -= y;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline auto
+operator - (const jet<T,K>& x, const T2& y)
+{
+    using R = common_numeric_t<T,T2>;
+    return jet<R,K>{x} -= R(y);
+}
+//---------------------------------------------------------
+template<class T, std::size_t K, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline auto
+operator - (const T2& y, const jet<T,K>& x)
+{
+    using R = common_numeric_t<T,T2>;
+    return (jet<R,K>{x}.negate() += R(y));
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+operator * (jet<T,K> x, const jet<T,K>& y)
+{
+    return x *= y;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline auto
+operator * (const jet<T,K>& x, const T2& y)
+{
+    using R = common_numeric_t<T,T2>;
+    return jet<R,K>{x} *= R(y);
+}
+//---------------------------------------------------------
+template<class T, std::size_t K, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline auto
+operator * (const T2& y, const jet<T,K>& x)
+{
+    return x * y;
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+operator / (jet<T,K> x, const jet<T,K>& y)
+{
+    return x /= y;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline auto
+operator / (const jet<T,K>& x, const T2& y)
+{
+    using R = common_numeric_t<T,T2>;
+    return jet<R,K>{x} /= R(y);
+}
+//---------------------------------------------------------
+template<class T, std::size_t K, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline auto
+operator / (const T2& y, const jet<T,K>& x)
+{
+    using R = common_numeric_t<T,T2>;
+    return jet<R,K>{R(y)} /= jet<R,K>{x};
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+operator - (jet<T,K> x)
+{
+    return x.negate();
+}
+
+
+
+
+/*************************************************************************//***
+ *
+ *
+ * FUNCTIONS
+ *
+ * @note all functions use the usual Taylor coefficient recurrences
+ *       that follow from f' = g * x' and run in O(K^2)
+ *
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief sets b[1..K-1] so that b' = h * a'; b[0] must already be set
+template<class T, std::size_t K>
+inline void
+jet_integrate(const jet<T,K>& a, const jet<T,K>& h, jet<T,K>& b)
+{
+    for(std::size_t k = 1; k < K; ++k) {
+        T s = T(0);
+        for(std::size_t j = 1; j <= k; ++j) s += T(j) * a[j] * h[k-j];
+        b[k] = s / T(k);
+    }
+}
+
+//---------------------------------------------------------
+/// @brief sets b[1..K-1] so that b' = a' / q; b[0] must already be set
+template<class T, std::size_t K>
+inline void
+jet_integrate_quotient(const jet<T,K>& a, const jet<T,K>& q, jet<T,K>& b)
+{
+    for(std::size_t k = 1; k < K; ++k) {
+        T s = T(k) * a[k];
+        for(std::size_t j = 1; j < k; ++j) s -= T(j) * b[j] * q[k-j];
+        b[k] = s / (T(k) * q[0]);
+    }
+}
+
+//---------------------------------------------------------
+/// @brief sine and cosine series computed together
+template<class T, std::size_t K>
+inline void
+jet_sin_cos(const jet<T,K>& a, jet<T,K>& s, jet<T,K>& c)
+{
+    sin_cos(a[0], s[0], c[0]);
+
+    for(std::size_t k = 1; k < K; ++k) {
+        T ss = T(0);
+        T cs = T(0);
+        for(std::size_t j = 1; j <= k; ++j) {
+            const auto ja = T(j) * a[j];
+            ss += ja * c[k-j];
+            cs += ja * s[k-j];
+        }
+        s[k] =  ss / T(k);
+        c[k] = -cs / T(k);
+    }
+}
+
+//---------------------------------------------------------
+/// @brief hyperbolic sine and cosine series computed together
+template<class T, std::size_t K>
+inline void
+jet_sinh_cosh(const jet<T,K>& a, jet<T,K>& s, jet<T,K>& c)
+{
+    sinh_cosh(a[0], s[0], c[0]);
+
+    for(std::size_t k = 1; k < K; ++k) {
+        T ss = T(0);
+        T cs = T(0);
+        for(std::size_t j = 1; j <= k; ++j) {
+            const auto ja = T(j) * a[j];
+            ss += ja * c[k-j];
+            cs += ja * s[k-j];
+        }
+        s[k] = ss / T(k);
+        c[k] = cs / T(k);
+    }
+}
+
+//---------------------------------------------------------
+/// @brief b = tan(a) (sign = 1) or b = tanh(a) (sign = -1);
+///        uses b' = (1 + sign * b^2) * a'
+template<class T, std::size_t K>
+inline void
+jet_tan(const jet<T,K>& a, jet<T,K>& b, const T& sign)
+{
+    //d = 1 + sign * b^2, built up alongside b
+    jet<T,K> d;
+    d[0] = T(1) + sign * b[0] * b[0];
+
+    for(std::size_t k = 1; k < K; ++k) {
+        T s = T(0);
+        for(std::size_t j = 1; j <= k; ++j) s += T(j) * a[j] * d[k-j];
+        b[k] = s / T(k);
+
+        T bb = T(0);
+        for(std::size_t j = 0; j <= k; ++j) bb += b[j] * b[k-j];
+        d[k] = sign * bb;
+    }
+}
+
+//---------------------------------------------------------
+/// @brief higher coefficients of b = a^r given b[0] = a[0]^r
+///        from a * b' = r * a' * b
+template<class T, std::size_t K>
+inline void
+jet_pow_series(const jet<T,K>& a, const T& r, jet<T,K>& b)
+{
+    for(std::size_t k = 1; k < K; ++k) {
+        T s = T(0);
+        for(std::size_t j = 1; j <= k; ++j) {
+            s += ((r * T(j)) - T(k-j)) * a[j] * b[k-j];
+        }
+        b[k] = s / (T(k) * a[0]);
+    }
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+// ROOTS
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+sqrt(const jet<T,K>& a)
+{
+    using std::sqrt;
+    jet<T,K> b;
+    b[0] = sqrt(a[0]);
+    const auto b0x2 = T(2) * b[0];
+
+    for(std::size_t k = 1; k < K; ++k) {
+        T s = a[k];
+        for(std::size_t j = 1; j < k; ++j) s -= b[j] * b[k-j];
+        b[k] = s / b0x2;
+    }
+    return b;
+}
+
+//---------------------------------------------------------
+/// @brief power with constant exponent
+template<class T, std::size_t K>
+inline auto
+pow(const jet<T,K>& a, const T& r)
+{
+    using std::pow;
+    jet<T,K> b;
+    b[0] = pow(a[0], r);
+    detail::jet_pow_series(a, r, b);
+    return b;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+cbrt(const jet<T,K>& a)
+{
+    using std::cbrt;
+    jet<T,K> b;
+    //real cube root, so that negative arguments work
+    b[0] = cbrt(a[0]);
+    detail::jet_pow_series(a, T(1)/T(3), b);
+    return b;
+}
+
+
+
+//-------------------------------------------------------------------
+// EXPONENTIATION
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+exp(const jet<T,K>& a)
+{
+    using std::exp;
+    jet<T,K> b;
+    b[0] = exp(a[0]);
+    //b' = b * a' with b[k] only depending on b[0..k-1]
+    detail::jet_integrate(a, b, b);
+    return b;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+exp2(const jet<T,K>& a)
+{
+    return exp(a * T(0.69314718055994530941723212145817656807550013436026));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+expm1(const jet<T,K>& a)
+{
+    using std::expm1;
+    auto b = exp(a);
+    b[0] = expm1(a[0]);
+    return b;
+}
+
+//---------------------------------------------------------
+/// @brief power with jet exponent
+template<class T, std::size_t K>
+inline auto
+pow(const jet<T,K>& b, const jet<T,K>& e)
+{
+    return exp(e * log(b));
+}
+
+
+
+//-------------------------------------------------------------------
+// LOGARITHMS
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+log(const jet<T,K>& a)
+{
+    using std::log;
+    jet<T,K> b;
+    b[0] = log(a[0]);
+    detail::jet_integrate_quotient(a, a, b);
+    return b;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+log10(const jet<T,K>& a)
+{
+    using std::log10;
+    auto b = log(a) *
+        (T(1) / T(2.3025850929940456840179914546843642076011014886288));
+    b[0] = log10(a[0]);
+    return b;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+log2(const jet<T,K>& a)
+{
+    using std::log2;
+    auto b = log(a) *
+        (T(1) / T(0.69314718055994530941723212145817656807550013436026));
+    b[0] = log2(a[0]);
+    return b;
+}
+
+//---------------------------------------------------------
+/// @brief logarithm of 1 + x
+template<class T, std::size_t K>
+inline auto
+log1p(const jet<T,K>& a)
+{
+    using std::log1p;
+    jet<T,K> b;
+    b[0] = log1p(a[0]);
+    detail::jet_integrate_quotient(a, a + T(1), b);
+    return b;
+}
+
+
+
+//-------------------------------------------------------------------
+// TRIGONOMETRIC
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+sin(const jet<T,K>& a)
+{
+    jet<T,K> s, c;
+    detail::jet_sin_cos(a, s, c);
+    return s;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+cos(const jet<T,K>& a)
+{
+    jet<T,K> s, c;
+    detail::jet_sin_cos(a, s, c);
+    return c;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline void
+sincos(const jet<T,K>& a, jet<T,K>& s, jet<T,K>& c)
+{
+    detail::jet_sin_cos(a, s, c);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+tan(const jet<T,K>& a)
+{
+    using std::tan;
+    jet<T,K> b;
+    b[0] = tan(a[0]);
+    detail::jet_tan(a, b, T(1));
+    return b;
+}
+
+
+
+//-------------------------------------------------------------------
+// INVERSE TRIGONOMETRIC
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+asin(const jet<T,K>& a)
+{
+    using std::asin;
+    jet<T,K> b;
+    b[0] = asin(a[0]);
+    detail::jet_integrate_quotient(a, sqrt(T(1) - (a * a)), b);
+    return b;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+acos(const jet<T,K>& a)
+{
+    using std::acos;
+    auto b = -asin(a);
+    b[0] = acos(a[0]);
+    return b;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+atan(const jet<T,K>& a)
+{
+    using std::atan;
+    jet<T,K> b;
+    b[0] = atan(a[0]);
+    detail::jet_integrate_quotient(a, T(1) + (a * a), b);
+    return b;
+}
+
+
+
+//-------------------------------------------------------------------
+// HYPERBOLIC
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+sinh(const jet<T,K>& a)
+{
+    jet<T,K> s, c;
+    detail::jet_sinh_cosh(a, s, c);
+    return s;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+cosh(const jet<T,K>& a)
+{
+    jet<T,K> s, c;
+    detail::jet_sinh_cosh(a, s, c);
+    return c;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline void
+sinhcosh(const jet<T,K>& a, jet<T,K>& s, jet<T,K>& c)
+{
+    detail::jet_sinh_cosh(a, s, c);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+tanh(const jet<T,K>& a)
+{
+    using std::tanh;
+    jet<T,K> b;
+    b[0] = tanh(a[0]);
+    detail::jet_tan(a, b, T(-1));
+    return b;
+}
+
+
+
+//-------------------------------------------------------------------
+// INVERSE HYPERBOLIC
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+asinh(const jet<T,K>& a)
+{
+    using std::asinh;
+    jet<T,K> b;
+    b[0] = asinh(a[0]);
+    detail::jet_integrate_quotient(a, sqrt((a * a) + T(1)), b);
+    return b;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+acosh(const jet<T,K>& a)
+{
+    using std::acosh;
+    jet<T,K> b;
+    b[0] = acosh(a[0]);
+    detail::jet_integrate_quotient(a, sqrt((a * a) - T(1)), b);
+    return b;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline auto
+atanh(const jet<T,K>& a)
+{
+    using std::atanh;
+    jet<T,K> b;
+    b[0] = atanh(a[0]);
+    detail::jet_integrate_quotient(a, T(1) - (a * a), b);
+    return b;
+}
+
+
+
+//-------------------------------------------------------------------
+//
+//-------------------------------------------------------------------
+///@brief  error function
+template<class T, std::size_t K>
+inline auto
+erf(const jet<T,K>& a)
+{
+    using std::erf;
+    jet<T,K> b;
+    b[0] = erf(a[0]);
+    detail::jet_integrate(a,
+        exp(-(a * a)) * T(1.1283791670955125738961589031215451716881012586580),
+        b);
+    return b;
+}
+
+//---------------------------------------------------------
+///@brief complementary error function
+template<class T, std::size_t K>
+inline auto
+erfc(const jet<T,K>& a)
+{
+    using std::erfc;
+    auto b = -erf(a);
+    b[0] = erfc(a[0]);
+    return b;
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+inline bool
+isfinite(const jet<T,K>& x)
+{
+    using std::isfinite;
+    for(std::size_t i = 0; i < K; ++i) {
+        if(!isfinite(x[i])) return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t K>
+inline bool
+isnan(const jet<T,K>& x)
+{
+    using std::isnan;
+    for(std::size_t i = 0; i < K; ++i) {
+        if(isnan(x[i])) return true;
+    }
+    return false;
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * TRAITS SPECIALIZATIONS
+ *
+ *****************************************************************************/
+template<class T, std::size_t K>
+struct is_number<jet<T,K>> : std::true_type {};
+
+template<class T, std::size_t K>
+struct is_number<jet<T,K>&> : std::true_type {};
+
+template<class T, std::size_t K>
+struct is_number<jet<T,K>&&> : std::true_type {};
+
+template<class T, std::size_t K>
+struct is_number<const jet<T,K>&> : std::true_type {};
+
+template<class T, std::size_t K>
+struct is_number<const jet<T,K>> : std::true_type {};
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t K>
+struct is_floating_point<jet<T,K>> :
+    std::integral_constant<bool, is_floating_point<T>::value>
+{};
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t K, class T2>
+struct common_numeric_type<jet<T,K>,T2>
+{
+    using type = jet<common_numeric_t<T,T2>,K>;
+};
+//---------------------------------------------------------
+template<class T, std::size_t K, class T2>
+struct common_numeric_type<T2,jet<T,K>>
+{
+    using type = jet<common_numeric_t<T,T2>,K>;
+};
+//---------------------------------------------------------
+template<class T1, class T2, std::size_t K>
+struct common_numeric_type<jet<T1,K>,jet<T2,K>>
+{
+    using type = jet<common_numeric_t<T1,T2>,K>;
+};
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
@@ -19,6 +19,7 @@
 
 #include "limits.h"
 #include "conversion.h"
+#include "overflow.h"
 
 
 namespace am {
@@ -149,38 +150,32 @@ public:
     }
 
 
+    //---------------------------------------------------------------
+    // The arithmetic operators below are written as straight-line code:
+    // the result is computed with the overflow builtins and then
+    // saturated / replaced by infinity (negative internal value)
+    // with selects that compile to conditional moves instead of
+    // (data-dependent, badly predictable) branches.
     //---------------------------------------------------------------
     natural&
     operator += (const natural& c) noexcept
     {
-        if(!isinf(*this)) {
-            if(isinf(c)) {
-                *this = infinity();
-            } else {
-                if((max_val() - v_) < c.v_) {
-                    v_ = max_val();
-                } else {
-                    v_ += c.v_;
-                }
-            }
-        }
+        //sum of two finite values wraps around to a negative number
+        value_type r;
+        detail::add_overflow(v_, c.v_, r);
+        r = (r < zero_val()) ? max_val() : r;
+        v_ = ((v_ | c.v_) < zero_val()) ? infty_val() : r;
         return *this;
     }
 
     natural&
     operator += (const value_type& v) noexcept
     {
-        if(!isinf(*this)) {
-            if(v > max_val()) {
-                *this = infinity();
-            } else {
-                if((max_val() - v_) < v) {
-                    v_ = max_val();
-                } else {
-                    v_ += v;
-                }
-            }
-        }
+        value_type r;
+        const bool o = detail::add_overflow(v_, v, r);
+        r = select(o, max_val(), r);
+        r = (r < zero_val()) ? zero_val() : r;
+        v_ = (v_ < zero_val()) ? infty_val() : r;
         return *this;
     }
 
@@ -189,69 +184,49 @@ public:
     natural&
     operator -= (const natural& c) noexcept
     {
-        if(isinf(*this)) {
-            if(isinf(c))
-                v_ = zero_val();
-        }
-        else {
-            if(!isinf(c) && (v_ > c.v_))
-                v_ -= c.v_;
-            else
-                v_ = zero_val();
-        }
+        //the wrapped-around result only matters for finite operands
+        value_type r;
+        detail::sub_overflow(v_, c.v_, r);
+        const auto fin = ((r | c.v_) < zero_val()) ? zero_val() : r;
+        const auto inf = (c.v_ < zero_val()) ? zero_val() : infty_val();
+        v_ = (v_ < zero_val()) ? inf : fin;
         return *this;
     }
 
     natural&
     operator -= (const value_type& v) noexcept
     {
-        if(!isinf(*this)) {
-            if(v_ > v) {
-                v_ -= v;
-            } else {
-                v_ = zero_val();
-            }
-        }
+        value_type r;
+        const bool o = detail::sub_overflow(v_, v, r);
+        r = select(o, max_val(), r);
+        r = (r < zero_val()) ? zero_val() : r;
+        v_ = (v_ < zero_val()) ? infty_val() : r;
         return *this;
     }
 
 
     //---------------------------------------------------------------
+    /// @brief 0 * infinity = 0
     natural&
     operator *= (const natural& c) noexcept
     {
-        if(!isinf(*this)) {
-            if(isinf(c) || (c.v_ > max_val())) {
-                *this = infinity();
-            } else {
-                if(c.v_ > (max_val() / v_)) {
-                    v_ = max_val();
-                } else {
-                    v_ *= c.v_;
-                }
-            }
-        }
+        value_type r;
+        const bool o = detail::mul_overflow(v_, c.v_, r);
+        r = select(o, max_val(), r);
+        r = ((v_ | c.v_) < zero_val()) ? infty_val() : r;
+        v_ = (v_ == zero_val() || c.v_ == zero_val()) ? zero_val() : r;
         return *this;
     }
 
+    /// @brief multiplication with non-positive values yields 0
     natural&
     operator *= (const value_type& v) noexcept
     {
-        if(!isinf(*this)) {
-            if(v > zero_val()) {
-                if(v <= max_val()) {
-                    if(v > (max_val() / v_)) {
-                        v_ = max_val();
-                    } else {
-                        v_ *= v;
-                    }
-                } else {
-                    v_ = max_val();
-                }
-            } else {
-                v_ = zero_val();
-            }
-        }
+        value_type r;
+        const bool o = detail::mul_overflow(v_, v, r);
+        r = select(o, max_val(), r);
+        r = (v_ < zero_val()) ? infty_val() : r;
+        v_ = (v_ == zero_val() || v <= zero_val()) ? zero_val() : r;
         return *this;
     }
 
@@ -281,7 +256,7 @@ public:
     natural
     operator -- (int) noexcept {
         auto old = *this;
-        ++*this;
+        --*this;
         return old;
     }
 
@@ -301,6 +276,16 @@ private:
         return std::numeric_limits<value_type>::max();
     }
 
+    //---------------------------------------------------------------
+    /// @brief c ? a : b; mask-based, so that compilers don't turn
+    ///        overflow flags into (badly predictable) branches
+    static constexpr value_type
+    select(bool c, value_type a, value_type b) noexcept {
+        using u_t = std::make_unsigned_t<value_type>;
+        return value_type((u_t(a) & u_t(u_t(0) - u_t(c))) |
+                          (u_t(b) & u_t(u_t(c) - u_t(1))));
+    }
+
 
     //---------------------------------------------------------------
     /// @brief special ctor for infinity initialization
@@ -0,0 +1,379 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_NATURAL_ARRAY_H_
+#define AM_NUMERIC_NATURAL_ARRAY_H_
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <limits>
+#include <type_traits>
+#include <initializer_list>
+
+#include "natural.h"
+#include "overflow.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief
+ * sequence of natural numbers stored as raw builtin integers
+ *
+ * Encoding: values in [0,max] are finite, negative values are infinity
+ * (same as in natural<T>).
+ *
+ * The bulk kernels below are plain loops over contiguous arrays of
+ * builtin integers that use compare & select sequences instead of
+ * branches so that they can be vectorized by the compiler.
+ * Results are identical to the corresponding natural<T> operators.
+ *
+ *****************************************************************************/
+template<class IntT>
+class natural_array
+{
+public:
+
+    static_assert(std::is_integral<IntT>::value && std::is_signed<IntT>::value,
+        "natural_array<T>: T must be a builtin signed integer type");
+
+
+    //---------------------------------------------------------------
+    using value_type      = natural<IntT>;
+    using numeric_type    = IntT;
+    using size_type       = std::size_t;
+
+
+    //---------------------------------------------------------------
+    natural_array() = default;
+
+    explicit
+    natural_array(size_type n):
+        v_(n, numeric_type(0))
+    {}
+
+    natural_array(size_type n, const value_type& x):
+        v_(n, encode(x))
+    {}
+
+    natural_array(std::initializer_list<value_type> il):
+        v_()
+    {
+        reserve(il.size());
+        for(const auto& x : il) push_back(x);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        return v_.size();
+    }
+
+    bool
+    empty() const noexcept {
+        return v_.empty();
+    }
+
+    void
+    resize(size_type n) {
+        v_.resize(n, numeric_type(0));
+    }
+
+    void
+    reserve(size_type n) {
+        v_.reserve(n);
+    }
+
+    void
+    clear() noexcept {
+        v_.clear();
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator [] (size_type i) const noexcept {
+        return decode(v_[i]);
+    }
+
+    void
+    set(size_type i, const value_type& x) noexcept {
+        v_[i] = encode(x);
+    }
+
+    void
+    push_back(const value_type& x) {
+        v_.push_back(encode(x));
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief raw values; negative values represent infinity
+    const numeric_type*
+    data() const noexcept {
+        return v_.data();
+    }
+
+    numeric_type*
+    data() noexcept {
+        return v_.data();
+    }
+
+
+    //---------------------------------------------------------------
+    static numeric_type
+    encode(const value_type& x) noexcept {
+        return isinf(x) ? numeric_type(-1) : x.value();
+    }
+
+    static value_type
+    decode(numeric_type x) noexcept {
+        return (x < numeric_type(0)) ? value_type::infinity() : value_type{x};
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    std::vector<numeric_type> v_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * ELEMENT KERNELS
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+template<class T>
+inline T
+natural_add(T x, T y) noexcept
+{
+    using u_t = std::make_unsigned_t<T>;
+    //sum of two finite values wraps around to a negative number
+    const auto s = T(u_t(x) + u_t(y));
+    const auto r = (s < T(0)) ? std::numeric_limits<T>::max() : s;
+    return (T(x | y) < T(0)) ? T(-1) : r;
+}
+
+//---------------------------------------------------------
+template<class T>
+inline T
+natural_sub(T x, T y) noexcept
+{
+    using u_t = std::make_unsigned_t<T>;
+    const auto d = T(u_t(x) - u_t(y));
+    const auto fin = (T(d | y) < T(0)) ? T(0) : d;
+    const auto inf = (y < T(0)) ? T(0) : T(-1);
+    return (x < T(0)) ? inf : fin;
+}
+
+//---------------------------------------------------------
+template<class T>
+inline T
+natural_mul(T x, T y, std::true_type /* has wider type */) noexcept
+{
+    using w_t = wider_integer_t<T>;
+    constexpr auto m = std::numeric_limits<T>::max();
+    const auto p = w_t(w_t(x) * w_t(y));
+    const auto s = (p > w_t(m)) ? m : T(p);
+    const auto r = (T(x | y) < T(0)) ? T(-1) : s;
+    return (x == T(0) || y == T(0)) ? T(0) : r;
+}
+
+template<class T>
+inline T
+natural_mul(T x, T y, std::false_type) noexcept
+{
+    auto r = natural_array<T>::decode(x);
+    r *= natural_array<T>::decode(y);
+    return natural_array<T>::encode(r);
+}
+
+template<class T>
+inline T
+natural_mul(T x, T y) noexcept
+{
+    //128 bit multiplications don't vectorize
+    return natural_mul(x, y, std::integral_constant<bool, (sizeof(T) <= 4)>{});
+}
+
+
+//-------------------------------------------------------------------
+// infinity (negative) is larger than any finite value:
+// compare as unsigned integers
+template<class T>
+inline T
+natural_min(T x, T y) noexcept
+{
+    using u_t = std::make_unsigned_t<T>;
+    return (u_t(y) < u_t(x)) ? y : x;
+}
+
+template<class T>
+inline T
+natural_max(T x, T y) noexcept
+{
+    using u_t = std::make_unsigned_t<T>;
+    return (u_t(y) > u_t(x)) ? y : x;
+}
+
+
+//-------------------------------------------------------------------
+template<class T, class BinaryOp>
+inline void
+natural_transform(const natural_array<T>& a, const natural_array<T>& b,
+                  natural_array<T>& out, BinaryOp op)
+{
+    assert(a.size() == b.size());
+    const auto n = a.size();
+    if(out.size() != n) out.resize(n);
+
+    const auto pa = a.data();
+    const auto pb = b.data();
+    auto po = out.data();
+    for(std::size_t k = 0; k < n; ++k) {
+        po[k] = op(pa[k], pb[k]);
+    }
+}
+
+}  // namespace detail
+
+
+
+
+/*****************************************************************************
+ *
+ * BULK KERNELS
+ *
+ * @note output arrays are resized if necessary and may be identical
+ *       to one of the inputs
+ *
+ *****************************************************************************/
+template<class T>
+inline void
+add_saturate(const natural_array<T>& a, const natural_array<T>& b,
+             natural_array<T>& out)
+{
+    detail::natural_transform(a, b, out,
+        [](T x, T y) { return detail::natural_add(x, y); });
+}
+
+//---------------------------------------------------------
+template<class T>
+inline void
+sub_saturate(const natural_array<T>& a, const natural_array<T>& b,
+             natural_array<T>& out)
+{
+    detail::natural_transform(a, b, out,
+        [](T x, T y) { return detail::natural_sub(x, y); });
+}
+
+//---------------------------------------------------------
+template<class T>
+inline void
+mul_saturate(const natural_array<T>& a, const natural_array<T>& b,
+             natural_array<T>& out)
+{
+    detail::natural_transform(a, b, out,
+        [](T x, T y) { return detail::natural_mul(x, y); });
+}
+
+//---------------------------------------------------------
+/// @brief elementwise minimum
+template<class T>
+inline void
+min(const natural_array<T>& a, const natural_array<T>& b,
+    natural_array<T>& out)
+{
+    detail::natural_transform(a, b, out,
+        [](T x, T y) { return detail::natural_min(x, y); });
+}
+
+//---------------------------------------------------------
+/// @brief elementwise maximum
+template<class T>
+inline void
+max(const natural_array<T>& a, const natural_array<T>& b,
+    natural_array<T>& out)
+{
+    detail::natural_transform(a, b, out,
+        [](T x, T y) { return detail::natural_max(x, y); });
+}
+
+
+
+//-------------------------------------------------------------------
+namespace detail {
+
+template<class T>
+inline T
+natural_sum(const T* p, std::size_t n, std::true_type /* <= 32 bit */)
+{
+    constexpr auto m = std::numeric_limits<T>::max();
+    //int64 accumulator can't overflow for 2^31 elements
+    constexpr std::size_t block = std::size_t(1) << 31;
+
+    T any = T(0);
+    T s = T(0);
+    for(std::size_t b = 0; b < n; b += block) {
+        const auto e = (n - b < block) ? n : b + block;
+        std::int64_t acc = 0;
+        for(std::size_t k = b; k < e; ++k) {
+            any = T(any | p[k]);
+            acc += (p[k] < T(0)) ? T(0) : p[k];
+        }
+        s = natural_add(s, (acc > std::int64_t(m)) ? m : T(acc));
+    }
+    return (any < T(0)) ? T(-1) : s;
+}
+
+template<class T>
+inline T
+natural_sum(const T* p, std::size_t n, std::false_type)
+{
+    T s = T(0);
+    for(std::size_t k = 0; k < n; ++k) {
+        s = natural_add(s, p[k]);
+    }
+    return s;
+}
+
+}  // namespace detail
+
+
+//---------------------------------------------------------
+/**
+ * @brief saturating sum of all elements;
+ *        infinity if at least one element is infinite
+ */
+template<class T>
+inline natural<T>
+sum(const natural_array<T>& a)
+{
+    return natural_array<T>::decode(detail::natural_sum(a.data(), a.size(),
+        std::integral_constant<bool, (sizeof(T) <= 4)>{}));
+}
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
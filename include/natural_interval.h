@@ -21,7 +21,12 @@ namespace num {
 
 /*****************************************************************************
  *
+ * @brief closed interval of natural numbers (incl. infinity)
  *
+ * Arithmetic uses the saturation/infinity semantics of natural<T>.
+ * All natural<T> operations are monotone in their operands, so the
+ * resulting bounds are exact.
+ * The empty set is represented by [infinity, 0].
  *
  *****************************************************************************/
 template<class IntT = int>
@@ -81,6 +86,20 @@ public:
     }
 
 
+    /// @brief empty set
+    static constexpr natural_interval
+    empty_set() noexcept {
+        return natural_interval{empty_tag{}};
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr bool
+    empty() const noexcept {
+        return max_ < min_;
+    }
+
+
     //---------------------------------------------------------------
     template<class T, class = typename std::enable_if<is_number<T>::value>::type>
     constexpr bool
@@ -93,8 +112,74 @@ public:
         return ((min_ <= r.min_) && (max_ >= r.max_));
     }
 
+    //-----------------------------------------------------
+    constexpr bool
+    intersects(const natural_interval& r) const noexcept {
+        return !empty() && !r.empty() && (min_ <= r.max_) && (r.min_ <= max_);
+    }
+
+
+    //---------------------------------------------------------------
+    natural_interval&
+    operator += (const natural_interval& o) noexcept {
+        if(empty() || o.empty()) return (*this = empty_set());
+        min_ += o.min_;
+        max_ += o.max_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    natural_interval&
+    operator += (const value_type& v) noexcept {
+        if(empty()) return *this;
+        min_ += v;
+        max_ += v;
+        return *this;
+    }
+
+    //-----------------------------------------------------
+    /// @brief {x - y | x in *this, y in o}; differences saturate at 0
+    natural_interval&
+    operator -= (const natural_interval& o) noexcept {
+        if(empty() || o.empty()) return (*this = empty_set());
+        min_ -= o.max_;
+        max_ -= o.min_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    natural_interval&
+    operator -= (const value_type& v) noexcept {
+        if(empty()) return *this;
+        min_ -= v;
+        max_ -= v;
+        return *this;
+    }
+
+    //-----------------------------------------------------
+    natural_interval&
+    operator *= (const natural_interval& o) noexcept {
+        if(empty() || o.empty()) return (*this = empty_set());
+        min_ *= o.min_;
+        max_ *= o.max_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    natural_interval&
+    operator *= (const value_type& v) noexcept {
+        if(empty()) return *this;
+        min_ *= v;
+        max_ *= v;
+        return *this;
+    }
+
 
 private:
+    struct empty_tag {};
+
+    explicit constexpr
+    natural_interval(empty_tag) noexcept :
+        min_(infinity()), max_(zero())
+    {}
+
     value_type min_;
     value_type max_;
 };
@@ -144,6 +229,164 @@ max(const natural_interval<T>& i) noexcept -> decltype(i.max())
 
 
 
+
+/*****************************************************************************
+ *
+ * INTERVAL ARITHMETIC
+ *
+ *****************************************************************************/
+template<class T>
+inline natural_interval<T>
+operator + (natural_interval<T> a, const natural_interval<T>& b) noexcept
+{
+    a += b;
+    return a;
+}
+
+template<class T>
+inline natural_interval<T>
+operator + (natural_interval<T> a, const natural<T>& b) noexcept
+{
+    a += b;
+    return a;
+}
+
+template<class T>
+inline natural_interval<T>
+operator + (const natural<T>& b, natural_interval<T> a) noexcept
+{
+    a += b;
+    return a;
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline natural_interval<T>
+operator - (natural_interval<T> a, const natural_interval<T>& b) noexcept
+{
+    a -= b;
+    return a;
+}
+
+template<class T>
+inline natural_interval<T>
+operator - (natural_interval<T> a, const natural<T>& b) noexcept
+{
+    a -= b;
+    return a;
+}
+
+template<class T>
+inline natural_interval<T>
+operator - (const natural<T>& b, const natural_interval<T>& a) noexcept
+{
+    auto res = natural_interval<T>{b, b};
+    res -= a;
+    return res;
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline natural_interval<T>
+operator * (natural_interval<T> a, const natural_interval<T>& b) noexcept
+{
+    a *= b;
+    return a;
+}
+
+template<class T>
+inline natural_interval<T>
+operator * (natural_interval<T> a, const natural<T>& b) noexcept
+{
+    a *= b;
+    return a;
+}
+
+template<class T>
+inline natural_interval<T>
+operator * (const natural<T>& b, natural_interval<T> a) noexcept
+{
+    a *= b;
+    return a;
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * JOIN / INTERSECTION
+ *
+ *****************************************************************************/
+template<class T>
+inline natural_interval<T>
+intersection(const natural_interval<T>& a, const natural_interval<T>& b) noexcept
+{
+    const auto& l = (a.min() < b.min()) ? b.min() : a.min();
+    const auto& r = (a.max() < b.max()) ? a.max() : b.max();
+
+    return (r < l) ? natural_interval<T>::empty_set()
+                   : natural_interval<T>{l, r};
+}
+
+//---------------------------------------------------------
+/// @brief smallest interval containing a and b
+template<class T>
+inline natural_interval<T>
+hull(const natural_interval<T>& a, const natural_interval<T>& b) noexcept
+{
+    if(a.empty()) return b;
+    if(b.empty()) return a;
+
+    return natural_interval<T>{
+        (a.min() < b.min()) ? a.min() : b.min(),
+        (a.max() < b.max()) ? b.max() : a.max() };
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline constexpr bool
+intersects(const natural_interval<T>& a, const natural_interval<T>& b) noexcept
+{
+    return a.intersects(b);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr bool
+disjoint(const natural_interval<T>& a, const natural_interval<T>& b) noexcept
+{
+    return !a.intersects(b);
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * COMPARISON
+ *
+ *****************************************************************************/
+template<class T>
+inline constexpr bool
+operator == (const natural_interval<T>& a, const natural_interval<T>& b) noexcept
+{
+    return (a.min() == b.min()) && (a.max() == b.max());
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr bool
+operator != (const natural_interval<T>& a, const natural_interval<T>& b) noexcept
+{
+    return !(a == b);
+}
+
+
+
 }  // namespace num
 }  // namespace am
 
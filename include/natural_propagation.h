@@ -0,0 +1,405 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_NATURAL_PROPAGATION_H_
+#define AM_NUMERIC_NATURAL_PROPAGATION_H_
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+#include <utility>
+
+#include "natural.h"
+#include "natural_interval.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * @brief result of a bounds propagation run
+ *
+ *****************************************************************************/
+enum class propagation_status {
+    /// no domain can be narrowed any further
+    fixpoint,
+    /// at least one domain became empty
+    inconsistent,
+    /// sweep limit reached; domains are narrowed (sound), but not maximally
+    sweep_limit
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * NARROWING OPERATORS
+ *
+ * Each operator intersects the domains with the values that are
+ * consistent with one constraint (under natural<T> semantics).
+ * Returns false, if a domain became empty.
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+template<class T>
+inline bool
+narrow_domain(natural_interval<T>& x, const natural_interval<T>& bounds,
+              bool& changed) noexcept
+{
+    const auto r = intersection(x, bounds);
+    if(r != x) {
+        x = r;
+        changed = true;
+    }
+    return !x.empty();
+}
+
+
+//-------------------------------------------------------------------
+/// @brief x + d <= y
+template<class T>
+inline bool
+narrow_less_equal(natural_interval<T>& x, natural_interval<T>& y,
+                  const natural<T>& d, bool& changed) noexcept
+{
+    using nat_t = natural<T>;
+    using ivl_t = natural_interval<T>;
+
+    if(!narrow_domain(y, ivl_t{x.min() + d, nat_t::infinity()}, changed)) {
+        return false;
+    }
+    //x + d can't exceed y only if it doesn't saturate
+    if(y.max() < nat_t::max()) {
+        if(y.max() < d) {
+            x = ivl_t::empty_set();
+            return false;
+        }
+        return narrow_domain(x, ivl_t{nat_t::zero(), y.max() - d}, changed);
+    }
+    return true;
+}
+
+
+//-------------------------------------------------------------------
+/// @brief narrows x in z = x + y
+template<class T>
+inline bool
+narrow_summand(natural_interval<T>& x, const natural_interval<T>& y,
+               const natural_interval<T>& z, bool& changed) noexcept
+{
+    using nat_t = natural<T>;
+
+    //upper bound only if the sum doesn't saturate
+    const auto r = (z.max() < nat_t::max())
+                 ? z.max() - y.min() : nat_t::infinity();
+
+    return narrow_domain(x, natural_interval<T>{z.min() - y.max(), r}, changed);
+}
+
+//---------------------------------------------------------
+/// @brief z = x + y
+template<class T>
+inline bool
+narrow_sum(natural_interval<T>& z, natural_interval<T>& x,
+           natural_interval<T>& y, bool& changed) noexcept
+{
+    return narrow_domain(z, x + y, changed) &&
+           narrow_summand(x, y, z, changed) &&
+           narrow_summand(y, x, z, changed);
+}
+
+}  // namespace detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief
+ * narrows domains (natural intervals) of variables until all
+ * constraints are consistent with them (bounds propagation)
+ *
+ * Supported constraints:
+ *   x + d <= y     (precedence with delay d)
+ *   z  = x + y
+ *
+ * Variables are split into connected components of the constraint graph.
+ * The constraints of each component are stored contiguously and are
+ * swept in batches until no domain changes.
+ * Components don't share variables, so propagate_component can be
+ * called concurrently for different components (on the same domains).
+ *
+ * Sweeps per component are limited to (number of its variables + 1);
+ * for pure precedence constraints that is the Bellman-Ford bound, so
+ * reaching the limit means that there is a positive cycle.
+ *
+ *****************************************************************************/
+template<class IntT = int>
+class natural_propagator
+{
+public:
+    //---------------------------------------------------------------
+    using value_type     = natural<IntT>;
+    using interval_type  = natural_interval<IntT>;
+    using size_type      = std::size_t;
+
+
+    //---------------------------------------------------------------
+    explicit
+    natural_propagator(size_type variables = 0):
+        parent_(), cons_(), sorted_(), first_(), vars_(),
+        dirty_{false}
+    {
+        add_variables(variables);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    variable_count() const noexcept {
+        return parent_.size();
+    }
+
+    size_type
+    constraint_count() const noexcept {
+        return cons_.size();
+    }
+
+
+    //---------------------------------------------------------------
+    /// @return index of first new variable
+    size_type
+    add_variables(size_type n) {
+        const auto first = parent_.size();
+        parent_.reserve(first + n);
+        for(size_type i = 0; i < n; ++i) parent_.push_back(first + i);
+        return first;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief x + d <= y
+    void
+    add_less_equal(size_type x, size_type y,
+                   const value_type& d = value_type::zero())
+    {
+        add_constraint(constraint{kind::less_equal, x, y, y, d});
+    }
+
+    //-----------------------------------------------------
+    /// @brief z = x + y
+    void
+    add_sum(size_type z, size_type x, size_type y)
+    {
+        add_constraint(constraint{kind::sum, x, y, z, value_type::zero()});
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief number of connected components with at least one constraint
+    size_type
+    component_count() {
+        update_components();
+        return vars_.size();
+    }
+
+    //-----------------------------------------------------
+    /// @brief number of variables in component c
+    size_type
+    component_size(size_type c) {
+        update_components();
+        assert(c < vars_.size());
+        return vars_[c];
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief narrows domains of all components
+     * @param domains one interval per variable
+     */
+    propagation_status
+    propagate(std::vector<interval_type>& domains)
+    {
+        assert(domains.size() == variable_count());
+
+        for(const auto& d : domains) {
+            if(d.empty()) return propagation_status::inconsistent;
+        }
+
+        update_components();
+
+        auto res = propagation_status::fixpoint;
+        for(size_type c = 0; c < vars_.size(); ++c) {
+            const auto r = propagate_component(c, domains);
+            if(r == propagation_status::inconsistent) return r;
+            if(r == propagation_status::sweep_limit) res = r;
+        }
+        return res;
+    }
+
+    //-----------------------------------------------------
+    /**
+     * @brief narrows domains of the variables in component c only
+     * @pre   component_count() has been called after the last
+     *        constraint was added
+     */
+    propagation_status
+    propagate_component(size_type c,
+                        std::vector<interval_type>& domains) const
+    {
+        assert(!dirty_);
+        assert(c < vars_.size());
+        assert(domains.size() == variable_count());
+
+        const auto first = sorted_.data() + first_[c];
+        const auto last  = sorted_.data() + first_[c+1];
+        auto dom = domains.data();
+
+        for(size_type sweep = 0; sweep <= vars_[c]; ++sweep) {
+            bool changed = false;
+            for(auto k = first; k != last; ++k) {
+                if(!narrow(*k, dom, changed)) {
+                    return propagation_status::inconsistent;
+                }
+            }
+            if(!changed) return propagation_status::fixpoint;
+        }
+        return propagation_status::sweep_limit;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    enum class kind : unsigned char { less_equal, sum };
+
+    struct constraint {
+        kind k;
+        size_type x;
+        size_type y;
+        size_type z;
+        value_type d;
+    };
+
+
+    //---------------------------------------------------------------
+    static bool
+    narrow(const constraint& c, interval_type* dom, bool& changed) noexcept
+    {
+        switch(c.k) {
+            case kind::less_equal:
+                return detail::narrow_less_equal(dom[c.x], dom[c.y],
+                                                 c.d, changed);
+            case kind::sum:
+                return detail::narrow_sum(dom[c.z], dom[c.x], dom[c.y],
+                                          changed);
+            default:
+                return true;
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    void
+    add_constraint(const constraint& c)
+    {
+        assert(c.x < variable_count());
+        assert(c.y < variable_count());
+        assert(c.z < variable_count());
+
+        cons_.push_back(c);
+        unite(c.x, c.y);
+        unite(c.x, c.z);
+        dirty_ = true;
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    find(size_type i) noexcept {
+        //path halving
+        while(parent_[i] != i) {
+            parent_[i] = parent_[parent_[i]];
+            i = parent_[i];
+        }
+        return i;
+    }
+
+    //-----------------------------------------------------
+    void
+    unite(size_type i, size_type j) noexcept {
+        i = find(i);
+        j = find(j);
+        if(i != j) parent_[j] = i;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief groups constraints by component (counting sort)
+    void
+    update_components()
+    {
+        if(!dirty_) return;
+
+        const auto none = variable_count();
+        std::vector<size_type> comp(variable_count(), none);
+
+        size_type nc = 0;
+        std::vector<size_type> count;
+        for(const auto& c : cons_) {
+            auto& id = comp[find(c.x)];
+            if(id == none) {
+                id = nc++;
+                count.push_back(0);
+            }
+            ++count[id];
+        }
+
+        first_.assign(nc + 1, 0);
+        for(size_type i = 0; i < nc; ++i) {
+            first_[i+1] = first_[i] + count[i];
+        }
+
+        auto pos = first_;
+        sorted_.resize(cons_.size());
+        for(const auto& c : cons_) {
+            sorted_[pos[comp[find(c.x)]]++] = c;
+        }
+
+        vars_.assign(nc, 0);
+        for(size_type i = 0; i < variable_count(); ++i) {
+            const auto id = comp[find(i)];
+            if(id != none) ++vars_[id];
+        }
+
+        dirty_ = false;
+    }
+
+
+    //---------------------------------------------------------------
+    std::vector<size_type> parent_;
+    std::vector<constraint> cons_;
+    std::vector<constraint> sorted_;
+    std::vector<size_type> first_;
+    std::vector<size_type> vars_;
+    bool dirty_;
+};
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,679 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_NTT_H_
+#define AM_NUMERIC_NTT_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+
+#include "choice.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * MONTGOMERY ARITHMETIC
+ *
+ * Values x are represented as x * 2^32 mod p; a product needs one
+ * 64 bit multiplication and one Montgomery reduction (two 32x32 bit
+ * multiplications, no division).
+ * All functions are branch-free and can be vectorized by the compiler.
+ *
+ *****************************************************************************/
+namespace detail {
+
+template<std::uint32_t p>
+struct montgomery32
+{
+    static_assert(p % 2 == 1 && p < (std::uint32_t(1) << 31),
+        "montgomery32<p>: p must be odd and < 2^31");
+
+    static constexpr std::uint32_t mod = p;
+
+    /// @brief p^-1 mod 2^32 (Newton iteration)
+    static constexpr std::uint32_t
+    inverse() noexcept {
+        std::uint32_t x = p;
+        for(int i = 0; i < 5; ++i) x *= std::uint32_t(2) - p * x;
+        return x;
+    }
+
+    static constexpr std::uint32_t pinv = inverse();
+
+    /// @brief 2^64 mod p
+    static constexpr std::uint32_t r2 = std::uint32_t(
+        (std::uint64_t(std::uint32_t((std::uint64_t(1) << 32) % p)) *
+         std::uint32_t((std::uint64_t(1) << 32) % p)) % p);
+
+
+    //---------------------------------------------------------------
+    /// @brief t * 2^-32 mod p for t < p * 2^32
+    static std::uint32_t
+    reduce(std::uint64_t t) noexcept {
+        //low halves of t and m*p cancel out; only 32 bit high products
+        //are needed which keeps the arithmetic vectorizable
+        const auto m = std::uint32_t(std::uint32_t(t) * pinv);
+        const auto h = std::uint32_t((std::uint64_t(m) * p) >> 32);
+        const auto u = std::uint32_t(t >> 32);
+        const auto d = std::uint32_t(u - h);
+        return (u < h) ? std::uint32_t(d + p) : d;
+    }
+
+    static std::uint32_t
+    mul(std::uint32_t a, std::uint32_t b) noexcept {
+        return reduce(std::uint64_t(a) * b);
+    }
+
+    static std::uint32_t
+    add(std::uint32_t a, std::uint32_t b) noexcept {
+        const auto s = std::uint32_t(a + b);
+        return (s >= p) ? std::uint32_t(s - p) : s;
+    }
+
+    static std::uint32_t
+    sub(std::uint32_t a, std::uint32_t b) noexcept {
+        const auto d = std::uint32_t(a - b);
+        return (a < b) ? std::uint32_t(d + p) : d;
+    }
+
+    //---------------------------------------------------------------
+    static std::uint32_t
+    to_mont(std::uint32_t x) noexcept {
+        return mul(x, r2);
+    }
+
+    static std::uint32_t
+    from_mont(std::uint32_t x) noexcept {
+        return reduce(x);
+    }
+};
+
+
+//-------------------------------------------------------------------
+/// @brief smallest generator of the multiplicative group mod prime p
+template<std::uint32_t p>
+inline choice<std::uint32_t,p>
+primitive_root()
+{
+    using ch = choice<std::uint32_t,p>;
+
+    std::vector<std::uint32_t> factors;
+    auto m = p - 1;
+    for(std::uint32_t q = 2; q * q <= m; ++q) {
+        if(m % q == 0) {
+            factors.push_back(q);
+            while(m % q == 0) m /= q;
+        }
+    }
+    if(m > 1) factors.push_back(m);
+
+    for(std::uint32_t g = 2; g < p; ++g) {
+        bool gen = true;
+        for(auto q : factors) {
+            if(pow(ch{g}, (p - 1) / q) == ch{std::uint32_t(1)}) {
+                gen = false;
+                break;
+            }
+        }
+        if(gen) return ch{g};
+    }
+    return ch{std::uint32_t(1)};
+}
+
+//-------------------------------------------------------------------
+template<std::uint32_t p>
+constexpr std::uint32_t montgomery32<p>::mod;
+
+template<std::uint32_t p>
+constexpr std::uint32_t montgomery32<p>::pinv;
+
+template<std::uint32_t p>
+constexpr std::uint32_t montgomery32<p>::r2;
+
+}  // namespace detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief number-theoretic transform of size n (power of two) over Z/pZ
+ *
+ * @tparam p  prime < 2^31 with 2^k | p-1 for all used sizes 2^k,
+ *            e.g. 998244353, 469762049, 167772161, 2013265921
+ *
+ * forward: decimation-in-frequency, natural order -> bit-reversed order
+ * inverse: decimation-in-time,      bit-reversed order -> natural order
+ * so convolutions don't need a bit-reversal permutation.
+ *
+ * Two radix-2 stages are fused into one radix-4 pass over the data,
+ * which halves the memory traffic. Once the butterfly span fits into
+ * the cache (block_size elements), all remaining stages are applied
+ * to one block at a time.
+ * Twiddle factors are precomputed per stage and are accessed
+ * sequentially (n values each for forward and inverse transforms).
+ *
+ *****************************************************************************/
+template<std::uint32_t p>
+class ntt_plan
+{
+    using mont = detail::montgomery32<p>;
+
+public:
+    //---------------------------------------------------------------
+    using value_type = choice<std::uint32_t,p>;
+    using size_type  = std::size_t;
+
+    /// @brief 2^15 32 bit values: 128 KiB
+    static constexpr size_type block_size = size_type(1) << 15;
+
+    /// @brief butterflies per batch in radix-4 passes
+    static constexpr size_type chunk_size = 32;
+
+
+    //---------------------------------------------------------------
+    /**
+     * @param n  transform size; must be a power of two
+     * @throws std::length_error if 2^k = n does not divide p-1
+     */
+    explicit
+    ntt_plan(size_type n):
+        n_(n), tw_(n), itw_(n)
+    {
+        assert(n > 0 && (n & (n - 1)) == 0);
+
+        if(n > max_size()) {
+            throw std::length_error{"ntt_plan: size not supported by modulus"};
+        }
+
+        ninv_ = num::inverse(value_type{std::uint32_t(n)}).value();
+        if(n < 2) return;
+
+        //tw_[h + j] = w_{2h}^j  (w_{2h}: primitive 2h-th root of unity)
+        const auto h = n / 2;
+        const auto w = pow(detail::primitive_root<p>(), (p - 1) / std::uint32_t(n));
+        tw_[h] = itw_[h] = mont::to_mont(1);
+        auto wm = mont::to_mont(w.value());
+        auto iwm = mont::to_mont(num::inverse(w).value());
+        //powers by doubling: independent multiplications
+        for(size_type m = 1; m < h; m <<= 1) {
+            for(size_type j = 0; j < m; ++j) {
+                tw_[h + m + j] = mont::mul(tw_[h + j], wm);
+                itw_[h + m + j] = mont::mul(itw_[h + j], iwm);
+            }
+            wm = mont::mul(wm, wm);
+            iwm = mont::mul(iwm, iwm);
+        }
+        //w_{2h}^j = w_{4h}^{2j}
+        for(size_type k = h / 2; k > 0; k >>= 1) {
+            for(size_type j = 0; j < k; ++j) {
+                tw_[k + j] = tw_[2*k + 2*j];
+                itw_[k + j] = itw_[2*k + 2*j];
+            }
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        return n_;
+    }
+
+    /// @brief largest power of two that divides p-1
+    static constexpr size_type
+    max_size() noexcept {
+        return size_type((p - 1) & (~(p - 1) + 1));
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief in-place forward transform; result in bit-reversed order
+    void
+    forward(std::vector<value_type>& a) const
+    {
+        assert(a.size() == n_);
+        auto x = load(a);
+        forward_mont(x.data());
+        store(x, a, 1);
+    }
+
+    //-----------------------------------------------------
+    /// @brief in-place inverse transform of bit-reversed input (scaled)
+    void
+    inverse(std::vector<value_type>& a) const
+    {
+        assert(a.size() == n_);
+        auto x = load(a);
+        inverse_mont(x.data());
+        store(x, a, ninv_);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief forward transform of Montgomery form values
+    void
+    forward_mont(std::uint32_t* x) const noexcept
+    {
+        const auto b = std::min(n_, block_size);
+        if(n_ > b) dif_passes(x, n_, n_, 2*b);
+        for(size_type k = 0; k < n_; k += b) {
+            dif_passes(x + k, b, b, 2);
+        }
+    }
+
+    //-----------------------------------------------------
+    /// @brief unscaled inverse transform of Montgomery form values
+    void
+    inverse_mont(std::uint32_t* x) const noexcept
+    {
+        const auto b = std::min(n_, block_size);
+        for(size_type k = 0; k < n_; k += b) {
+            dit_passes(x + k, b, 2, b);
+        }
+        if(n_ > b) dit_passes(x, n_, 2*b, n_);
+    }
+
+    //-----------------------------------------------------
+    /// @brief n^-1 mod p
+    std::uint32_t
+    scale() const noexcept {
+        return ninv_;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    static std::vector<std::uint32_t>
+    load(const std::vector<value_type>& a)
+    {
+        std::vector<std::uint32_t> x (a.size());
+        for(size_type i = 0; i < a.size(); ++i) {
+            x[i] = mont::to_mont(a[i].value());
+        }
+        return x;
+    }
+
+    //-----------------------------------------------------
+    /// @brief leaves Montgomery form and multiplies by factor
+    static void
+    store(const std::vector<std::uint32_t>& x, std::vector<value_type>& a,
+          std::uint32_t factor)
+    {
+        for(size_type i = 0; i < x.size(); ++i) {
+            //x*R * f * R^-1 = x*f
+            a[i] = value_type{mont::reduce(std::uint64_t(x[i]) * factor)};
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    /**
+     * @brief DIF stages with butterfly lengths first, first/2, ..., last
+     *        on all blocks of size 'first' in x[0,size)
+     */
+    void
+    dif_passes(std::uint32_t* x, size_type size,
+               size_type first, size_type last) const noexcept
+    {
+        auto len = first;
+        for(; len >= 2*last && len >= 4; len >>= 2) {
+            dif_radix4(x, size, len);
+        }
+        if(len >= last) dif_radix2(x, size, len);
+    }
+
+    //-----------------------------------------------------
+    /**
+     * @brief DIT stages with butterfly lengths first, 2*first, ..., last
+     *        on all blocks of size 'last' in x[0,size)
+     */
+    void
+    dit_passes(std::uint32_t* x, size_type size,
+               size_type first, size_type last) const noexcept
+    {
+        auto len = first;
+        //odd number of stages: single radix-2 stage first
+        if(((bit_index(last) - bit_index(first)) & 1) == 0) {
+            dit_radix2(x, size, len);
+            len <<= 1;
+        }
+        for(; len <= last; len <<= 2) {
+            dit_radix4(x, size, 2*len);
+        }
+    }
+
+    static int
+    bit_index(size_type x) noexcept {
+        int i = 0;
+        for(; x > 1; x >>= 1) ++i;
+        return i;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief one DIF stage on all blocks of size len in x[0,size)
+    void
+    dif_radix2(std::uint32_t* x, size_type size, size_type len) const noexcept
+    {
+        const auto h = len / 2;
+        if(h == 1) {
+            //twiddle factor is 1
+            for(size_type k = 0; k < size; k += 2) {
+                const auto u = x[k];
+                const auto v = x[k+1];
+                x[k]   = mont::add(u, v);
+                x[k+1] = mont::sub(u, v);
+            }
+            return;
+        }
+        const auto w = tw_.data() + h;
+        for(size_type k = 0; k < size; k += len) {
+            const auto y = x + k;
+            for(size_type j = 0; j < h; ++j) {
+                const auto u = y[j];
+                const auto v = y[j+h];
+                y[j]   = mont::add(u, v);
+                y[j+h] = mont::mul(mont::sub(u, v), w[j]);
+            }
+        }
+    }
+
+    //-----------------------------------------------------
+    /// @brief two fused DIF stages (lengths len and len/2) on all blocks
+    void
+    dif_radix4(std::uint32_t* x, size_type size, size_type len) const noexcept
+    {
+        //short butterfly spans: loop over all blocks with constant span
+        switch(len / 4) {
+            case  1: dif_radix4_short<1>(x, size);  return;
+            case  2: dif_radix4_short<2>(x, size);  return;
+            case  4: dif_radix4_short<4>(x, size);  return;
+            case  8: dif_radix4_short<8>(x, size);  return;
+            case 16: dif_radix4_short<16>(x, size); return;
+            default: break;
+        }
+        for(size_type k = 0; k < size; k += len) {
+            dif_radix4_chunked(x + k, len);
+        }
+    }
+
+    //-----------------------------------------------------
+    static void
+    dif_butterfly4(std::uint32_t* y, size_type q, size_type j,
+                   const std::uint32_t* w1, const std::uint32_t* w2) noexcept
+    {
+        const auto a0 = y[j], a1 = y[j+q], a2 = y[j+2*q], a3 = y[j+3*q];
+
+        const auto b0 = mont::add(a0, a2);
+        const auto b2 = mont::mul(mont::sub(a0, a2), w1[j]);
+        const auto b1 = mont::add(a1, a3);
+        const auto b3 = mont::mul(mont::sub(a1, a3), w1[j+q]);
+
+        y[j]     = mont::add(b0, b1);
+        y[j+q]   = mont::mul(mont::sub(b0, b1), w2[j]);
+        y[j+2*q] = mont::add(b2, b3);
+        y[j+3*q] = mont::mul(mont::sub(b2, b3), w2[j]);
+    }
+
+    //-----------------------------------------------------
+    template<size_type q>
+    void
+    dif_radix4_short(std::uint32_t* x, size_type size) const noexcept
+    {
+        std::uint32_t w1[2*q], w2[q];
+        std::copy(tw_.data() + 2*q, tw_.data() + 4*q, w1);
+        std::copy(tw_.data() + q, tw_.data() + 2*q, w2);
+
+        for(size_type k = 0; k < size; k += 4*q) {
+            for(size_type j = 0; j < q; ++j) {
+                dif_butterfly4(x + k, q, j, w1, w2);
+            }
+        }
+    }
+
+    //-----------------------------------------------------
+    /**
+     * @brief two fused DIF stages on one block of size len
+     *
+     * The first stage goes to local buffers, so that neither loop
+     * has to be checked for aliasing between the 4 data streams and
+     * the twiddle factors (which would prevent vectorization).
+     */
+    void
+    dif_radix4_chunked(std::uint32_t* x, size_type len) const noexcept
+    {
+        const auto q = len / 4;
+        assert(q % chunk_size == 0);
+        const auto w1 = tw_.data() + 2*q;
+        const auto w2 = tw_.data() + q;
+
+        std::uint32_t b0[chunk_size], b1[chunk_size],
+                      b2[chunk_size], b3[chunk_size];
+
+        for(size_type k = 0; k < q; k += chunk_size) {
+            const auto y = x + k;
+            for(size_type j = 0; j < chunk_size; ++j) {
+                const auto a0 = y[j], a1 = y[j+q], a2 = y[j+2*q], a3 = y[j+3*q];
+                b0[j] = mont::add(a0, a2);
+                b2[j] = mont::mul(mont::sub(a0, a2), w1[k+j]);
+                b1[j] = mont::add(a1, a3);
+                b3[j] = mont::mul(mont::sub(a1, a3), w1[k+j+q]);
+            }
+            for(size_type j = 0; j < chunk_size; ++j) {
+                y[j]     = mont::add(b0[j], b1[j]);
+                y[j+q]   = mont::mul(mont::sub(b0[j], b1[j]), w2[k+j]);
+                y[j+2*q] = mont::add(b2[j], b3[j]);
+                y[j+3*q] = mont::mul(mont::sub(b2[j], b3[j]), w2[k+j]);
+            }
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief one DIT stage on all blocks of size len in x[0,size)
+    void
+    dit_radix2(std::uint32_t* x, size_type size, size_type len) const noexcept
+    {
+        const auto h = len / 2;
+        if(h == 1) {
+            //twiddle factor is 1
+            for(size_type k = 0; k < size; k += 2) {
+                const auto u = x[k];
+                const auto v = x[k+1];
+                x[k]   = mont::add(u, v);
+                x[k+1] = mont::sub(u, v);
+            }
+            return;
+        }
+        const auto w = itw_.data() + h;
+        for(size_type k = 0; k < size; k += len) {
+            const auto y = x + k;
+            for(size_type j = 0; j < h; ++j) {
+                const auto u = y[j];
+                const auto v = mont::mul(y[j+h], w[j]);
+                y[j]   = mont::add(u, v);
+                y[j+h] = mont::sub(u, v);
+            }
+        }
+    }
+
+    //-----------------------------------------------------
+    /// @brief two fused DIT stages (lengths len/2 and len) on all blocks
+    void
+    dit_radix4(std::uint32_t* x, size_type size, size_type len) const noexcept
+    {
+        switch(len / 4) {
+            case  1: dit_radix4_short<1>(x, size);  return;
+            case  2: dit_radix4_short<2>(x, size);  return;
+            case  4: dit_radix4_short<4>(x, size);  return;
+            case  8: dit_radix4_short<8>(x, size);  return;
+            case 16: dit_radix4_short<16>(x, size); return;
+            default: break;
+        }
+        for(size_type k = 0; k < size; k += len) {
+            dit_radix4_chunked(x + k, len);
+        }
+    }
+
+    //-----------------------------------------------------
+    static void
+    dit_butterfly4(std::uint32_t* y, size_type q, size_type j,
+                   const std::uint32_t* w1, const std::uint32_t* w2) noexcept
+    {
+        const auto v1 = mont::mul(y[j+q], w1[j]);
+        const auto v3 = mont::mul(y[j+3*q], w1[j]);
+        const auto b0 = mont::add(y[j], v1);
+        const auto b1 = mont::sub(y[j], v1);
+        const auto b2 = mont::add(y[j+2*q], v3);
+        const auto b3 = mont::sub(y[j+2*q], v3);
+
+        const auto c2 = mont::mul(b2, w2[j]);
+        const auto c3 = mont::mul(b3, w2[j+q]);
+        y[j]     = mont::add(b0, c2);
+        y[j+2*q] = mont::sub(b0, c2);
+        y[j+q]   = mont::add(b1, c3);
+        y[j+3*q] = mont::sub(b1, c3);
+    }
+
+    //-----------------------------------------------------
+    template<size_type q>
+    void
+    dit_radix4_short(std::uint32_t* x, size_type size) const noexcept
+    {
+        std::uint32_t w1[q], w2[2*q];
+        std::copy(itw_.data() + q, itw_.data() + 2*q, w1);
+        std::copy(itw_.data() + 2*q, itw_.data() + 4*q, w2);
+
+        for(size_type k = 0; k < size; k += 4*q) {
+            for(size_type j = 0; j < q; ++j) {
+                dit_butterfly4(x + k, q, j, w1, w2);
+            }
+        }
+    }
+
+    //-----------------------------------------------------
+    /// @brief two fused DIT stages on one block of size len
+    void
+    dit_radix4_chunked(std::uint32_t* x, size_type len) const noexcept
+    {
+        const auto q = len / 4;
+        assert(q % chunk_size == 0);
+        const auto w1 = itw_.data() + q;
+        const auto w2 = itw_.data() + 2*q;
+
+        std::uint32_t b0[chunk_size], b1[chunk_size],
+                      b2[chunk_size], b3[chunk_size];
+
+        for(size_type k = 0; k < q; k += chunk_size) {
+            const auto y = x + k;
+            for(size_type j = 0; j < chunk_size; ++j) {
+                const auto v1 = mont::mul(y[j+q], w1[k+j]);
+                const auto v3 = mont::mul(y[j+3*q], w1[k+j]);
+                b0[j] = mont::add(y[j], v1);
+                b1[j] = mont::sub(y[j], v1);
+                b2[j] = mont::mul(mont::add(y[j+2*q], v3), w2[k+j]);
+                b3[j] = mont::mul(mont::sub(y[j+2*q], v3), w2[k+j+q]);
+            }
+            for(size_type j = 0; j < chunk_size; ++j) {
+                y[j]     = mont::add(b0[j], b2[j]);
+                y[j+2*q] = mont::sub(b0[j], b2[j]);
+                y[j+q]   = mont::add(b1[j], b3[j]);
+                y[j+3*q] = mont::sub(b1[j], b3[j]);
+            }
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    size_type n_;
+    std::vector<std::uint32_t> tw_;
+    std::vector<std::uint32_t> itw_;
+    std::uint32_t ninv_ = 1;
+};
+
+
+//-------------------------------------------------------------------
+template<std::uint32_t p>
+constexpr typename ntt_plan<p>::size_type ntt_plan<p>::block_size;
+
+template<std::uint32_t p>
+constexpr typename ntt_plan<p>::size_type ntt_plan<p>::chunk_size;
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief product of two polynomials with coefficients in Z/pZ
+ *        (cyclic convolution via NTT; schoolbook for short inputs)
+ *
+ * @throws std::length_error if the product is too long for p
+ *
+ *****************************************************************************/
+template<std::uint32_t p>
+std::vector<choice<std::uint32_t,p>>
+poly_multiply(const std::vector<choice<std::uint32_t,p>>& a,
+              const std::vector<choice<std::uint32_t,p>>& b)
+{
+    using value_t = choice<std::uint32_t,p>;
+    using mont = detail::montgomery32<p>;
+
+    if(a.empty() || b.empty()) return std::vector<value_t>{};
+
+    const auto m = a.size() + b.size() - 1;
+
+    if(std::min(a.size(), b.size()) <= 32) {
+        std::vector<value_t> c (m, value_t{std::uint32_t(0)});
+        for(std::size_t i = 0; i < a.size(); ++i) {
+            for(std::size_t j = 0; j < b.size(); ++j) {
+                c[i+j] += a[i] * b[j];
+            }
+        }
+        return c;
+    }
+
+    std::size_t n = 1;
+    while(n < m) n <<= 1;
+
+    const ntt_plan<p> plan {n};
+
+    std::vector<std::uint32_t> x (n, 0), y (n, 0);
+    for(std::size_t i = 0; i < a.size(); ++i) x[i] = mont::to_mont(a[i].value());
+    for(std::size_t i = 0; i < b.size(); ++i) y[i] = mont::to_mont(b[i].value());
+
+    plan.forward_mont(x.data());
+    plan.forward_mont(y.data());
+    for(std::size_t i = 0; i < n; ++i) x[i] = mont::mul(x[i], y[i]);
+    plan.inverse_mont(x.data());
+
+    std::vector<value_t> c;
+    c.reserve(m);
+    const auto s = plan.scale();
+    for(std::size_t i = 0; i < m; ++i) {
+        c.push_back(value_t{mont::reduce(std::uint64_t(x[i]) * s)});
+    }
+    return c;
+}
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
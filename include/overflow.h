@@ -0,0 +1,164 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_OVERFLOW_H_
+#define AM_NUMERIC_OVERFLOW_H_
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * INTEGER OVERFLOW DETECTION
+ *
+ * add_overflow/sub_overflow/mul_overflow store the wrapped-around result
+ * in 'r' and return true if the exact result is not representable;
+ * they map to the compiler's overflow builtins where available
+ * (for builtin integers)
+ *
+ *****************************************************************************/
+namespace detail {
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+
+//-------------------------------------------------------------------
+template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
+inline bool
+add_overflow(const T& a, const T& b, T& r) noexcept
+{
+#if defined(__GNUC__)
+    return __builtin_add_overflow(a, b, &r);
+#else
+    using lim = std::numeric_limits<T>;
+    const bool o = (b > T(0)) ? (a > T(lim::max() - b))
+                              : (a < T(lim::min() - b));
+    r = T(a + b);
+    return o;
+#endif
+}
+
+//---------------------------------------------------------
+template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
+inline bool
+sub_overflow(const T& a, const T& b, T& r) noexcept
+{
+#if defined(__GNUC__)
+    return __builtin_sub_overflow(a, b, &r);
+#else
+    using lim = std::numeric_limits<T>;
+    const bool o = (b > T(0)) ? (a < T(lim::min() + b))
+                              : (a > T(lim::max() + b));
+    r = T(a - b);
+    return o;
+#endif
+}
+
+//---------------------------------------------------------
+template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
+inline bool
+mul_overflow(const T& a, const T& b, T& r) noexcept
+{
+#if defined(__GNUC__)
+    return __builtin_mul_overflow(a, b, &r);
+#else
+    using lim = std::numeric_limits<T>;
+    bool o = false;
+    if(a != T(0) && b != T(0)) {
+        if(a > T(0)) {
+            o = (b > T(0)) ? (a > T(lim::max() / b))
+                           : (b < T(lim::min() / a));
+        } else {
+            o = (b > T(0)) ? (a < T(lim::min() / b))
+                           : (a < T(lim::max() / b));
+        }
+    }
+    r = o ? T(0) : T(a * b);
+    return o;
+#endif
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief number types without fixed width never overflow
+template<class T, class = std::enable_if_t<!std::is_integral<T>::value>,
+          class = void>
+inline bool
+add_overflow(const T& a, const T& b, T& r)
+{
+    r = a + b;
+    return false;
+}
+
+template<class T, class = std::enable_if_t<!std::is_integral<T>::value>,
+          class = void>
+inline bool
+sub_overflow(const T& a, const T& b, T& r)
+{
+    r = a - b;
+    return false;
+}
+
+template<class T, class = std::enable_if_t<!std::is_integral<T>::value>,
+          class = void>
+inline bool
+mul_overflow(const T& a, const T& b, T& r)
+{
+    r = a * b;
+    return false;
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief builtin integer type with at least twice the width of T;
+///        void, if there is none
+template<class T, bool = std::is_integral<T>::value>
+struct wider_integer
+{
+    using type = std::conditional_t<(sizeof(T) <= 4),
+        std::conditional_t<std::is_signed<T>::value, std::int64_t, std::uint64_t>,
+#ifdef __SIZEOF_INT128__
+        std::conditional_t<(sizeof(T) <= 8),
+            std::conditional_t<std::is_signed<T>::value, int128_t, uint128_t>,
+            void>
+#else
+        void
+#endif
+        >;
+};
+
+template<class T>
+struct wider_integer<T,false>
+{
+    using type = void;
+};
+
+template<class T>
+using wider_integer_t = typename wider_integer<T>::type;
+
+
+}  // namespace detail
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
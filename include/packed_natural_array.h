@@ -0,0 +1,417 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_PACKED_NATURAL_ARRAY_H_
+#define AM_NUMERIC_PACKED_NATURAL_ARRAY_H_
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <limits>
+#include <type_traits>
+#include <initializer_list>
+
+#include "natural.h"
+#include "natural_array.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * BIT FIELD ACCESS
+ *
+ * Field i occupies bits [i*Bits, (i+1)*Bits) of a little-endian byte
+ * sequence; each field lies completely within 4 consecutive bytes
+ * (for Bits <= 25). The byte-wise assembly is endian-independent and
+ * compiles to single (unaligned) loads/stores on little-endian machines.
+ *
+ *****************************************************************************/
+namespace detail {
+
+template<int Bits>
+inline std::uint32_t
+load_bit_field(const std::uint8_t* bytes, std::size_t i) noexcept
+{
+    constexpr auto mask = std::uint32_t((std::uint32_t(1) << Bits) - 1);
+    const auto off = i * std::size_t(Bits);
+    const auto p = bytes + off / 8;
+    const auto w = std::uint32_t(p[0]) | (std::uint32_t(p[1]) << 8) |
+                   (std::uint32_t(p[2]) << 16) | (std::uint32_t(p[3]) << 24);
+    return (w >> (off % 8)) & mask;
+}
+
+//---------------------------------------------------------
+template<int Bits>
+inline void
+store_bit_field(std::uint8_t* bytes, std::size_t i, std::uint32_t code) noexcept
+{
+    constexpr auto mask = std::uint32_t((std::uint32_t(1) << Bits) - 1);
+    const auto off = i * std::size_t(Bits);
+    const auto shift = unsigned(off % 8);
+    const auto p = bytes + off / 8;
+    auto w = std::uint32_t(p[0]) | (std::uint32_t(p[1]) << 8) |
+             (std::uint32_t(p[2]) << 16) | (std::uint32_t(p[3]) << 24);
+    w = (w & ~(mask << shift)) | ((code & mask) << shift);
+    p[0] = std::uint8_t(w);
+    p[1] = std::uint8_t(w >> 8);
+    p[2] = std::uint8_t(w >> 16);
+    p[3] = std::uint8_t(w >> 24);
+}
+
+}  // namespace detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief
+ * sequence of natural numbers packed into bit fields of 'Bits' bits
+ *
+ * The largest code (all bits set) represents infinity, so the largest
+ * storable finite value is 2^Bits - 2. Larger finite values saturate
+ * to that maximum (like natural<T> saturates at its maximum).
+ *
+ * @tparam Bits  field width in [2,24]; 8 and 16 give byte-aligned fields
+ * @tparam IntT  integer type of the decoded natural numbers
+ *
+ *****************************************************************************/
+template<int Bits, class IntT = int>
+class packed_natural_array
+{
+    static_assert(Bits >= 2 && Bits <= 24,
+        "packed_natural_array<Bits,T>: Bits must be in [2,24]");
+
+    static_assert(std::is_integral<IntT>::value && std::is_signed<IntT>::value &&
+        std::numeric_limits<IntT>::digits >= Bits,
+        "packed_natural_array<Bits,T>: T must be a builtin signed integer "
+        "type that can represent all codes");
+
+    //padding: 32 bit access to the last field
+    static constexpr std::size_t padding = 3;
+
+public:
+    //---------------------------------------------------------------
+    using value_type      = natural<IntT>;
+    using numeric_type    = IntT;
+    using size_type       = std::size_t;
+
+    static constexpr int bits = Bits;
+
+
+    //---------------------------------------------------------------
+    /// @brief proxy for access to single elements
+    class reference
+    {
+        friend class packed_natural_array;
+
+        reference(std::uint8_t* bytes, size_type i) noexcept:
+            bytes_{bytes}, i_{i}
+        {}
+
+    public:
+        operator value_type() const noexcept {
+            return decode_code(detail::load_bit_field<Bits>(bytes_, i_));
+        }
+
+        reference&
+        operator = (const value_type& x) noexcept {
+            detail::store_bit_field<Bits>(bytes_, i_, encode_code(x));
+            return *this;
+        }
+
+        reference&
+        operator = (const reference& r) noexcept {
+            return (*this = value_type(r));
+        }
+
+        reference&
+        operator += (const value_type& x) noexcept {
+            auto v = value_type(*this);
+            v += x;
+            return (*this = v);
+        }
+
+        reference&
+        operator -= (const value_type& x) noexcept {
+            auto v = value_type(*this);
+            v -= x;
+            return (*this = v);
+        }
+
+        reference&
+        operator *= (const value_type& x) noexcept {
+            auto v = value_type(*this);
+            v *= x;
+            return (*this = v);
+        }
+
+    private:
+        std::uint8_t* bytes_;
+        size_type i_;
+    };
+
+
+    //---------------------------------------------------------------
+    packed_natural_array():
+        n_(0), bytes_(padding, std::uint8_t(0))
+    {}
+
+    explicit
+    packed_natural_array(size_type n):
+        n_(n), bytes_(byte_count(n), std::uint8_t(0))
+    {}
+
+    packed_natural_array(size_type n, const value_type& x):
+        packed_natural_array(n)
+    {
+        const auto code = encode_code(x);
+        for(size_type i = 0; i < n; ++i) {
+            detail::store_bit_field<Bits>(bytes_.data(), i, code);
+        }
+    }
+
+    packed_natural_array(std::initializer_list<value_type> il):
+        packed_natural_array(il.size())
+    {
+        size_type i = 0;
+        for(const auto& x : il) set(i++, x);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        return n_;
+    }
+
+    bool
+    empty() const noexcept {
+        return n_ == 0;
+    }
+
+    /// @brief new elements are zero
+    void
+    resize(size_type n) {
+        if(n < n_) {
+            //clear dropped fields, so that growing again yields zeros
+            for(size_type i = n; i < n_; ++i) {
+                detail::store_bit_field<Bits>(bytes_.data(), i, 0);
+            }
+        }
+        bytes_.resize(byte_count(n), std::uint8_t(0));
+        n_ = n;
+    }
+
+    void
+    reserve(size_type n) {
+        bytes_.reserve(byte_count(n));
+    }
+
+    void
+    clear() noexcept {
+        n_ = 0;
+        bytes_.assign(padding, std::uint8_t(0));
+    }
+
+    /// @brief memory footprint of the elements in bytes
+    size_type
+    byte_size() const noexcept {
+        return bytes_.size();
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator [] (size_type i) const noexcept {
+        assert(i < n_);
+        return decode_code(detail::load_bit_field<Bits>(bytes_.data(), i));
+    }
+
+    reference
+    operator [] (size_type i) noexcept {
+        assert(i < n_);
+        return reference{bytes_.data(), i};
+    }
+
+    void
+    set(size_type i, const value_type& x) noexcept {
+        assert(i < n_);
+        detail::store_bit_field<Bits>(bytes_.data(), i, encode_code(x));
+    }
+
+    void
+    push_back(const value_type& x) {
+        resize(n_ + 1);
+        set(n_ - 1, x);
+    }
+
+
+    //---------------------------------------------------------------
+    const std::uint8_t*
+    data() const noexcept {
+        return bytes_.data();
+    }
+
+    std::uint8_t*
+    data() noexcept {
+        return bytes_.data();
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief largest storable finite value
+    static constexpr value_type
+    max() noexcept {
+        return value_type{numeric_type(max_code)};
+    }
+
+    static constexpr std::uint32_t infinity_code =
+        (std::uint32_t(1) << Bits) - 1;
+
+    static constexpr std::uint32_t max_code = infinity_code - 1;
+
+
+    //---------------------------------------------------------------
+    /// @brief raw natural value (negative: infinity) -> code
+    static std::uint32_t
+    encode_raw(numeric_type x) noexcept {
+        const auto c = (x > numeric_type(max_code))
+                     ? max_code : std::uint32_t(x);
+        return (x < numeric_type(0)) ? infinity_code : c;
+    }
+
+    /// @brief code -> raw natural value (negative: infinity)
+    static numeric_type
+    decode_raw(std::uint32_t c) noexcept {
+        return (c == infinity_code) ? numeric_type(-1) : numeric_type(c);
+    }
+
+    static std::uint32_t
+    encode_code(const value_type& x) noexcept {
+        return encode_raw(natural_array<IntT>::encode(x));
+    }
+
+    static value_type
+    decode_code(std::uint32_t c) noexcept {
+        return natural_array<IntT>::decode(decode_raw(c));
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    static constexpr size_type
+    byte_count(size_type n) noexcept {
+        return (n * size_type(Bits) + 7) / 8 + padding;
+    }
+
+    //---------------------------------------------------------------
+    size_type n_;
+    std::vector<std::uint8_t> bytes_;
+};
+
+
+
+
+//-------------------------------------------------------------------
+template<int Bits, class IntT>
+constexpr int packed_natural_array<Bits,IntT>::bits;
+
+template<int Bits, class IntT>
+constexpr std::size_t packed_natural_array<Bits,IntT>::padding;
+
+template<int Bits, class IntT>
+constexpr std::uint32_t packed_natural_array<Bits,IntT>::infinity_code;
+
+template<int Bits, class IntT>
+constexpr std::uint32_t packed_natural_array<Bits,IntT>::max_code;
+
+
+
+
+/*****************************************************************************
+ *
+ * BULK KERNELS
+ *
+ *****************************************************************************/
+/// @brief unpacks all elements; out is resized if necessary
+template<int Bits, class T>
+inline void
+decode(const packed_natural_array<Bits,T>& in, natural_array<T>& out)
+{
+    using pack_t = packed_natural_array<Bits,T>;
+
+    const auto n = in.size();
+    if(out.size() != n) out.resize(n);
+
+    const auto src = in.data();
+    auto dst = out.data();
+    for(std::size_t i = 0; i < n; ++i) {
+        dst[i] = pack_t::decode_raw(detail::load_bit_field<Bits>(src, i));
+    }
+}
+
+//---------------------------------------------------------
+/// @brief packs all elements; out is resized if necessary
+template<int Bits, class T>
+inline void
+encode(const natural_array<T>& in, packed_natural_array<Bits,T>& out)
+{
+    using pack_t = packed_natural_array<Bits,T>;
+
+    const auto n = in.size();
+    if(out.size() != n) out.resize(n);
+
+    const auto src = in.data();
+    auto dst = out.data();
+
+    if(Bits % 8 == 0) {
+        //byte-aligned fields don't overlap
+        for(std::size_t i = 0; i < n; ++i) {
+            const auto c = pack_t::encode_raw(src[i]);
+            for(int b = 0; b < Bits / 8; ++b) {
+                dst[i * (Bits / 8) + std::size_t(b)] = std::uint8_t(c >> (8 * b));
+            }
+        }
+        return;
+    }
+
+    //groups of 8 fields occupy exactly 'Bits' bytes and can be written
+    //without read-modify-write dependencies between neighbouring fields
+    const auto groups = n / 8;
+    for(std::size_t g = 0; g < groups; ++g) {
+        const auto s = src + g * 8;
+        auto d = dst + g * std::size_t(Bits);
+        std::uint64_t acc = 0;
+        int filled = 0;
+        for(int k = 0; k < 8; ++k) {
+            acc |= std::uint64_t(pack_t::encode_raw(s[k])) << filled;
+            filled += Bits;
+            for(; filled >= 8; filled -= 8) {
+                *d++ = std::uint8_t(acc);
+                acc >>= 8;
+            }
+        }
+    }
+    for(std::size_t i = groups * 8; i < n; ++i) {
+        detail::store_bit_field<Bits>(dst, i, pack_t::encode_raw(src[i]));
+    }
+}
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
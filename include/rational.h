@@ -13,10 +13,24 @@
 
 #include <cmath>
 #include <cfloat>
+#include <cassert>
+#include <limits>
 #include <vector>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+#include <stdexcept>
+#include <system_error>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <future>
 
 #include "constants.h"
 #include "equality.h"
+#include "gcd.h"
+#include "overflow.h"
 
 
 namespace am {
@@ -25,15 +39,109 @@ namespace num {
 
 /*************************************************************************//***
  *
- * @brief rational number class
+ * NORMALIZATION POLICIES
+ *
+ * determine when numerator and denominator of a rational are reduced
+ * by their greatest common divisor
+ *
+ *****************************************************************************/
+
+/// @brief never reduces automatically; call normalize() explicitly
+struct no_normalization
+{
+    static constexpr bool eager = false;
+    static constexpr bool check_overflow = false;
+
+    template<class T>
+    static constexpr bool
+    required(const T&, const T&) noexcept {
+        return false;
+    }
+};
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief keeps numerator and denominator coprime after every operation
+ *
+ * Products and quotients cancel crosswise (gcd(n1,d2), gcd(n2,d1))
+ * before multiplying and sums only divide by the gcd of the denominators,
+ * so intermediate results never grow larger than necessary.
+ */
+struct eager_normalization
+{
+    static constexpr bool eager = true;
+    static constexpr bool check_overflow = false;
+
+    template<class T>
+    static constexpr bool
+    required(const T&, const T&) noexcept {
+        return true;
+    }
+};
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief reduces only when the magnitude of the numerator or
+ *        the denominator reaches 2^bits
+ *
+ * Amortizes the cost of the gcd over many operations in long
+ * accumulation loops while keeping the values well away from overflow.
+ */
+template<int bits>
+struct threshold_normalization
+{
+    static_assert(bits > 0, "threshold_normalization: bits must be positive");
+
+    static constexpr bool eager = false;
+    static constexpr bool check_overflow = false;
+
+    template<class T>
+    static constexpr bool
+    required(const T& n, const T& d) noexcept {
+        return (bits < std::numeric_limits<T>::digits) &&
+               ((d >= limit<T>()) || (n >= limit<T>()) || (n <= -limit<T>()));
+    }
+
+private:
+    template<class T>
+    static constexpr T
+    limit() noexcept {
+        return T(T(1) << ((bits < std::numeric_limits<T>::digits) ? bits : 0));
+    }
+};
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief adds overflow detection to a normalization policy
  *
- * @tparam IntT type of numerator and denominator
+ * Operations run in the native integer type as long as no intermediate
+ * result overflows. Otherwise the exact result is computed in an integer
+ * type of twice the width, reduced and narrowed again.
+ * Throws std::overflow_error if the reduced result still doesn't fit.
+ */
+template<class NormalizationPolicy = no_normalization>
+struct overflow_checked : public NormalizationPolicy
+{
+    static constexpr bool check_overflow = true;
+};
+
+
+
+
+/*************************************************************************//***
  *
+ * @brief rational number class
  *
- * TODO include auto-normalizing mechanism (enabled by 2nd template parameter)
+ * @tparam IntT                 type of numerator and denominator
+ * @tparam NormalizationPolicy  no_normalization, eager_normalization
+ *                              or threshold_normalization<bits>
+ *                              (optionally wrapped in overflow_checked<>)
  *
  *****************************************************************************/
-template<class IntT>
+template<class IntT, class NormalizationPolicy = no_normalization>
 class rational
 {
     static_assert(is_integral<IntT>::value,
@@ -43,6 +151,16 @@ public:
     //---------------------------------------------------------------
     using value_type   = IntT;
     using numeric_type = value_type;
+    using normalization_policy = NormalizationPolicy;
+
+private:
+    //overflow checks only make sense for builtin integers
+    static constexpr bool checked = normalization_policy::check_overflow &&
+                                    std::is_integral<value_type>::value;
+
+    using wide_type = detail::wider_integer_t<value_type>;
+
+public:
 
 
     //---------------------------------------------------------------
@@ -57,7 +175,17 @@ public:
     constexpr
     rational(value_type numerator, value_type denominator):
         n_(std::move(numerator)), d_(std::move(denominator))
-    {}
+    {
+        apply_policy();
+    }
+
+    template<class T, class P>
+    explicit constexpr
+    rational(const rational<T,P>& o):
+        n_(value_type(o.numer())), d_(value_type(o.denom()))
+    {
+        if(!std::is_same<P,normalization_policy>::value) apply_policy();
+    }
 
     constexpr
     rational(const rational&) = default;
@@ -77,7 +205,7 @@ public:
     operator = (const value_type& n)
     {
         n_ = n;
-        d_ = value_type(0);
+        d_ = value_type(1);
         return *this;
     }
 
@@ -123,28 +251,56 @@ public:
     rational&
     operator += (const value_type& v)
     {
-        n_ += (v * d_);
+        if(checked) {
+            add_checked(v, value_type(1));
+        } else {
+            //gcd(n + v*d, d) = gcd(n, d)
+            n_ += (v * d_);
+            if(!normalization_policy::eager) apply_policy();
+        }
         return *this;
     }
     
     rational&
     operator -= (const value_type& v)
     {
-        n_ -= (v * d_);
+        if(checked) {
+            add_checked(value_type(-v), value_type(1));
+        } else {
+            n_ -= (v * d_);
+            if(!normalization_policy::eager) apply_policy();
+        }
         return *this;
     }
 
     rational&
     operator *= (const value_type& v)
     {
-        n_ *= v;
+        if(checked) {
+            multiply_checked(v, value_type(1));
+        }
+        else if(normalization_policy::eager) {
+            multiply_reduced(v, value_type(1));
+        } else {
+            n_ *= v;
+            apply_policy();
+        }
         return *this;
     }
 
     rational&
     operator /= (const value_type& v)
     {
-        d_ *= v;
+        if(checked) {
+            multiply_checked(value_type(1), v);
+        }
+        else if(normalization_policy::eager) {
+            multiply_reduced(value_type(1), v);
+        } else {
+            d_ *= v;
+            fix_sign();
+            apply_policy();
+        }
         return *this;
     }
 
@@ -152,14 +308,12 @@ public:
     //---------------------------------------------------------------
     rational&
     operator ++ () {
-        n_ += d_;
-        return *this;
+        return (*this += value_type(1));
     }
 
     rational&
     operator -- () {
-        n_ -= d_;
-        return *this;
+        return (*this -= value_type(1));
     }
 
     rational
@@ -181,41 +335,76 @@ public:
     rational&
     operator += (const rational& o)
     {
-        n_ = n_ * o.denom() + o.numer() * d_;
-        d_ *= o.denom();
+        if(checked) {
+            add_checked(o.numer(), o.denom());
+        }
+        else if(normalization_policy::eager) {
+            add_reduced(o.numer(), o.denom());
+        } else {
+            n_ = value_type(n_ * o.denom() + o.numer() * d_);
+            d_ *= o.denom();
+            apply_policy();
+        }
         return *this;
     }
 
     rational&
     operator -= (const rational& o)
     {
-        n_ = n_ * o.denom() - o.numer() * d_;
-        d_ *= o.denom();
+        if(checked) {
+            add_checked(value_type(-o.numer()), o.denom());
+        }
+        else if(normalization_policy::eager) {
+            add_reduced(value_type(-o.numer()), o.denom());
+        } else {
+            n_ = value_type(n_ * o.denom() - o.numer() * d_);
+            d_ *= o.denom();
+            apply_policy();
+        }
         return *this;
     }
 
     rational&
     operator *= (const rational& o)
     {
-        n_ *= o.numer();
-        d_ *= o.denom();
+        if(checked) {
+            multiply_checked(o.numer(), o.denom());
+        }
+        else if(normalization_policy::eager) {
+            multiply_reduced(o.numer(), o.denom());
+        } else {
+            n_ *= o.numer();
+            d_ *= o.denom();
+            apply_policy();
+        }
         return *this;
     }
     
     rational&
     operator /= (const rational& o)
     {
-        n_ *= o.denom();
-        d_ *= o.numer();
+        if(checked) {
+            multiply_checked(o.denom(), o.numer());
+        }
+        else if(normalization_policy::eager) {
+            multiply_reduced(o.denom(), o.numer());
+        } else {
+            n_ *= o.denom();
+            d_ *= o.numer();
+            fix_sign();
+            apply_policy();
+        }
         return *this;
     }
 
 
     //---------------------------------------------------------------
-    void
+    /// @brief divides numerator and denominator by their gcd
+    ///        and makes the denominator positive
+    constexpr void
     normalize() {
-        using std::abs;
-        const value_type x = gcd(value_type(abs(n_)), d_);
+        fix_sign();
+        const value_type x = gcd(abs_(n_), d_);
         if(x > value_type(1)) {
             n_ = value_type(n_ / x);
             d_ = value_type(d_ / x);
@@ -225,14 +414,151 @@ public:
 
 private:
     //---------------------------------------------------------------
-    static value_type
-    gcd(value_type a, value_type b) {
-        while(b > value_type(0)) {
-            const auto m = value_type(a % b);
-            a = b;
-            b = m;
+    static constexpr value_type
+    abs_(const value_type& x) {
+        return (x < value_type(0)) ? value_type(-x) : x;
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr void
+    fix_sign() {
+        if(d_ < value_type(0)) {
+            n_ = value_type(-n_);
+            d_ = value_type(-d_);
+        }
+    }
+
+    //---------------------------------------------------------------
+    constexpr void
+    apply_policy() {
+        if(normalization_policy::required(n_, d_)) normalize();
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief *this += n/d; expects both operands to be normalized
+    void
+    add_reduced(const value_type& n, const value_type& d)
+    {
+        const value_type g = gcd(d_, d);
+        if(g == value_type(1)) {
+            n_ = value_type(n_ * d + n * d_);
+            d_ *= d;
+        }
+        else {
+            const value_type dg = value_type(d_ / g);
+            const value_type t = value_type(n_ * value_type(d / g) + n * dg);
+            const value_type g2 = gcd(abs_(t), g);
+            n_ = value_type(t / g2);
+            d_ = dg * value_type(d / g2);
+        }
+        if(n_ == value_type(0)) d_ = value_type(1);
+    }
+
+    //---------------------------------------------------------------
+    /// @brief *this *= n/d with cross-cancellation;
+    ///        expects both operands to be normalized
+    void
+    multiply_reduced(const value_type& n, const value_type& d)
+    {
+        if(n_ == value_type(0) || n == value_type(0)) {
+            n_ = value_type(0);
+            d_ = value_type((d == value_type(0)) ? 0 : 1);
+            return;
+        }
+        const value_type g1 = gcd(abs_(n_), abs_(d));
+        const value_type g2 = gcd(abs_(n), d_);
+        n_ = value_type(n_ / g1) * value_type(n / g2);
+        d_ = value_type(d_ / g2) * value_type(d / g1);
+        fix_sign();
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief *this += n/d; widens on overflow
+    void
+    add_checked(const value_type& n, const value_type& d)
+    {
+        value_type a, b, sum, den;
+        if(detail::mul_overflow(n_, d, a) || detail::mul_overflow(n, d_, b) ||
+           detail::add_overflow(a, b, sum) || detail::mul_overflow(d_, d, den))
+        {
+            assign_wide(n, d, [](const auto& n1, const auto& d1,
+                                 const auto& n2, const auto& d2)
+            {
+                return std::make_pair(n1 * d2 + n2 * d1, d1 * d2);
+            });
+        } else {
+            n_ = sum;
+            d_ = den;
+            apply_policy();
+        }
+    }
+
+    //---------------------------------------------------------------
+    /// @brief *this *= n/d; widens on overflow
+    void
+    multiply_checked(const value_type& n, const value_type& d)
+    {
+        value_type num, den;
+        if(detail::mul_overflow(n_, n, num) || detail::mul_overflow(d_, d, den))
+        {
+            assign_wide(n, d, [](const auto& n1, const auto& d1,
+                                 const auto& n2, const auto& d2)
+            {
+                return std::make_pair(n1 * n2, d1 * d2);
+            });
+        } else {
+            n_ = num;
+            d_ = den;
+            fix_sign();
+            apply_policy();
+        }
+    }
+
+    //---------------------------------------------------------------
+    /// @brief evaluates f in the wider type, reduces and narrows the result
+    template<class F>
+    void
+    assign_wide(const value_type& n, const value_type& d, F&& f)
+    {
+        assign_wide(n, d, std::forward<F>(f),
+            std::integral_constant<bool,!std::is_void<wide_type>::value>{});
+    }
+
+    template<class F>
+    void
+    assign_wide(const value_type& n, const value_type& d, F&& f,
+                std::true_type)
+    {
+        using w_t = wide_type;
+        using lim = std::numeric_limits<value_type>;
+
+        auto r = f(w_t(n_), w_t(d_), w_t(n), w_t(d));
+        if(r.second < w_t(0)) {
+            r.first = -r.first;
+            r.second = -r.second;
+        }
+        const w_t g = gcd(r.first, r.second);
+        if(g > w_t(1)) {
+            r.first /= g;
+            r.second /= g;
         }
-        return a;
+        if(r.first  < w_t(lim::min()) || r.first  > w_t(lim::max()) ||
+           r.second > w_t(lim::max()))
+        {
+            throw std::overflow_error{"rational: result not representable"};
+        }
+        n_ = value_type(r.first);
+        d_ = value_type(r.second);
+    }
+
+    template<class F>
+    void
+    assign_wide(const value_type&, const value_type&, F&&, std::false_type)
+    {
+        throw std::overflow_error{"rational: integer overflow"};
     }
 
 
@@ -330,12 +656,342 @@ make_rational(const T& f)
 
 
 
+//-------------------------------------------------------------------
+/**
+ * @brief closest fraction p/q to x with 1 <= q <= max_denominator
+ *
+ * Walks the continued fraction expansion of x until the denominator of
+ * the next convergent would exceed the limit and then picks the better
+ * one of the last convergent and the largest admissible semiconvergent.
+ * Takes O(log(max_denominator)) steps.
+ * Values beyond the range of IntT are clamped.
+ */
+template<class IntT, class FpT, class = std::enable_if_t<
+    std::is_integral<IntT>::value && is_floating_point<FpT>::value>>
+rational<IntT>
+best_rational(const FpT& x, const IntT& max_denominator)
+{
+    using std::floor;
+    using std::abs;
+    using lim = std::numeric_limits<IntT>;
+
+    assert(max_denominator >= IntT(1));
+
+    const bool negative = x < FpT(0);
+    const FpT ax = negative ? -x : x;
+
+    //convergents p0/q0, p1/q1
+    IntT p0 = IntT(0), q0 = IntT(1);
+    IntT p1 = IntT(1), q1 = IntT(0);
+
+    FpT y = ax;
+    while(true) {
+        const FpT fa = floor(y);
+        if(!(fa < FpT(lim::max()))) break;
+        const auto a = IntT(fa);
+
+        IntT p2, q2;
+        if(detail::mul_overflow(a, q1, q2) || detail::add_overflow(q2, q0, q2) ||
+           q2 > max_denominator ||
+           detail::mul_overflow(a, p1, p2) || detail::add_overflow(p2, p0, p2))
+        {
+            break;
+        }
+        p0 = p1; q0 = q1;
+        p1 = p2; q1 = q2;
+
+        const FpT f = y - fa;
+        if(f == FpT(0)) break;
+        y = FpT(1) / f;
+    }
+
+    if(q1 == IntT(0)) {
+        return rational<IntT>{negative ? lim::lowest() : lim::max()};
+    }
+
+    //largest admissible semiconvergent (p0 + k*p1) / (q0 + k*q1)
+    const auto k = IntT((max_denominator - q0) / q1);
+    IntT ps, qs;
+    if(!detail::mul_overflow(k, p1, ps) && !detail::add_overflow(ps, p0, ps) &&
+       !detail::mul_overflow(k, q1, qs) && !detail::add_overflow(qs, q0, qs))
+    {
+        using ld_t = long double;
+        const auto ex = ld_t(ax);
+        if(abs(ex - ld_t(ps) / ld_t(qs)) < abs(ex - ld_t(p1) / ld_t(q1))) {
+            p1 = ps;
+            q1 = qs;
+        }
+    }
+
+    return rational<IntT>{negative ? IntT(-p1) : p1, q1};
+}
+
+//---------------------------------------------------------
+/// @brief best_rational for all values in [first,last)
+template<class InputIter, class OutputIter, class IntT>
+inline OutputIter
+best_rational(InputIter first, InputIter last, OutputIter out,
+              const IntT& max_denominator)
+{
+    for(; first != last; ++first, ++out) {
+        *out = best_rational(*first, max_denominator);
+    }
+    return out;
+}
+
+
+
+//-------------------------------------------------------------------
+namespace detail {
+
+template<class T>
+inline T
+sum_multiply(const T& a, const T& b, std::true_type /* checked */)
+{
+    T r;
+    if(mul_overflow(a, b, r)) {
+        throw std::overflow_error{"rational_sum: integer overflow"};
+    }
+    return r;
+}
+
+template<class T>
+inline T
+sum_multiply(const T& a, const T& b, std::false_type)
+{
+    return T(a * b);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline T
+sum_add(const T& a, const T& b, std::true_type /* checked */)
+{
+    T r;
+    if(add_overflow(a, b, r)) {
+        throw std::overflow_error{"rational_sum: integer overflow"};
+    }
+    return r;
+}
+
+template<class T>
+inline T
+sum_add(const T& a, const T& b, std::false_type)
+{
+    return T(a + b);
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief unreduced partial sum n/d of a rational sequence
+ *
+ * The denominator is always the lcm of all denominators added so far,
+ * so adding only costs one gcd of denominators and no normalization.
+ */
+template<class T, class Checked>
+struct rational_partial_sum
+{
+    T n = T(0);
+    T d = T(1);
+
+    /// @brief expects d2 > 0
+    void add(const T& n2, const T& d2) {
+        const T g = gcd(d, d2);
+        const T f1 = d2 / g;
+        const T f2 = d / g;
+        n = sum_add(sum_multiply(n, f1, Checked{}),
+                    sum_multiply(n2, f2, Checked{}), Checked{});
+        d = sum_multiply(d, f1, Checked{});
+    }
+
+    void add(const rational_partial_sum& o) {
+        add(o.n, o.d);
+    }
+};
+
+
+//-------------------------------------------------------------------
+/// @brief partial sum type for a rational type
+template<class Rational>
+struct rational_sum_traits
+{
+    using int_t = typename Rational::value_type;
+    using policy = typename Rational::normalization_policy;
+    using checked = std::integral_constant<bool,
+        policy::check_overflow && std::is_integral<int_t>::value>;
+    using partial = rational_partial_sum<int_t,checked>;
+};
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief combines partial sums pairwise in a balanced tree
+ *
+ * Keeps a stack of sums with their tree level; levels strictly decrease.
+ */
+template<class Partial>
+class rational_tree_sum
+{
+public:
+    void push(Partial p) {
+        int level = 0;
+        while(!stack_.empty() && stack_.back().second == level) {
+            stack_.back().first.add(p);
+            p = std::move(stack_.back().first);
+            stack_.pop_back();
+            ++level;
+        }
+        stack_.emplace_back(std::move(p), level);
+    }
+
+    bool empty() const noexcept { return stack_.empty(); }
+
+    /// @brief expects !empty()
+    Partial& result() {
+        assert(!stack_.empty());
+        auto& s = stack_.back().first;
+        for(auto i = stack_.size() - 1; i > 0; --i) {
+            s.add(stack_[i-1].first);
+        }
+        return s;
+    }
+
+private:
+    std::vector<std::pair<Partial,int>> stack_;
+};
+
+
+//-------------------------------------------------------------------
+/// @brief sums blocks of consecutive elements into tree
+template<class InputIter, class Partial>
+void
+rational_sum_blocks(InputIter first, InputIter last,
+                    rational_tree_sum<Partial>& tree)
+{
+    using rat_t = typename std::iterator_traits<InputIter>::value_type;
+    using int_t = typename rational_sum_traits<rat_t>::int_t;
+
+    constexpr int block_size = 16;
+
+    while(first != last) {
+        Partial p;
+        for(int i = 0; i < block_size && first != last; ++i, ++first) {
+            const auto& x = *first;
+            if(x.denom() < int_t(0)) {
+                p.add(int_t(-x.numer()), int_t(-x.denom()));
+            } else {
+                p.add(x.numer(), x.denom());
+            }
+        }
+        tree.push(std::move(p));
+    }
+}
+
+
+//-------------------------------------------------------------------
+/// @brief normalized total of tree
+template<class Rational, class Partial>
+Rational
+rational_sum_result(rational_tree_sum<Partial>& tree)
+{
+    using int_t = typename rational_sum_traits<Rational>::int_t;
+
+    if(tree.empty()) return Rational{int_t(0)};
+
+    auto& s = tree.result();
+    Rational r {std::move(s.n), std::move(s.d)};
+    r.normalize();
+    return r;
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief exact sum of all rationals in [first,last)
+ *
+ * Accumulates over the lcm of the denominators instead of their product.
+ * Blocks of consecutive elements are summed up first and the block sums
+ * are combined pairwise in a balanced tree, so that the partial sums
+ * stay small for long sequences. Only the final result is normalized.
+ *
+ * Throws std::overflow_error for builtin integers if the normalization
+ * policy checks overflows.
+ */
+template<class InputIter>
+auto
+rational_sum(InputIter first, InputIter last)
+{
+    using rat_t = typename std::iterator_traits<InputIter>::value_type;
+    using partial = typename detail::rational_sum_traits<rat_t>::partial;
+
+    detail::rational_tree_sum<partial> tree;
+    detail::rational_sum_blocks(first, last, tree);
+    return detail::rational_sum_result<rat_t>(tree);
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief exact sum of all rationals in [first,last) using up to
+ *        'threads' threads
+ *
+ * The range is split into one chunk per thread; the chunk sums are
+ * computed with std::async and merged in the same balanced tree as
+ * the block sums. Exceptions (e.g. std::overflow_error) are propagated.
+ */
+template<class RandomAccessIter>
+auto
+rational_sum(RandomAccessIter first, RandomAccessIter last, std::size_t threads)
+{
+    static_assert(std::is_base_of<std::random_access_iterator_tag,
+        typename std::iterator_traits<RandomAccessIter>::iterator_category>::value,
+        "rational_sum: parallel summation requires random access iterators");
+
+    using rat_t = typename std::iterator_traits<RandomAccessIter>::value_type;
+    using partial = typename detail::rational_sum_traits<rat_t>::partial;
+    using tree_t = detail::rational_tree_sum<partial>;
+
+    assert(threads > 0);
+
+    //chunks are multiples of 16 (the block size), at least 1024 elements
+    const auto n = std::size_t(std::distance(first, last));
+    auto chunk = (n + threads - 1) / threads;
+    chunk = std::max(std::size_t(1024), (chunk + 15) / 16 * 16);
+
+    if(threads < 2 || n <= chunk) return rational_sum(first, last);
+
+    const auto chunk_sum = [](RandomAccessIter b, RandomAccessIter e) {
+        tree_t t;
+        detail::rational_sum_blocks(b, e, t);
+        return std::move(t.result());
+    };
+
+    using diff_t = typename std::iterator_traits<RandomAccessIter>::difference_type;
+    std::vector<std::future<partial>> chunks;
+    for(auto i = chunk; i < n; i += chunk) {
+        chunks.push_back(std::async(std::launch::async, chunk_sum,
+            first + diff_t(i), first + diff_t(std::min(i + chunk, n))));
+    }
+
+    tree_t tree;
+    tree.push(chunk_sum(first, first + diff_t(chunk)));
+    for(auto& f : chunks) tree.push(f.get());
+
+    return detail::rational_sum_result<rat_t>(tree);
+}
+
+
+
 //-------------------------------------------------------------------
 // I/O
 //-------------------------------------------------------------------
-template<class Istream, class T>
+template<class Istream, class T, class P>
 inline Istream&
-operator >> (Istream& is, rational<T>& x)
+operator >> (Istream& is, rational<T,P>& x)
 {
     is.clear();
 
@@ -353,52 +1009,327 @@ operator >> (Istream& is, rational<T>& x)
             is.clear(is.rdstate() | std::ios::badbit);
         }
     }
-    x = rational<T>{numer,denom};
+    x = rational<T,P>{numer,denom};
     return is;
 }
 
 //---------------------------------------------------------
-template<class Ostream, class T>
+template<class Ostream, class T, class P>
 inline Ostream&
-operator << (Ostream& os, const rational<T>& x)
+operator << (Ostream& os, const rational<T,P>& x)
 {
     return (os << x.numer() << " " << x.denom() );
 }
 
 //---------------------------------------------------------
-template<class T, class Ostream>
+template<class T, class P, class Ostream>
 inline Ostream&
-print(Ostream& os, const rational<T>& d)
+print(Ostream& os, const rational<T,P>& d)
 {
     return (os << d.numer() << "/" << d.denom());
 }
 
 
 
+//-------------------------------------------------------------------
+// CHARACTER CONVERSION (std::from_chars / std::to_chars style)
+//-------------------------------------------------------------------
+struct rational_from_chars_result
+{
+    const char* ptr;
+    std::errc ec;
+};
+
+struct rational_to_chars_result
+{
+    char* ptr;
+    std::errc ec;
+};
+
+
+namespace detail {
+
+inline constexpr bool
+is_decimal_digit(char c) noexcept
+{
+    return c >= '0' && c <= '9';
+}
+
+//---------------------------------------------------------
+/// @brief number of decimal digits that are processed at once
+template<class T>
+inline constexpr int
+decimal_chunk_digits() noexcept
+{
+    return (std::numeric_limits<T>::digits10 < 18)
+        ? std::numeric_limits<T>::digits10 : 18;
+}
+
+//---------------------------------------------------------
+/**
+ * @brief value = value * 10^k +/- digits for the run of k digits at p;
+ *        consumes all digits even after an overflow
+ * @return end of digit run
+ */
+template<class T>
+const char*
+accumulate_digits(const char* p, const char* last, bool negative,
+                  T& value, int& count, bool& overflow)
+{
+    while(p != last && is_decimal_digit(*p)) {
+        std::uint64_t chunk = 0;
+        std::uint64_t scale = 1;
+        for(int k = 0; k < decimal_chunk_digits<T>() &&
+                       p != last && is_decimal_digit(*p); ++k, ++p)
+        {
+            chunk = chunk * 10 + std::uint64_t(*p - '0');
+            scale *= 10;
+            ++count;
+        }
+        if(!overflow) {
+            T t;
+            overflow = mul_overflow(value, T(scale), t) ||
+                (negative ? sub_overflow(t, T(chunk), value)
+                          : add_overflow(t, T(chunk), value));
+        }
+    }
+    return p;
+}
+
+//---------------------------------------------------------
+/// @brief x *= 10^e; returns true on overflow
+template<class T>
+bool
+multiply_pow10(T& x, int e)
+{
+    while(e > 0) {
+        const int k = (e < decimal_chunk_digits<T>())
+                    ? e : decimal_chunk_digits<T>();
+        std::uint64_t s = 1;
+        for(int i = 0; i < k; ++i) s *= 10;
+        if(mul_overflow(x, T(s), x)) return true;
+        e -= k;
+    }
+    return false;
+}
+
+
+//---------------------------------------------------------
+/// @return end of written characters; nullptr if [first,last) is too small
+template<class T>
+char*
+integer_to_chars(char* first, char* last, const T& x, std::true_type /*builtin*/)
+{
+    char buf[std::numeric_limits<T>::digits10 + 2];
+    char* const end = buf + sizeof(buf);
+    char* b = end;
+
+    auto u = unsigned_abs(x);
+    do {
+        *--b = char('0' + u % 10);
+        u /= 10;
+    } while(u != 0);
+    if(x < T(0)) *--b = '-';
+
+    if(last - first < end - b) return nullptr;
+    return std::copy(b, end, first);
+}
+
+template<class T>
+char*
+integer_to_chars(char* first, char* last, const T& x, std::false_type)
+{
+    using std::to_string;
+    const auto str = to_string(x);
+    if(last - first < std::ptrdiff_t(str.size())) return nullptr;
+    return std::copy(str.begin(), str.end(), first);
+}
+
+//---------------------------------------------------------
+inline constexpr bool
+is_rational_separator(char c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+           c == ',' || c == ';';
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief parses a rational number from [first,last) like std::from_chars
+ *
+ * Accepted forms (no leading whitespace, optional leading '-'):
+ *   integer             "-42"
+ *   fraction            "3/4"     (denominator: digits only, non-zero)
+ *   decimal             "-1.25", ".5", "2.5e-3"   (converted exactly)
+ *
+ * The normalization policy of the target type decides whether
+ * the result is reduced ("2/4" and "0.50" are kept as 2/4 and 50/100
+ * by default).
+ *
+ * @return ptr: first character not matching the pattern;
+ *         ec:  std::errc::invalid_argument if there is no match,
+ *              std::errc::result_out_of_range if the value doesn't fit
+ *         value is only modified on success
+ */
+template<class T, class P>
+rational_from_chars_result
+parse_rational(const char* first, const char* last, rational<T,P>& value)
+{
+    using detail::is_decimal_digit;
+    using detail::accumulate_digits;
+
+    const char* p = first;
+    const bool negative = (p != last && *p == '-');
+    if(negative) ++p;
+
+    if(p == last || !(is_decimal_digit(*p) ||
+       (*p == '.' && p+1 != last && is_decimal_digit(p[1]))))
+    {
+        return {first, std::errc::invalid_argument};
+    }
+
+    bool overflow = false;
+    int count = 0;
+    T n {0};
+    T d {1};
+    p = accumulate_digits(p, last, negative, n, count, overflow);
+
+    if(p != last && *p == '/') {
+        if(p+1 != last && is_decimal_digit(p[1])) {
+            d = T(0);
+            p = accumulate_digits(p+1, last, false, d, count, overflow);
+            if(!overflow && d == T(0)) {
+                return {first, std::errc::invalid_argument};
+            }
+        }
+    }
+    else {
+        //value = n * 10^(-scale)
+        int scale = 0;
+        if(p != last && *p == '.') {
+            p = accumulate_digits(p+1, last, negative, n, scale, overflow);
+        }
+        if(p != last && (*p == 'e' || *p == 'E')) {
+            const char* q = p+1;
+            const bool eneg = (q != last && *q == '-');
+            if(q != last && (*q == '-' || *q == '+')) ++q;
+            if(q != last && is_decimal_digit(*q)) {
+                int e = 0;
+                for(; q != last && is_decimal_digit(*q); ++q) {
+                    if(e < 100000) e = e * 10 + (*q - '0');
+                }
+                scale += eneg ? e : -e;
+                p = q;
+            }
+        }
+        if(!overflow) {
+            overflow = (scale > 0)
+                ? detail::multiply_pow10(d, scale)
+                : (n != T(0) && detail::multiply_pow10(n, -scale));
+        }
+    }
+
+    if(overflow) return {p, std::errc::result_out_of_range};
+
+    value = rational<T,P>{std::move(n), std::move(d)};
+    return {p, std::errc{}};
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief parses all rationals in [first,last) that are separated by
+ *        whitespace, ',' or ';' and appends them to 'out'
+ *
+ * @return ptr: end of input or position of the first invalid token;
+ *         ec:  error of the first invalid token
+ */
+template<class T, class P>
+rational_from_chars_result
+parse_rationals(const char* first, const char* last,
+                std::vector<rational<T,P>>& out)
+{
+    using detail::is_rational_separator;
+
+    while(true) {
+        while(first != last && is_rational_separator(*first)) ++first;
+        if(first == last) return {last, std::errc{}};
+
+        rational<T,P> x;
+        const auto r = parse_rational(first, last, x);
+        if(r.ec != std::errc{}) return r;
+        if(r.ptr != last && !is_rational_separator(*r.ptr)) {
+            return {r.ptr, std::errc::invalid_argument};
+        }
+        out.push_back(std::move(x));
+        first = r.ptr;
+    }
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief writes "n/d" (or just "n" if d is 1) to [first,last)
+ *        like std::to_chars; the sign is always written to the numerator
+ *
+ * @return ptr: one past the last written character;
+ *         ec:  std::errc::value_too_large if the buffer is too small
+ *              (ptr == last then)
+ */
+template<class T, class P>
+rational_to_chars_result
+to_chars(char* first, char* last, const rational<T,P>& x)
+{
+    if(x.denom() < T(0)) {
+        return to_chars(first, last,
+                        rational<T,P>{T(-x.numer()), T(-x.denom())});
+    }
+
+    using builtin = std::integral_constant<bool,std::is_integral<T>::value>;
+
+    char* p = detail::integer_to_chars(first, last, x.numer(), builtin{});
+    if(p && x.denom() != T(1)) {
+        if(p == last) {
+            p = nullptr;
+        } else {
+            *p++ = '/';
+            p = detail::integer_to_chars(p, last, x.denom(), builtin{});
+        }
+    }
+    if(!p) return {last, std::errc::value_too_large};
+    return {p, std::errc{}};
+}
+
+
+
 
 /*****************************************************************************
  *
  * ACCESS
  *
  *****************************************************************************/
-template<class T>
+template<class T, class P>
 inline decltype(auto)
-numer(const rational<T>& x) noexcept 
+numer(const rational<T,P>& x) noexcept 
 {
     return x.numer();
 }
 
-template<class T>
+template<class T, class P>
 inline decltype(auto)
-denom(const rational<T>& x) noexcept 
+denom(const rational<T,P>& x) noexcept 
 {
     return x.denom();
 }
 
 /// @brief whole parts
-template<class T>
+template<class T, class P>
 inline auto 
-wholes(const rational<T>& x)
+wholes(const rational<T,P>& x)
 {
     using std::floor;
     return static_cast<T>(floor(static_cast<real_t>(x)));
@@ -407,9 +1338,9 @@ wholes(const rational<T>& x)
 
 //-------------------------------------------------------------------
 /// @brief
-template<class T>
+template<class T, class P>
 inline auto
-normalized(rational<T> x)
+normalized(rational<T,P> x)
 {
     x.normalize();
     return x;
@@ -418,13 +1349,13 @@ normalized(rational<T> x)
 
 //-------------------------------------------------------------------
 /// @brief
-template<class T>
+template<class T, class P>
 inline constexpr auto
-reciprocal(const rational<T>& x)
+reciprocal(const rational<T,P>& x)
 {
     return (x.numer() < T(0))
-        ? rational<T>{-x.denom(), -x.numer()}
-        : rational<T>{x.denom(), x.numer()};
+        ? rational<T,P>{-x.denom(), -x.numer()}
+        : rational<T,P>{x.denom(), x.numer()};
 }
 
 
@@ -434,42 +1365,139 @@ reciprocal(const rational<T>& x)
  *
  * COMPARISON
  *
+ * Cross products are computed natively as long as they don't overflow;
+ * otherwise in an integer type of twice the width or - if there is
+ * none - by comparing continued fraction expansions.
+ * Denominators are expected to be positive.
+ *
  *****************************************************************************/
-template<class T1, class T2>
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief sign of a/b - c/d without multiplication; b, d > 0
+template<class T>
+int
+compare_fractions_cf(T a, T b, T c, T d)
+{
+    //compare floor quotients; on tie compare the reciprocals
+    //of the remainders (with swapped roles)
+    for(int sign = 1; ; sign = -sign) {
+        T q1 = T(a / b), r1 = T(a % b);
+        if(r1 < T(0)) { --q1; r1 = T(r1 + b); }
+        T q2 = T(c / d), r2 = T(c % d);
+        if(r2 < T(0)) { --q2; r2 = T(r2 + d); }
+
+        if(q1 != q2) return (q1 < q2) ? -sign : sign;
+        if(r1 == T(0)) return (r2 == T(0)) ? 0 : -sign;
+        if(r2 == T(0)) return sign;
+
+        //r1/b < r2/d  <=>  b/r1 > d/r2
+        a = b; b = r1;
+        c = d; d = r2;
+    }
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline int
+compare_fractions_wide(const T& a, const T& b, const T& c, const T& d,
+                       std::true_type)
+{
+    using w_t = wider_integer_t<T>;
+    const auto l = w_t(a) * w_t(d);
+    const auto r = w_t(c) * w_t(b);
+    return (l < r) ? -1 : ((r < l) ? 1 : 0);
+}
+
+template<class T>
+inline int
+compare_fractions_wide(const T& a, const T& b, const T& c, const T& d,
+                       std::false_type)
+{
+    return compare_fractions_cf(a, b, c, d);
+}
+
+
+//-------------------------------------------------------------------
+/// @brief sign of a/b - c/d; b, d > 0
+template<class T>
+inline int
+compare_fractions(const T& a, const T& b, const T& c, const T& d,
+                  std::true_type /* builtin integer */)
+{
+    T l, r;
+    if(!mul_overflow(a, d, l) && !mul_overflow(c, b, r)) {
+        return (l < r) ? -1 : ((r < l) ? 1 : 0);
+    }
+    return compare_fractions_wide(a, b, c, d,
+        std::integral_constant<bool,!std::is_void<wider_integer_t<T>>::value>{});
+}
+
+template<class T>
+inline int
+compare_fractions(const T& a, const T& b, const T& c, const T& d,
+                  std::false_type)
+{
+    const auto l = a * d;
+    const auto r = c * b;
+    return (l < r) ? -1 : ((r < l) ? 1 : 0);
+}
+
+
+//-------------------------------------------------------------------
+template<class T1, class T2, class T3, class T4>
+inline int
+compare_fractions(const T1& a, const T2& b, const T3& c, const T4& d)
+{
+    using T = common_numeric_t<T1,T2,T3,T4>;
+    return compare_fractions(T(a), T(b), T(c), T(d),
+        std::integral_constant<bool,std::is_integral<T>::value>{});
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+template<class T1, class P1, class T2, class P2>
 inline bool
-operator == (const rational<T1>& x, const rational<T2>& y)
+operator == (const rational<T1,P1>& x, const rational<T2,P2>& y)
 {
-    return ((x.numer() * y.denom()) == (y.numer() * x.denom()));
+    return (detail::compare_fractions(
+        x.numer(), x.denom(), y.numer(), y.denom()) == 0);
 }
 
-template<class T1, class T2>
+template<class T1, class P1, class T2, class P2>
 inline bool
-operator != (const rational<T1>& x, const rational<T2>& y)
+operator != (const rational<T1,P1>& x, const rational<T2,P2>& y)
 {
-    return ((x.numer() * y.denom()) != (y.numer() * x.denom()));
+    return (detail::compare_fractions(
+        x.numer(), x.denom(), y.numer(), y.denom()) != 0);
 }
 
 
-template<class T1, class T2, class T3 = common_numeric_t<T1,T2>>
+template<class T1, class P1, class T2, class P2,
+         class T3 = common_numeric_t<T1,T2>>
 inline constexpr bool
-approx_equal(const rational<T1>& a, const rational<T2>& b,
+approx_equal(const rational<T1,P1>& a, const rational<T2,P2>& b,
     const T3& tol = tolerance<T3>)
 {
     return approx_equal(a.numer() * b.denom(), b.numer() * a.denom(), tol);
 }
 
 
-template<class T>
+template<class T, class P>
 inline constexpr bool
-approx_1(const rational<T>& x, const T& tol = tolerance<T>)
+approx_1(const rational<T,P>& x, const T& tol = tolerance<T>)
 {
     return approx_1(real_t(x.numer()) / real_t(x.denom()), tol);
 }
 
 
-template<class T>
+template<class T, class P>
 inline constexpr bool
-approx_0(const rational<T>& x, const T& tol = tolerance<T>)
+approx_0(const rational<T,P>& x, const T& tol = tolerance<T>)
 {
     return approx_0(x.numer(), tol);
 }
@@ -479,32 +1507,36 @@ approx_0(const rational<T>& x, const T& tol = tolerance<T>)
 //-------------------------------------------------------------------
 // COMPARISON
 //-------------------------------------------------------------------
-template<class T1, class T2>
+template<class T1, class P1, class T2, class P2>
 inline bool
-operator > (const rational<T1>& x, const rational<T2>& y)
+operator > (const rational<T1,P1>& x, const rational<T2,P2>& y)
 {
-    return ((x.numer() * y.denom()) > (y.numer() * x.denom()));
+    return (detail::compare_fractions(
+        x.numer(), x.denom(), y.numer(), y.denom()) > 0);
 }
 
-template<class T1, class T2>
+template<class T1, class P1, class T2, class P2>
 inline bool
-operator >= (const rational<T1>& x, const rational<T2>& y)
+operator >= (const rational<T1,P1>& x, const rational<T2,P2>& y)
 {
-    return ((x.numer() * y.denom()) >= (y.numer() * x.denom()));
+    return (detail::compare_fractions(
+        x.numer(), x.denom(), y.numer(), y.denom()) >= 0);
 }
 
-template<class T1, class T2>
+template<class T1, class P1, class T2, class P2>
 inline bool
-operator < (const rational<T1>& x, const rational<T2>& y)
+operator < (const rational<T1,P1>& x, const rational<T2,P2>& y)
 {
-    return ((x.numer() * y.denom()) < (y.numer() * x.denom()));
+    return (detail::compare_fractions(
+        x.numer(), x.denom(), y.numer(), y.denom()) < 0);
 }
 
-template<class T1, class T2>
+template<class T1, class P1, class T2, class P2>
 inline bool
-operator <= (const rational<T1>& x, const rational<T2>& y)
+operator <= (const rational<T1,P1>& x, const rational<T2,P2>& y)
 {
-    return ((x.numer() * y.denom()) <= (y.numer() * x.denom()));
+    return (detail::compare_fractions(
+        x.numer(), x.denom(), y.numer(), y.denom()) <= 0);
 }
 
 
@@ -512,63 +1544,71 @@ operator <= (const rational<T1>& x, const rational<T2>& y)
 //-------------------------------------------------------------------
 // COMPARISON WITH PLAIN NUMBERS
 //-------------------------------------------------------------------
-template<class T1, class T2, class = std::enable_if_t<is_integral<T2>::value>>
+template<class T1, class P, class T2,
+         class = std::enable_if_t<is_integral<T2>::value>>
 inline bool
-operator > (const rational<T1>& x, const T2& r)
+operator > (const rational<T1,P>& x, const T2& r)
 {
-    return (x.numer() > (r * x.denom()));
+    return (detail::compare_fractions(x.numer(), x.denom(), r, T2(1)) > 0);
 }
 
-template<class T1, class T2, class = std::enable_if_t<is_integral<T2>::value>>
+template<class T1, class P, class T2,
+         class = std::enable_if_t<is_integral<T2>::value>>
 inline bool
-operator > (const T2& r, const rational<T1>& x)
+operator > (const T2& r, const rational<T1,P>& x)
 {
-    return (x.numer() > (r * x.denom()));
+    return (detail::compare_fractions(r, T2(1), x.numer(), x.denom()) > 0);
 }
 
 
-template<class T1, class T2, class = std::enable_if_t<is_integral<T2>::value>>
+template<class T1, class P, class T2,
+         class = std::enable_if_t<is_integral<T2>::value>>
 inline bool
-operator >= (const rational<T1>& x, const T2& r)
+operator >= (const rational<T1,P>& x, const T2& r)
 {
-    return (x.numer() >= (r * x.denom()));
+    return (detail::compare_fractions(x.numer(), x.denom(), r, T2(1)) >= 0);
 }
 
-template<class T1, class T2, class = std::enable_if_t<is_integral<T2>::value>>
+template<class T1, class P, class T2,
+         class = std::enable_if_t<is_integral<T2>::value>>
 inline bool
-operator >= (const T2& r, const rational<T1>& x)
+operator >= (const T2& r, const rational<T1,P>& x)
 {
-    return (x.numer() >= (r * x.denom()));
+    return (detail::compare_fractions(r, T2(1), x.numer(), x.denom()) >= 0);
 }
 
 
-template<class T1, class T2, class = std::enable_if_t<is_integral<T2>::value>>
+template<class T1, class P, class T2,
+         class = std::enable_if_t<is_integral<T2>::value>>
 inline bool
-operator < (const rational<T1>& x, const T2& r)
+operator < (const rational<T1,P>& x, const T2& r)
 {
-    return (x.numer() < (r * x.denom()));
+    return (detail::compare_fractions(x.numer(), x.denom(), r, T2(1)) < 0);
 }
 
-template<class T1, class T2, class = std::enable_if_t<is_integral<T2>::value>>
+template<class T1, class P, class T2,
+         class = std::enable_if_t<is_integral<T2>::value>>
 inline bool
-operator < (const T2& r, const rational<T1>& x)
+operator < (const T2& r, const rational<T1,P>& x)
 {
-    return (x.numer() < (r * x.denom()));
+    return (detail::compare_fractions(r, T2(1), x.numer(), x.denom()) < 0);
 }
 
 
-template<class T1, class T2, class = std::enable_if_t<is_integral<T2>::value>>
+template<class T1, class P, class T2,
+         class = std::enable_if_t<is_integral<T2>::value>>
 inline bool
-operator <= (const rational<T1>& x, const T2& r)
+operator <= (const rational<T1,P>& x, const T2& r)
 {
-    return (x.numer() <= (r * x.denom()));
+    return (detail::compare_fractions(x.numer(), x.denom(), r, T2(1)) <= 0);
 }
 
-template<class T1, class T2, class = std::enable_if_t<is_integral<T2>::value>>
+template<class T1, class P, class T2,
+         class = std::enable_if_t<is_integral<T2>::value>>
 inline bool
-operator <= (const T2& r, const rational<T1>& x)
+operator <= (const T2& r, const rational<T1,P>& x)
 {
-    return (x.numer() <= (r * x.denom()));
+    return (detail::compare_fractions(r, T2(1), x.numer(), x.denom()) <= 0);
 }
 
 
@@ -578,100 +1618,110 @@ operator <= (const T2& r, const rational<T1>& x)
  *
  * ARITHMETIC
  *
+ * results follow the normalization policy of the operands
+ *
  *****************************************************************************/
-template<class T1, class T2>
+template<class T1, class T2, class P>
 inline constexpr auto
-operator + (const rational<T1> x, const rational<T2>& y)
+operator + (const rational<T1,P>& x, const rational<T2,P>& y)
 {
     using T = common_numeric_t<T1,T2>;
-
-    return rational<T>{
-        T( (x.numer() * y.denom())  + (y.numer() * x.denom()) ),
-        T( x.denom() * y.denom() ) };
+    auto r = rational<T,P>(x);
+    r += rational<T,P>(y);
+    return r;
 }
 
-template<class T>
+template<class T, class P>
 inline constexpr auto
-operator + (const rational<T> x, const T& y)
+operator + (const rational<T,P>& x, const T& y)
 {
-    return rational<T>{x.numer() + (y * x.denom()), x.denom()};
+    auto r = x;
+    r += y;
+    return r;
 }
 
 
 //-------------------------------------------------------------------
-template<class T1, class T2>
+template<class T1, class T2, class P>
 inline constexpr auto
-operator - (const rational<T1> x, const rational<T2>& y)
+operator - (const rational<T1,P>& x, const rational<T2,P>& y)
 {
     using T = common_numeric_t<T1,T2>;
-
-    return rational<T>{
-         T( (x.numer() * y.denom()) - (y.numer() * x.denom()) ),
-         T( x.denom() * y.denom() ) };
+    auto r = rational<T,P>(x);
+    r -= rational<T,P>(y);
+    return r;
 }
 
-template<class T>
+template<class T, class P>
 inline constexpr auto
-operator - (const rational<T> x, const T& y)
+operator - (const rational<T,P>& x, const T& y)
 {
-    return rational<T>{ x.numer() - (y * x.denom()), x.denom() };
+    auto r = x;
+    r -= y;
+    return r;
 }
 
 
 //-------------------------------------------------------------------
-template<class T1, class T2>
+template<class T1, class T2, class P>
 inline constexpr auto
-operator * (const rational<T1> x, const rational<T2>& y)
+operator * (const rational<T1,P>& x, const rational<T2,P>& y)
 {
     using T = common_numeric_t<T1,T2>;
-
-    return rational<T>{ T(x.numer() * y.numer()), 
-                        T(x.denom() * y.denom()) };
+    auto r = rational<T,P>(x);
+    r *= rational<T,P>(y);
+    return r;
 }
 
-template<class T>
+template<class T, class P>
 inline constexpr auto
-operator * (const rational<T> x, const T& y)
+operator * (const rational<T,P>& x, const T& y)
 {
-    return rational<T>{ x.numer() * y, x.denom() };
+    auto r = x;
+    r *= y;
+    return r;
 }
 
 
 //-------------------------------------------------------------------
-template<class T1, class T2>
+template<class T1, class T2, class P>
 inline constexpr auto
-operator / (const rational<T1> x, const rational<T2>& y)
+operator / (const rational<T1,P>& x, const rational<T2,P>& y)
 {
     using T = common_numeric_t<T1,T2>;
-
-    return rational<T>{ T(x.numer() * y.denom()), 
-                        T(x.denom() * y.numer()) };
+    auto r = rational<T,P>(x);
+    r /= rational<T,P>(y);
+    return r;
 }
 
-template<class T>
+template<class T, class P>
 inline constexpr auto
-operator / (const rational<T> x, const T& y)
+operator / (const rational<T,P>& x, const T& y)
 {
-    return rational<T>{ x.numer(), x.denom() * y };
+    auto r = x;
+    r /= y;
+    return r;
 }
 
 
 //-------------------------------------------------------------------
-template<class T>
+template<class T, class P>
 inline auto
-operator ^ (const rational<T> b, const T& e)
+operator ^ (const rational<T,P>& b, const T& e)
 {
     return pow(b,e);
 }
 
 
 //-------------------------------------------------------------------
-template<class T>
+template<class T, class P>
 inline constexpr
-rational<T>
-operator - (const rational<T> x)
+rational<T,P>
+operator - (const rational<T,P>& x)
 {
-    return rational<T>{ -x.numer(), x.denom() };
+    auto r = x;
+    r.negate();
+    return r;
 }
 
 
@@ -682,100 +1732,100 @@ operator - (const rational<T> x)
  * FUNCTIONS
  *
  *****************************************************************************/
-template<class T>
-inline rational<T>&
-real(rational<T>& r) noexcept {
+template<class T, class P>
+inline rational<T,P>&
+real(rational<T,P>& r) noexcept {
     return r;
 }
 
-template<class T>
-inline const rational<T>&
-real(const rational<T>& r) noexcept {
+template<class T, class P>
+inline const rational<T,P>&
+real(const rational<T,P>& r) noexcept {
     return r;
 }
 
-template<class T>
-inline rational<T>
-real(rational<T>&& r) noexcept {
+template<class T, class P>
+inline rational<T,P>
+real(rational<T,P>&& r) noexcept {
     return r;
 }
 
 
 //-------------------------------------------------------------------
-template<class T>
+template<class T, class P>
 inline auto
-ceil(const rational<T>& x)
+ceil(const rational<T,P>& x)
 {
     using std::ceil;
-    return rational<T>{ceil(static_cast<T>(x))};
+    return rational<T,P>{ceil(static_cast<T>(x))};
 }
 
-template<class T>
+template<class T, class P>
 inline auto
-floor(const rational<T>& x)
+floor(const rational<T,P>& x)
 {
-    return rational<T>{wholes(x)};
+    return rational<T,P>{wholes(x)};
 }
 
 
 
 //-------------------------------------------------------------------
 /// @brief absolute value
-template<class T>
+template<class T, class P>
 inline auto
-abs(const rational<T>& x)
+abs(const rational<T,P>& x)
 {
     using std::abs;
-    return rational<T>{abs(x.numer()), abs(x.denom())};
+    return rational<T,P>{abs(x.numer()), abs(x.denom())};
 }
 
 
 
 //-------------------------------------------------------------------
-template<class T>
+template<class T, class P>
 inline auto
-pow(const rational<T> b, const T& e)
+pow(const rational<T,P>& b, const T& e)
 {
     using std::pow;
 
     return ((e > T(0))
-        ? rational<T>{pow(b.numer(),e), pow(b.denom(),e)}
-        : rational<T>{pow(b.denom(),e), pow(b.numer(),e)} );
+        ? rational<T,P>{pow(b.numer(),e), pow(b.denom(),e)}
+        : rational<T,P>{pow(b.denom(),e), pow(b.numer(),e)} );
 }
 
 
 
 //-------------------------------------------------------------------
-template<class T>
+template<class T, class P>
 inline bool
-isfinite(const rational<T>& x)
+isfinite(const rational<T,P>& x)
 {
     using std::isfinite;
     return (isfinite(x.numer()) && isfinite(x.denom()));
 }
 
 //---------------------------------------------------------
-template<class T>
+template<class T, class P>
 inline bool
-isinf(const rational<T>& x)
+isinf(const rational<T,P>& x)
 {
     using std::isinf;
     return (isinf(x.numer()) || isinf(x.denom()));
 }
 
 //---------------------------------------------------------
-template<class T>
+template<class T, class P>
 inline bool
-isnan(const rational<T>& x)
+isnan(const rational<T,P>& x)
 {
     using std::isnan;
     return (isnan(x.numer()) || isnan(x.denom()));
 }
 
 //---------------------------------------------------------
-template<class T>
+template<class T, class P>
 inline bool
-isnormal(const rational<T>& x)
+isnormal(const rational<T,P>& x)
 {
     using std::isnormal;
     return (isnormal(x.numer()) && isnormal(x.denom()));
@@ -789,8 +1839,8 @@ isnormal(const rational<T>& x)
  * TRAITS SPECIALIZATIONS
  *
  *****************************************************************************/
-template<class T>
-struct is_number<rational<T>> : std::true_type
+template<class T, class P>
+struct is_number<rational<T,P>> : std::true_type
 {};
 
 
@@ -806,10 +1856,10 @@ namespace std {
  *
  *
  *****************************************************************************/
-template<class T>
-class numeric_limits<am::num::rational<T>>
+template<class T, class P>
+class numeric_limits<am::num::rational<T,P>>
 {
-    using val_t = am::num::rational<T>;
+    using val_t = am::num::rational<T,P>;
 
 public:
     static constexpr bool is_specialized = true;
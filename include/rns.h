@@ -0,0 +1,390 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_RNS_H_
+#define AM_NUMERIC_RNS_H_
+
+#include <array>
+#include <tuple>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "choice.h"
+#include "dynamic_choice.h"
+#include "big_integer.h"
+#include "gcd.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * MODULI
+ *
+ *****************************************************************************/
+namespace detail {
+
+template<class T>
+struct is_choice : std::false_type {};
+
+template<class IntT, IntT n>
+struct is_choice<choice<IntT,n>> : std::true_type {};
+
+template<bool... bs>
+using all_true = std::is_same<std::integer_sequence<bool, true, bs...>,
+                              std::integer_sequence<bool, bs..., true>>;
+
+
+//-------------------------------------------------------------------
+template<std::size_t k>
+inline constexpr bool
+pairwise_coprime(const std::array<std::uint64_t,k>& m) noexcept
+{
+    for(std::size_t i = 0; i < k; ++i) {
+        for(std::size_t j = i + 1; j < k; ++j) {
+            if(gcd(m[i], m[j]) != 1) return false;
+        }
+    }
+    return true;
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief constants for mixed-radix conversion (Garner's algorithm)
+ *        inv[i][j] = m_j^-1 mod m_i  for j < i
+ */
+template<std::size_t k>
+struct rns_garner_table
+{
+    explicit
+    rns_garner_table(const std::array<std::uint64_t,k>& m):
+        mod(), inv()
+    {
+        for(std::size_t i = 0; i < k; ++i) {
+            mod[i] = dynamic_modulus<std::uint32_t>{std::uint32_t(m[i])};
+            for(std::size_t j = 0; j < i; ++j) {
+                std::uint32_t x = 0;
+                choice_inverse(mod[i], mod[i].reduce(std::uint32_t(m[j])), x);
+                inv[i][j] = x;
+            }
+        }
+    }
+
+    std::array<dynamic_modulus<std::uint32_t>,k> mod;
+    std::array<std::array<std::uint32_t,k>,k> inv;
+};
+
+}  // namespace detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief residue number system:
+ *        integer x represented by (x mod m_1, ..., x mod m_k)
+ *
+ * @tparam Choices  choice<T,m_i> types with pairwise coprime m_i < 2^32
+ *
+ * Addition, subtraction and multiplication act on each residue
+ * independently (no carries). The lane operations are unrolled at
+ * compile time and don't depend on each other, so they can be
+ * executed in parallel. Results are exact modulo M = m_1 * ... * m_k;
+ * conversion back to an integer uses mixed-radix digits
+ * (Garner's algorithm) and needs only one big integer multiply-add
+ * per modulus.
+ *
+ *****************************************************************************/
+template<class... Choices>
+class rns
+{
+    static constexpr std::size_t k = sizeof...(Choices);
+
+    static_assert(k > 0, "rns<...> : at least one modulus required");
+
+    static_assert(detail::all_true<detail::is_choice<Choices>::value...>::value,
+        "rns<...> : all types must be choice<T,m>");
+
+    static_assert(detail::all_true<(std::uint64_t(Choices::choices()) <
+                                    (std::uint64_t(1) << 32))...>::value,
+        "rns<...> : moduli must be < 2^32");
+
+    static_assert(detail::pairwise_coprime<k>(
+                  {{std::uint64_t(Choices::choices())...}}),
+        "rns<...> : moduli must be pairwise coprime");
+
+    using lanes = std::index_sequence_for<Choices...>;
+
+public:
+    //---------------------------------------------------------------
+    using residues_type = std::tuple<Choices...>;
+
+
+    //---------------------------------------------------------------
+    /// @brief zero in all lanes
+    constexpr
+    rns():
+        r_{Choices{typename Choices::value_type(0)}...}
+    {}
+
+    constexpr
+    rns(const Choices&... residues):
+        r_{residues...}
+    {}
+
+    template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
+    explicit
+    rns(const T& x):
+        rns()
+    {
+        for_each_lane([&](auto& c, auto) { c += x; });
+    }
+
+    explicit
+    rns(const big_integer& x):
+        rns()
+    {
+        for_each_lane([&](auto& c, auto) {
+            using c_t = std::decay_t<decltype(c)>;
+            //|remainder| < m
+            c += std::int64_t(x % big_integer{std::uint64_t(c_t::choices())});
+        });
+    }
+
+
+    //---------------------------------------------------------------
+    static constexpr std::size_t
+    size() noexcept {
+        return k;
+    }
+
+    /// @brief product of all moduli
+    static const big_integer&
+    modulus() {
+        static const big_integer m = [] {
+            big_integer p {1};
+            for(auto x : moduli()) p *= big_integer{x};
+            return p;
+        }();
+        return m;
+    }
+
+
+    //---------------------------------------------------------------
+    const residues_type&
+    residues() const noexcept {
+        return r_;
+    }
+
+    template<std::size_t i>
+    const std::tuple_element_t<i,residues_type>&
+    residue() const noexcept {
+        return std::get<i>(r_);
+    }
+
+
+    //---------------------------------------------------------------
+    rns&
+    operator += (const rns& o) {
+        for_each_lane([&](auto& c, auto i) { c += std::get<decltype(i)::value>(o.r_); });
+        return *this;
+    }
+
+    rns&
+    operator -= (const rns& o) {
+        for_each_lane([&](auto& c, auto i) { c -= std::get<decltype(i)::value>(o.r_); });
+        return *this;
+    }
+
+    rns&
+    operator *= (const rns& o) {
+        for_each_lane([&](auto& c, auto i) { c *= std::get<decltype(i)::value>(o.r_); });
+        return *this;
+    }
+
+    template<class T, class = std::enable_if_t<std::is_integral<T>::value>>
+    rns&
+    operator *= (const T& x) {
+        for_each_lane([&](auto& c, auto) { c *= x; });
+        return *this;
+    }
+
+    //-----------------------------------------------------
+    rns
+    operator - () const {
+        auto r = *this;
+        r.for_each_lane([](auto& c, auto) { c.invert(); });
+        return r;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief lane-wise multiplicative inverse; throws std::domain_error
+    rns&
+    invert_multiplicative() {
+        for_each_lane([](auto& c, auto) { c = inverse(c); });
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief digits d_i of x = d_0 + d_1 m_0 + d_2 m_0 m_1 + ...
+    std::array<std::uint32_t,k>
+    mixed_radix_digits() const
+    {
+        static const detail::rns_garner_table<k> t {moduli()};
+
+        std::array<std::uint32_t,k> d;
+        const auto r = lane_values();
+        for(std::size_t i = 0; i < k; ++i) {
+            const auto& m = t.mod[i];
+            auto x = r[i];
+            for(std::size_t j = 0; j < i; ++j) {
+                x = m.mul(m.sub(x, m.reduce(d[j])), t.inv[i][j]);
+            }
+            d[i] = x;
+        }
+        return d;
+    }
+
+    //-----------------------------------------------------
+    /// @brief represented integer in [0,M)
+    big_integer
+    value() const
+    {
+        const auto d = mixed_radix_digits();
+        const auto m = moduli();
+        //Horner scheme
+        big_integer x {d[k-1]};
+        for(std::size_t i = k - 1; i-- > 0; ) {
+            x *= big_integer{m[i]};
+            x += big_integer{d[i]};
+        }
+        return x;
+    }
+
+    //-----------------------------------------------------
+    /// @brief represented integer in (-M/2, M/2]
+    big_integer
+    signed_value() const
+    {
+        auto x = value();
+        const auto& m = modulus();
+        if(x + x > m) x -= m;
+        return x;
+    }
+
+
+    //---------------------------------------------------------------
+    friend bool
+    operator == (const rns& a, const rns& b) noexcept {
+        return a.r_ == b.r_;
+    }
+
+    friend bool
+    operator != (const rns& a, const rns& b) noexcept {
+        return !(a.r_ == b.r_);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    static constexpr std::array<std::uint64_t,k>
+    moduli() noexcept {
+        return {{std::uint64_t(Choices::choices())...}};
+    }
+
+    std::array<std::uint32_t,k>
+    lane_values() const noexcept {
+        return lane_values(lanes{});
+    }
+
+    template<std::size_t... i>
+    std::array<std::uint32_t,k>
+    lane_values(std::index_sequence<i...>) const noexcept {
+        return {{std::uint32_t(std::get<i>(r_).value())...}};
+    }
+
+
+    //---------------------------------------------------------------
+    template<class F>
+    void
+    for_each_lane(F&& f) {
+        for_each_lane(std::forward<F>(f), lanes{});
+    }
+
+    template<class F, std::size_t... i>
+    void
+    for_each_lane(F&& f, std::index_sequence<i...>) {
+        using expand = int[];
+        (void)expand{0, (f(std::get<i>(r_),
+                           std::integral_constant<std::size_t,i>{}), 0)...};
+    }
+
+
+    //---------------------------------------------------------------
+    residues_type r_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * ARITHMETIC
+ *
+ *****************************************************************************/
+template<class... Cs>
+inline rns<Cs...>
+operator + (rns<Cs...> a, const rns<Cs...>& b)
+{
+    return (a += b);
+}
+
+//---------------------------------------------------------
+template<class... Cs>
+inline rns<Cs...>
+operator - (rns<Cs...> a, const rns<Cs...>& b)
+{
+    return (a -= b);
+}
+
+//---------------------------------------------------------
+template<class... Cs>
+inline rns<Cs...>
+operator * (rns<Cs...> a, const rns<Cs...>& b)
+{
+    return (a *= b);
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief multiplicative inverse in every lane
+ * @throws std::domain_error if x is not coprime to M
+ */
+template<class... Cs>
+inline rns<Cs...>
+inverse(rns<Cs...> x)
+{
+    return x.invert_multiplicative();
+}
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
@@ -13,9 +13,12 @@
 
 #include <cmath>
 #include <cfloat>
+#include <utility>
+#include <iterator>
 
 #include "constants.h"
 #include "equality.h"
+#include "sincos.h"
 
 
 namespace am {
@@ -237,10 +240,10 @@ public:
     scomplex&
     operator /= (const scomplex& o)
     {
-        auto abso_inv = value_type(1) / abs(o);
+        auto abs2o_inv = value_type(1) / abs2(o);
         auto ro = r_;
-        r_ = abso_inv * ( (r_ * o.r_) - (i_ * o.i_) );
-        i_ = abso_inv * ( (i_ * o.r_) - (ro   * o.i_) );
+        r_ = abs2o_inv * ( (r_ * o.r_) - (i_ * o.i_) );
+        i_ = abs2o_inv * ( (i_ * o.r_) - (ro   * o.i_) );
         return *this;
     }
 
@@ -595,11 +598,11 @@ inline constexpr auto
 operator / (const scomplex<T1> x, const scomplex<T2>& y)
 {
     using T = common_numeric_t<T1,T2>;
-    auto absy = T(1) / T(abs(y));
+    auto abs2y = T(1) / T(abs2(y));
 
     return scomplex<T>{
-        absy * ( (T(x.real()) * T(y.real())) - (T(x.imag()) * T(y.imag())) ),
-        absy * ( (T(x.imag()) * T(y.real())) - (T(x.real()) * T(y.imag())) )
+        abs2y * ( (T(x.real()) * T(y.real())) - (T(x.imag()) * T(y.imag())) ),
+        abs2y * ( (T(x.imag()) * T(y.real())) - (T(x.real()) * T(y.imag())) )
     };
 }
 
@@ -619,7 +622,8 @@ inline constexpr auto
 operator / (const T2& y, const scomplex<T1> x)
 {
     using T = common_numeric_t<T1,T2>;
-    return scomplex<T>{ T(y) / T(x.real()), T(y) / T(x.imag()) };
+    auto yabs2x = T(y) / T(abs2(x));
+    return scomplex<T>{ yabs2x * T(x.real()), -yabs2x * T(x.imag()) };
 }
 
 
@@ -711,6 +715,33 @@ abs2(const scomplex<T>& x)
 
 
 
+//-------------------------------------------------------------------
+// HYPERBOLIC ROTATIONS
+//-------------------------------------------------------------------
+//---------------------------------------------------------
+/// @brief unit split complex number cosh(phi) + j * sinh(phi)
+///        (hyperbolic rotation / Lorentz boost with rapidity phi)
+template<class T>
+inline auto
+from_rapidity(const T& phi)
+{
+    T c, s;
+    detail::sinh_cosh(phi, s, c);
+    return scomplex<T>{c, s};
+}
+
+//---------------------------------------------------------
+/// @brief rapidity (hyperbolic angle) of x; requires |imag| < real
+template<class T>
+inline auto
+rapidity(const scomplex<T>& x)
+{
+    using std::atanh;
+    return atanh(x.imag() / x.real());
+}
+
+
+
 //-------------------------------------------------------------------
 // ROOTS
 //-------------------------------------------------------------------
@@ -1074,6 +1105,389 @@ isnormal(const scomplex<T>& x)
 
 
 
+/*************************************************************************//***
+ *
+ * @brief
+ * split complex number in the light-cone (idempotent) basis
+ * p * e+  +  m * e-   with   e+ = (1+j)/2,  e- = (1-j)/2
+ *
+ * e+ * e+ = e+,  e- * e- = e-,  e+ * e- = 0
+ * so that multiplication, division and powers act component-wise
+ * on the two independent real lanes p = r + d and m = r - d
+ *
+ *****************************************************************************/
+template<class NumberType>
+class lightcone_scomplex
+{
+public:
+
+    static_assert(is_number<NumberType>::value,
+        "lightcone_scomplex<T>: T must be a number type");
+
+    static_assert(!is_scomplex<NumberType>::value,
+        "lightcone_scomplex<T>: T must not be a scomplex<> type");
+
+
+    //---------------------------------------------------------------
+    using value_type    = NumberType;
+    using numeric_type  = value_type;
+
+
+    //---------------------------------------------------------------
+    /// @brief default constructor
+    constexpr
+    lightcone_scomplex() = default;
+
+    /// @brief from components along e+ and e-
+    constexpr
+    lightcone_scomplex(const value_type& plusPart, const value_type& minusPart):
+        p_{plusPart}, m_{minusPart}
+    {}
+
+    /// @brief conversion from (real, imag) basis
+    explicit constexpr
+    lightcone_scomplex(const scomplex<value_type>& z):
+        p_{z.real() + z.imag()}, m_{z.real() - z.imag()}
+    {}
+
+
+    //---------------------------------------------------------------
+    // ELEMENT ACCESS
+    //---------------------------------------------------------------
+    /// @brief component along e+ = (1+j)/2
+    constexpr const value_type&
+    plus() const noexcept {
+        return p_;
+    }
+
+    /// @brief component along e- = (1-j)/2
+    constexpr const value_type&
+    minus() const noexcept {
+        return m_;
+    }
+
+    //-----------------------------------------------------
+    constexpr value_type
+    real() const {
+        return (p_ + m_) / value_type(2);
+    }
+
+    constexpr value_type
+    imag() const {
+        return (p_ - m_) / value_type(2);
+    }
+
+
+    //---------------------------------------------------------------
+    lightcone_scomplex&
+    conjugate() noexcept
+    {
+        using std::swap;
+        swap(p_, m_);
+        return *this;
+    }
+
+    //---------------------------------------------------------
+    lightcone_scomplex&
+    negate() noexcept
+    {
+        p_ = -p_;
+        m_ = -m_;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // lightcone_scomplex (op)= number   (1 = e+ + e-)
+    //---------------------------------------------------------------
+    lightcone_scomplex&
+    operator += (const value_type& v) {
+        p_ += v;
+        m_ += v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    lightcone_scomplex&
+    operator -= (const value_type& v) {
+        p_ -= v;
+        m_ -= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    lightcone_scomplex&
+    operator *= (const value_type& v) {
+        p_ *= v;
+        m_ *= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    lightcone_scomplex&
+    operator /= (const value_type& v) {
+        p_ /= v;
+        m_ /= v;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // lightcone_scomplex (op)= lightcone_scomplex
+    //---------------------------------------------------------------
+    lightcone_scomplex&
+    operator += (const lightcone_scomplex& o) {
+        p_ += o.p_;
+        m_ += o.m_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    lightcone_scomplex&
+    operator -= (const lightcone_scomplex& o) {
+        p_ -= o.p_;
+        m_ -= o.m_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    lightcone_scomplex&
+    operator *= (const lightcone_scomplex& o) {
+        p_ *= o.p_;
+        m_ *= o.m_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    lightcone_scomplex&
+    operator /= (const lightcone_scomplex& o) {
+        p_ /= o.p_;
+        m_ /= o.m_;
+        return *this;
+    }
+
+
+private:
+    value_type p_;
+    value_type m_;
+};
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline constexpr auto
+make_lightcone(const scomplex<T>& z)
+{
+    return lightcone_scomplex<T>{z};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr auto
+make_scomplex(const lightcone_scomplex<T>& z)
+{
+    return scomplex<T>{z.real(), z.imag()};
+}
+
+//---------------------------------------------------------
+/// @brief converts a range of scomplex numbers to the light-cone basis
+template<class InputIter, class OutputIter>
+inline OutputIter
+to_lightcone(InputIter first, InputIter last, OutputIter out)
+{
+    for(; first != last; ++first, ++out) *out = make_lightcone(*first);
+    return out;
+}
+
+//---------------------------------------------------------
+/// @brief converts a range of light-cone numbers to the (real,imag) basis
+template<class InputIter, class OutputIter>
+inline OutputIter
+to_scomplex(InputIter first, InputIter last, OutputIter out)
+{
+    for(; first != last; ++first, ++out) *out = make_scomplex(*first);
+    return out;
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline bool
+operator == (const lightcone_scomplex<T>& a, const lightcone_scomplex<T>& b)
+{
+    return ((a.plus() == b.plus()) && (a.minus() == b.minus()));
+}
+
+//---------------------------------------------------------
+template<class T>
+inline bool
+operator != (const lightcone_scomplex<T>& a, const lightcone_scomplex<T>& b)
+{
+    return !(a == b);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr bool
+approx_equal(
+    const lightcone_scomplex<T>& a, const lightcone_scomplex<T>& b,
+    const T& tol = tolerance<T>)
+{
+    return (approx_equal(a.plus(), b.plus(), tol) &&
+            approx_equal(a.minus(), b.minus(), tol) );
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline constexpr auto
+operator + (const lightcone_scomplex<T>& x, const lightcone_scomplex<T>& y)
+{
+    return lightcone_scomplex<T>{x.plus() + y.plus(), x.minus() + y.minus()};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr auto
+operator - (const lightcone_scomplex<T>& x, const lightcone_scomplex<T>& y)
+{
+    return lightcone_scomplex<T>{x.plus() - y.plus(), x.minus() - y.minus()};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr auto
+operator * (const lightcone_scomplex<T>& x, const lightcone_scomplex<T>& y)
+{
+    return lightcone_scomplex<T>{x.plus() * y.plus(), x.minus() * y.minus()};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr auto
+operator / (const lightcone_scomplex<T>& x, const lightcone_scomplex<T>& y)
+{
+    return lightcone_scomplex<T>{x.plus() / y.plus(), x.minus() / y.minus()};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr auto
+operator * (const lightcone_scomplex<T>& x, const T& y)
+{
+    return lightcone_scomplex<T>{x.plus() * y, x.minus() * y};
+}
+//---------------------------------------------------------
+template<class T>
+inline constexpr auto
+operator * (const T& y, const lightcone_scomplex<T>& x)
+{
+    return lightcone_scomplex<T>{y * x.plus(), y * x.minus()};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr auto
+operator / (const lightcone_scomplex<T>& x, const T& y)
+{
+    return lightcone_scomplex<T>{x.plus() / y, x.minus() / y};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr auto
+operator - (const lightcone_scomplex<T>& x)
+{
+    return lightcone_scomplex<T>{-x.plus(), -x.minus()};
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline constexpr auto
+conj(const lightcone_scomplex<T>& x)
+{
+    return lightcone_scomplex<T>{x.minus(), x.plus()};
+}
+
+//---------------------------------------------------------
+/// @brief multiplicative inverse
+template<class T>
+inline constexpr auto
+inverse(const lightcone_scomplex<T>& x)
+{
+    return lightcone_scomplex<T>{T(1) / x.plus(), T(1) / x.minus()};
+}
+
+//---------------------------------------------------------
+/// @brief magnitude squared r^2 - d^2
+template<class T>
+inline constexpr auto
+abs2(const lightcone_scomplex<T>& x)
+{
+    return (x.plus() * x.minus());
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+abs(const lightcone_scomplex<T>& x)
+{
+    using std::sqrt;
+    return sqrt(x.plus() * x.minus());
+}
+
+//---------------------------------------------------------
+/// @brief power; both components must be positive
+///        (i.e. x must lie inside the right light-cone |d| < r)
+template<class T>
+inline auto
+pow(const lightcone_scomplex<T>& x, const T& e)
+{
+    using std::pow;
+    return lightcone_scomplex<T>{pow(x.plus(), e), pow(x.minus(), e)};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+sqrt(const lightcone_scomplex<T>& x)
+{
+    using std::sqrt;
+    return lightcone_scomplex<T>{sqrt(x.plus()), sqrt(x.minus())};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+exp(const lightcone_scomplex<T>& x)
+{
+    using std::exp;
+    return lightcone_scomplex<T>{exp(x.plus()), exp(x.minus())};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+log(const lightcone_scomplex<T>& x)
+{
+    using std::log;
+    return lightcone_scomplex<T>{log(x.plus()), log(x.minus())};
+}
+
+//---------------------------------------------------------
+/// @brief raises every element of a range to the power e
+template<class InputIter, class OutputIter, class T, class =
+    std::enable_if_t<std::is_same<lightcone_scomplex<T>,
+        typename std::iterator_traits<InputIter>::value_type>::value>>
+inline OutputIter
+pow(InputIter first, InputIter last, const T& e, OutputIter out)
+{
+    for(; first != last; ++first, ++out) *out = pow(*first, e);
+    return out;
+}
+
+
+
+
 /*****************************************************************************
  *
  * TRAITS SPECIALIZATIONS
@@ -0,0 +1,298 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_SCOMPLEX_ARRAY_H_
+#define AM_NUMERIC_SCOMPLEX_ARRAY_H_
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+#include <initializer_list>
+
+#include "scomplex.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief
+ * sequence of split complex numbers stored as two separate arrays
+ * (real parts and imaginary parts; "structure of arrays")
+ *
+ * The bulk kernels below are plain loops over contiguous arrays of
+ * builtin numbers without temporaries or type promotions,
+ * so that they can be vectorized by the compiler.
+ *
+ *****************************************************************************/
+template<class NumberType>
+class scomplex_array
+{
+public:
+
+    static_assert(std::is_arithmetic<NumberType>::value,
+        "scomplex_array<T>: T must be a builtin arithmetic type");
+
+
+    //---------------------------------------------------------------
+    using value_type      = scomplex<NumberType>;
+    using numeric_type    = NumberType;
+    using size_type       = std::size_t;
+
+
+    //---------------------------------------------------------------
+    scomplex_array() = default;
+
+    explicit
+    scomplex_array(size_type n):
+        r_(n), i_(n)
+    {}
+
+    scomplex_array(size_type n, const value_type& x):
+        r_(n, x.real()), i_(n, x.imag())
+    {}
+
+    scomplex_array(std::initializer_list<value_type> il):
+        r_(), i_()
+    {
+        reserve(il.size());
+        for(const auto& x : il) push_back(x);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        return r_.size();
+    }
+
+    bool
+    empty() const noexcept {
+        return r_.empty();
+    }
+
+    void
+    resize(size_type n) {
+        r_.resize(n);
+        i_.resize(n);
+    }
+
+    void
+    reserve(size_type n) {
+        r_.reserve(n);
+        i_.reserve(n);
+    }
+
+    void
+    clear() noexcept {
+        r_.clear();
+        i_.clear();
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator [] (size_type i) const noexcept {
+        return value_type{r_[i], i_[i]};
+    }
+
+    void
+    set(size_type i, const value_type& x) noexcept {
+        r_[i] = x.real();
+        i_[i] = x.imag();
+    }
+
+    void
+    push_back(const value_type& x) {
+        r_.push_back(x.real());
+        i_.push_back(x.imag());
+    }
+
+
+    //---------------------------------------------------------------
+    const numeric_type*
+    real_data() const noexcept {
+        return r_.data();
+    }
+
+    numeric_type*
+    real_data() noexcept {
+        return r_.data();
+    }
+
+    const numeric_type*
+    imag_data() const noexcept {
+        return i_.data();
+    }
+
+    numeric_type*
+    imag_data() noexcept {
+        return i_.data();
+    }
+
+
+private:
+
+    //---------------------------------------------------------------
+    std::vector<numeric_type> r_;
+    std::vector<numeric_type> i_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * BULK KERNELS
+ *
+ * @note output arrays are resized if necessary and may be identical
+ *       to one of the inputs
+ *
+ *****************************************************************************/
+template<class T>
+inline void
+multiply(const scomplex_array<T>& a, const scomplex_array<T>& b,
+         scomplex_array<T>& out)
+{
+    assert(a.size() == b.size());
+    const auto n = a.size();
+    if(out.size() != n) out.resize(n);
+
+    const auto ar = a.real_data(), ai = a.imag_data();
+    const auto br = b.real_data(), bi = b.imag_data();
+    auto outr = out.real_data();
+    auto outi = out.imag_data();
+
+    for(std::size_t k = 0; k < n; ++k) {
+        const auto r = (ar[k] * br[k]) + (ai[k] * bi[k]);
+        const auto i = (ar[k] * bi[k]) + (ai[k] * br[k]);
+        outr[k] = r;
+        outi[k] = i;
+    }
+}
+
+//---------------------------------------------------------
+template<class T>
+inline void
+divide(const scomplex_array<T>& a, const scomplex_array<T>& b,
+       scomplex_array<T>& out)
+{
+    assert(a.size() == b.size());
+    const auto n = a.size();
+    if(out.size() != n) out.resize(n);
+
+    const auto ar = a.real_data(), ai = a.imag_data();
+    const auto br = b.real_data(), bi = b.imag_data();
+    auto outr = out.real_data();
+    auto outi = out.imag_data();
+
+    for(std::size_t k = 0; k < n; ++k) {
+        const auto inv = T(1) / ((br[k] * br[k]) - (bi[k] * bi[k]));
+        const auto r = inv * ((ar[k] * br[k]) - (ai[k] * bi[k]));
+        const auto i = inv * ((ai[k] * br[k]) - (ar[k] * bi[k]));
+        outr[k] = r;
+        outi[k] = i;
+    }
+}
+
+//---------------------------------------------------------
+/// @brief conjugates all elements in-place
+template<class T>
+inline void
+conjugate(scomplex_array<T>& a)
+{
+    const auto n = a.size();
+    auto ai = a.imag_data();
+    for(std::size_t k = 0; k < n; ++k) ai[k] = -ai[k];
+}
+
+//---------------------------------------------------------
+/// @brief magnitudes squared
+template<class T>
+inline void
+abs2(const scomplex_array<T>& a, std::vector<T>& out)
+{
+    const auto n = a.size();
+    out.resize(n);
+
+    const auto ar = a.real_data(), ai = a.imag_data();
+    for(std::size_t k = 0; k < n; ++k) {
+        out[k] = (ar[k] * ar[k]) - (ai[k] * ai[k]);
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+// HYPERBOLIC ROTATIONS
+//-------------------------------------------------------------------
+/// @brief unit split complex numbers cosh(phi) + j * sinh(phi)
+///        for all phi in [first,last)
+template<class T>
+inline void
+from_rapidity(const T* first, const T* last, scomplex_array<T>& out)
+{
+    const auto n = std::size_t(last - first);
+    if(out.size() != n) out.resize(n);
+
+    auto outr = out.real_data();
+    auto outi = out.imag_data();
+    for(std::size_t k = 0; k < n; ++k) {
+        detail::sinh_cosh(first[k], outi[k], outr[k]);
+    }
+}
+
+//---------------------------------------------------------
+/// @brief applies the same boost with rapidity phi to all elements
+template<class T>
+inline void
+boost(scomplex_array<T>& a, const T& phi)
+{
+    T c, s;
+    detail::sinh_cosh(phi, s, c);
+
+    const auto n = a.size();
+    auto ar = a.real_data();
+    auto ai = a.imag_data();
+    for(std::size_t k = 0; k < n; ++k) {
+        const auto r = (ar[k] * c) + (ai[k] * s);
+        const auto i = (ar[k] * s) + (ai[k] * c);
+        ar[k] = r;
+        ai[k] = i;
+    }
+}
+
+//---------------------------------------------------------
+/// @brief applies boost with rapidity phis[k] to element k
+template<class T>
+inline void
+boost(scomplex_array<T>& a, const T* phis)
+{
+    const auto n = a.size();
+    auto ar = a.real_data();
+    auto ai = a.imag_data();
+    for(std::size_t k = 0; k < n; ++k) {
+        T c, s;
+        detail::sinh_cosh(phis[k], s, c);
+        const auto r = (ar[k] * c) + (ai[k] * s);
+        const auto i = (ar[k] * s) + (ai[k] * c);
+        ar[k] = r;
+        ai[k] = i;
+    }
+}
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
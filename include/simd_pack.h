@@ -0,0 +1,938 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_SIMD_PACK_H_
+#define AM_NUMERIC_SIMD_PACK_H_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "traits.h"
+#include "digamma.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class,std::size_t> class simd_pack;
+
+template<class>
+struct is_simd_pack :
+    std::false_type
+{};
+
+template<class T, std::size_t W>
+struct is_simd_pack<simd_pack<T,W>> :
+    std::true_type
+{};
+
+
+//-------------------------------------------------------------------
+/// @brief number of lanes that fill a 256 bit register
+template<class T>
+constexpr std::size_t default_simd_width =
+    (sizeof(T) < 32) ? (32 / sizeof(T)) : 1;
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief
+ * fixed-width pack of W numbers with lane-wise arithmetic
+ *
+ * All operations are simple loops over the lanes
+ * so that they can be mapped to vector instructions by the compiler.
+ *
+ * @note exp, log, sin and cos of float and double packs use branch-free
+ *       polynomial kernels (see below). All other elementary and special
+ *       functions call the scalar C library function lane by lane
+ *       (map_lanes) and are therefore not vectorized.
+ *
+ *****************************************************************************/
+template<class NumberType, std::size_t W>
+class simd_pack
+{
+    static_assert(W > 0, "simd_pack<T,W>: W must be at least 1");
+
+public:
+
+    static_assert(std::is_arithmetic<NumberType>::value,
+        "simd_pack<T,W>: T must be a builtin arithmetic type");
+
+
+    //---------------------------------------------------------------
+    using value_type      = NumberType;
+    using numeric_type    = value_type;
+    using size_type       = std::size_t;
+
+
+    //---------------------------------------------------------------
+    /// @brief default constructor
+    constexpr
+    simd_pack() = default;
+
+    /// @brief broadcasts x to all lanes
+    simd_pack(const value_type& x) {
+        for(size_type i = 0; i < W; ++i) v_[i] = x;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief reads W consecutive values starting at p
+    static simd_pack
+    load(const value_type* p) {
+        simd_pack r;
+        for(size_type i = 0; i < W; ++i) r.v_[i] = p[i];
+        return r;
+    }
+
+    /// @brief reads n < W values; remaining lanes are set to fill
+    static simd_pack
+    load(const value_type* p, size_type n, const value_type& fill) {
+        simd_pack r {fill};
+        for(size_type i = 0; i < n; ++i) r.v_[i] = p[i];
+        return r;
+    }
+
+    /// @brief writes all lanes to W consecutive locations starting at p
+    void
+    store(value_type* p) const {
+        for(size_type i = 0; i < W; ++i) p[i] = v_[i];
+    }
+
+    /// @brief writes the first n lanes to p
+    void
+    store(value_type* p, size_type n) const {
+        for(size_type i = 0; i < n; ++i) p[i] = v_[i];
+    }
+
+
+    //---------------------------------------------------------------
+    static constexpr size_type
+    size() noexcept {
+        return W;
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr const value_type&
+    operator [] (size_type i) const noexcept {
+        return v_[i];
+    }
+
+    value_type&
+    operator [] (size_type i) noexcept {
+        return v_[i];
+    }
+
+
+    //---------------------------------------------------------------
+    simd_pack&
+    operator += (const simd_pack& o) {
+        for(size_type i = 0; i < W; ++i) v_[i] += o.v_[i];
+        return *this;
+    }
+    //-----------------------------------------------------
+    simd_pack&
+    operator -= (const simd_pack& o) {
+        for(size_type i = 0; i < W; ++i) v_[i] -= o.v_[i];
+        return *this;
+    }
+    //-----------------------------------------------------
+    simd_pack&
+    operator *= (const simd_pack& o) {
+        for(size_type i = 0; i < W; ++i) v_[i] *= o.v_[i];
+        return *this;
+    }
+    //-----------------------------------------------------
+    simd_pack&
+    operator /= (const simd_pack& o) {
+        for(size_type i = 0; i < W; ++i) v_[i] /= o.v_[i];
+        return *this;
+    }
+
+    //---------------------------------------------------------------
+    simd_pack&
+    operator ++ () {
+        for(size_type i = 0; i < W; ++i) ++v_[i];
+        return *this;
+    }
+    //-----------------------------------------------------
+    simd_pack&
+    operator -- () {
+        for(size_type i = 0; i < W; ++i) --v_[i];
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // non-template friends, so that scalars are broadcast implicitly
+    //---------------------------------------------------------------
+    friend simd_pack
+    operator + (simd_pack a, const simd_pack& b) {
+        return a += b;
+    }
+    //-----------------------------------------------------
+    friend simd_pack
+    operator - (simd_pack a, const simd_pack& b) {
+        return a -= b;
+    }
+    //-----------------------------------------------------
+    friend simd_pack
+    operator * (simd_pack a, const simd_pack& b) {
+        return a *= b;
+    }
+    //-----------------------------------------------------
+    friend simd_pack
+    operator / (simd_pack a, const simd_pack& b) {
+        return a /= b;
+    }
+    //-----------------------------------------------------
+    friend simd_pack
+    operator - (simd_pack a) {
+        for(size_type i = 0; i < W; ++i) a.v_[i] = -a.v_[i];
+        return a;
+    }
+
+    //-----------------------------------------------------
+    /// @brief true, if all lanes are equal
+    friend bool
+    operator == (const simd_pack& a, const simd_pack& b) {
+        for(size_type i = 0; i < W; ++i) {
+            if(a.v_[i] != b.v_[i]) return false;
+        }
+        return true;
+    }
+    //-----------------------------------------------------
+    friend bool
+    operator != (const simd_pack& a, const simd_pack& b) {
+        return !(a == b);
+    }
+
+
+private:
+
+    //---------------------------------------------------------------
+    value_type v_[W];
+
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * LANE-WISE FUNCTIONS
+ *
+ *****************************************************************************/
+/// @brief applies f to every lane
+template<class T, std::size_t W, class UnaryOp>
+inline simd_pack<T,W>
+map_lanes(simd_pack<T,W> x, UnaryOp f)
+{
+    for(std::size_t i = 0; i < W; ++i) x[i] = f(x[i]);
+    return x;
+}
+
+//---------------------------------------------------------
+/// @brief applies f to every pair of lanes
+template<class T, std::size_t W, class BinaryOp>
+inline simd_pack<T,W>
+map_lanes(simd_pack<T,W> x, const simd_pack<T,W>& y, BinaryOp f)
+{
+    for(std::size_t i = 0; i < W; ++i) x[i] = f(x[i], y[i]);
+    return x;
+}
+
+//---------------------------------------------------------
+/// @brief sum of all lanes
+template<class T, std::size_t W>
+inline T
+reduce_add(const simd_pack<T,W>& x)
+{
+    T s = x[0];
+    for(std::size_t i = 1; i < W; ++i) s += x[i];
+    return s;
+}
+
+
+
+/*****************************************************************************
+ *
+ * POLYNOMIAL KERNELS
+ *
+ * Branch-free Cephes-style approximations of exp, log, sin and cos
+ * for float and double (max. error about 1 ulp). Integer parts are obtained
+ * by truncating conversions and powers of two by exponent bit manipulation,
+ * so that loops over the lanes contain no library calls and can be
+ * vectorized. The kernels are only accurate within their *_in_range domains;
+ * packs with a lane outside of it (incl. inf and NaN) are computed
+ * with the C library instead.
+ * The argument reductions rely on strict IEEE evaluation order,
+ * i.e. lose accuracy for large arguments with -ffast-math.
+ * Double precision kernels need 64 bit integer vector compares
+ * (e.g. SSE4.2, AVX2) to be vectorized.
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+inline std::uint64_t bits_of(double x) noexcept {
+    std::uint64_t u; std::memcpy(&u, &x, sizeof(u)); return u;
+}
+inline std::uint32_t bits_of(float x) noexcept {
+    std::uint32_t u; std::memcpy(&u, &x, sizeof(u)); return u;
+}
+inline double double_of(std::uint64_t u) noexcept {
+    double x; std::memcpy(&x, &u, sizeof(x)); return x;
+}
+inline float float_of(std::uint32_t u) noexcept {
+    float x; std::memcpy(&x, &u, sizeof(x)); return x;
+}
+
+//---------------------------------------------------------
+/// @brief branch-free c ? a : b
+/// @note  bit masks instead of conditionals, because the compiler would
+///        otherwise turn selects into branches and not vectorize the lane loop
+inline double select(bool c, double a, double b) noexcept {
+    const auto m = 0 - std::uint64_t(c);
+    return double_of((bits_of(a) & m) | (bits_of(b) & ~m));
+}
+inline float select(bool c, float a, float b) noexcept {
+    const auto m = 0 - std::uint32_t(c);
+    return float_of((bits_of(a) & m) | (bits_of(b) & ~m));
+}
+
+//---------------------------------------------------------
+/// @brief branch-free c ? -x : x
+inline double negate_if(bool c, double x) noexcept {
+    return double_of(bits_of(x) ^ (std::uint64_t(c) << 63));
+}
+inline float negate_if(bool c, float x) noexcept {
+    return float_of(bits_of(x) ^ (std::uint32_t(c) << 31));
+}
+
+
+//-------------------------------------------------------------------
+/// @brief domains of the kernels; false for NaN
+inline bool exp_in_range(double x) noexcept { return std::abs(x) <= 708.0; }
+inline bool exp_in_range(float x) noexcept  { return std::abs(x) <= 87.0f; }
+
+inline bool log_in_range(double x) noexcept {
+    return (x >= std::numeric_limits<double>::min()) &
+           (x <= std::numeric_limits<double>::max());
+}
+inline bool log_in_range(float x) noexcept {
+    return (x >= std::numeric_limits<float>::min()) &
+           (x <= std::numeric_limits<float>::max());
+}
+
+inline bool trig_in_range(double x) noexcept { return std::abs(x) <= 65536.0; }
+inline bool trig_in_range(float x) noexcept  { return std::abs(x) <= 8192.0f; }
+
+
+//-------------------------------------------------------------------
+inline double
+exp_kernel(double x) noexcept
+{
+    x = select(exp_in_range(x), x, 0.0);
+    //n = round(x / ln 2); the offset makes truncation round down
+    const double t = x * 1.4426950408889634073599;
+    const auto n = std::int32_t(t + 1024.5) - 1024;
+    const double fn = double(n);
+    x = x - fn * 6.93145751953125E-1;
+    x = x - fn * 1.42860682030941723212E-6;
+
+    const double xx = x * x;
+    const double px = x * ((1.26177193074810590878E-4 * xx +
+                            3.02994407707441961300E-2) * xx +
+                            9.99999999999999999910E-1);
+    const double qx = ((3.00198505138664455042E-6 * xx +
+                        2.52448340349684104192E-3) * xx +
+                        2.27265548208155028766E-1) * xx +
+                        2.00000000000000000009E0;
+    const double e = 1.0 + 2.0 * (px / (qx - px));
+    //2^n: biased exponent n + 1023 from the low mantissa bits of fn + 2^52
+    return e * double_of(bits_of(fn + 4503599627371519.0) << 52);
+}
+
+//---------------------------------------------------------
+inline float
+exp_kernel(float x) noexcept
+{
+    x = select(exp_in_range(x), x, 0.0f);
+    const float t = x * 1.44269504088896341f;
+    const auto n = std::int32_t(t + 128.5f) - 128;
+    const float fn = float(n);
+    x = x - fn * 0.693359375f;
+    x = x + fn * 2.12194440e-4f;
+
+    const float xx = x * x;
+    const float p = ((((1.9875691500E-4f * x +
+                        1.3981999507E-3f) * x +
+                        8.3334519073E-3f) * x +
+                        4.1665795894E-2f) * x +
+                        1.6666665459E-1f) * x +
+                        5.0000001201E-1f;
+    const float e = p * xx + x + 1.0f;
+    return e * float_of(bits_of(fn + 8388735.0f) << 23);
+}
+
+
+//-------------------------------------------------------------------
+inline double
+log_kernel(double x) noexcept
+{
+    //x = m * 2^e with m in [0.5,1)
+    const auto u = bits_of(x);
+    double e = double_of((u >> 52) | 0x4330000000000000ull) - 4503599627371518.0;
+    double m = double_of((u & 0x000FFFFFFFFFFFFFull) | 0x3FE0000000000000ull);
+
+    const bool small = m < 0.70710678118654752440;
+    const double h = select(small, 1.0, 0.0);
+    e = e - h;
+    m = m * (1.0 + h) - 1.0;
+
+    const double z = m * m;
+    const double p = ((((1.01875663804580931796E-4 * m +
+                         4.97494994976747001425E-1) * m +
+                         4.70579119878881725854E0) * m +
+                         1.44989225341610930846E1) * m +
+                         1.79368678507819816313E1) * m +
+                         7.70838733755885391666E0;
+    const double q = ((((m + 1.12873587189167450590E1) * m +
+                             4.52279145837532221105E1) * m +
+                             8.29875266912776603211E1) * m +
+                             7.11544750618563894466E1) * m +
+                             2.31251620126765340583E1;
+    double y = m * (z * p / q);
+    y = y - e * 2.121944400546905827679E-4;
+    y = y - 0.5 * z;
+    return (m + y) + e * 0.693359375;
+}
+
+//---------------------------------------------------------
+inline float
+log_kernel(float x) noexcept
+{
+    const auto u = bits_of(x);
+    float e = float_of((u >> 23) | 0x4B000000u) - 8388734.0f;
+    float m = float_of((u & 0x007FFFFFu) | 0x3F000000u);
+
+    const bool small = m < 0.707106781186547524f;
+    const float h = select(small, 1.0f, 0.0f);
+    e = e - h;
+    m = m * (1.0f + h) - 1.0f;
+
+    const float z = m * m;
+    const float p = ((((((( 7.0376836292E-2f * m -
+                             1.1514610310E-1f) * m +
+                             1.1676998740E-1f) * m -
+                             1.2420140846E-1f) * m +
+                             1.4249322787E-1f) * m -
+                             1.6668057665E-1f) * m +
+                             2.0000714765E-1f) * m -
+                             2.4999993993E-1f) * m +
+                             3.3333331174E-1f;
+    float y = m * z * p;
+    y = y - e * 2.12194440e-4f;
+    y = y - 0.5f * z;
+    return (m + y) + e * 0.693359375f;
+}
+
+
+//-------------------------------------------------------------------
+/// @brief reduces |x| to z in [-pi/4,pi/4] with |x| = z + j * pi/4
+///        and returns the bits of the (even) octant j in the lowest bits
+inline std::uint64_t
+trig_reduce(double x, double& z) noexcept
+{
+    const double a = std::abs(select(trig_in_range(x), x, 0.0));
+    auto j = std::int32_t(a * 1.27323954473516268615);
+    j = (j + 1) & ~1;
+    const double y = double(j);
+    z = ((a - y * 7.85398125648498535156E-1)
+           - y * 3.77489470793079817668E-8)
+           - y * 2.69515142907905952645E-15;
+    return bits_of(y + 4503599627370496.0);
+}
+
+//---------------------------------------------------------
+inline std::uint32_t
+trig_reduce(float x, float& z) noexcept
+{
+    const float a = std::abs(select(trig_in_range(x), x, 0.0f));
+    auto j = std::int32_t(a * 1.27323954473516f);
+    j = (j + 1) & ~1;
+    const float y = float(j);
+    z = ((a - y * 0.78515625f)
+           - y * 2.4187564849853515625e-4f)
+           - y * 3.77489497744594108e-8f;
+    return bits_of(y + 8388608.0f);
+}
+
+//---------------------------------------------------------
+/// @brief sine and cosine polynomials on [-pi/4,pi/4]
+inline double
+sin_poly(double z) noexcept
+{
+    const double zz = z * z;
+    return z + z * zz * (((((1.58962301576546568060E-10 * zz -
+                              2.50507477628578072866E-8) * zz +
+                              2.75573136213857245213E-6) * zz -
+                              1.98412698295895385996E-4) * zz +
+                              8.33333333332211858878E-3) * zz -
+                              1.66666666666666307295E-1);
+}
+
+inline double
+cos_poly(double z) noexcept
+{
+    const double zz = z * z;
+    return 1.0 - 0.5 * zz + zz * zz * (((((-1.13585365213876817300E-11 * zz +
+                                            2.08757008419747316778E-9) * zz -
+                                            2.75573141792967388112E-7) * zz +
+                                            2.48015872888517045348E-5) * zz -
+                                            1.38888888888730564116E-3) * zz +
+                                            4.16666666666665929218E-2);
+}
+
+inline float
+sin_poly(float z) noexcept
+{
+    const float zz = z * z;
+    return z + z * zz * ((-1.9515295891E-4f * zz +
+                           8.3321608736E-3f) * zz -
+                           1.6666654611E-1f);
+}
+
+inline float
+cos_poly(float z) noexcept
+{
+    const float zz = z * z;
+    return 1.0f - 0.5f * zz + zz * zz * ((2.443315711809948E-5f * zz -
+                                           1.388731625493765E-3f) * zz +
+                                           4.166664568298827E-2f);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline T
+sin_kernel(T x) noexcept
+{
+    T z;
+    const auto j = trig_reduce(x, z);
+    const T s = sin_poly(z);
+    const T c = cos_poly(z);
+    return negate_if(((j & 4) != 0) != (x < T(0)), select((j & 2) != 0, c, s));
+}
+
+//---------------------------------------------------------
+template<class T>
+inline T
+cos_kernel(T x) noexcept
+{
+    T z;
+    const auto j = trig_reduce(x, z);
+    const T s = sin_poly(z);
+    const T c = cos_poly(z);
+    return negate_if(((j + 2) & 4) != 0, select((j & 2) != 0, s, c));
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+using has_pack_kernels = std::integral_constant<bool,
+    std::is_same<T,float>::value || std::is_same<T,double>::value>;
+
+//---------------------------------------------------------
+/// @brief evaluates kernel on all lanes,
+///        lanes outside of the kernel's domain are recomputed by fallback
+template<class T, std::size_t W, class Kernel, class InRange, class Fallback>
+inline simd_pack<T,W>
+map_kernel(const simd_pack<T,W>& x, Kernel kernel, InRange inRange,
+           Fallback fallback, std::true_type)
+{
+    bool inside = true;
+    for(std::size_t i = 0; i < W; ++i) inside = inside & inRange(x[i]);
+
+    if(!inside) return map_lanes(x, fallback);
+
+    simd_pack<T,W> r;
+    for(std::size_t i = 0; i < W; ++i) r[i] = kernel(x[i]);
+    return r;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W, class Kernel, class InRange, class Fallback>
+inline simd_pack<T,W>
+map_kernel(const simd_pack<T,W>& x, Kernel, InRange,
+           Fallback fallback, std::false_type)
+{
+    return map_lanes(x, fallback);
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+abs(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::abs; return abs(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+min(const simd_pack<T,W>& x, const simd_pack<T,W>& y) {
+    return map_lanes(x, y, [](T a, T b) { return (b < a) ? b : a; });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+max(const simd_pack<T,W>& x, const simd_pack<T,W>& y) {
+    return map_lanes(x, y, [](T a, T b) { return (a < b) ? b : a; });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+ceil(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::ceil; return ceil(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+floor(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::floor; return floor(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+sqrt(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::sqrt; return sqrt(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+cbrt(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::cbrt; return cbrt(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+pow(const simd_pack<T,W>& b, const simd_pack<T,W>& e) {
+    return map_lanes(b, e, [](T x, T y) { using std::pow; return pow(x,y); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+pow(const simd_pack<T,W>& b, const T& e) {
+    return map_lanes(b, [&e](T x) { using std::pow; return pow(x,e); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+exp(const simd_pack<T,W>& x) {
+    return detail::map_kernel(x,
+        [](auto a) { return detail::exp_kernel(a); },
+        [](auto a) { return detail::exp_in_range(a); },
+        [](T a) { using std::exp; return exp(a); },
+        detail::has_pack_kernels<T>{});
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+exp2(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::exp2; return exp2(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+expm1(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::expm1; return expm1(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+log(const simd_pack<T,W>& x) {
+    return detail::map_kernel(x,
+        [](auto a) { return detail::log_kernel(a); },
+        [](auto a) { return detail::log_in_range(a); },
+        [](T a) { using std::log; return log(a); },
+        detail::has_pack_kernels<T>{});
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+log2(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::log2; return log2(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+log10(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::log10; return log10(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+log1p(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::log1p; return log1p(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+sin(const simd_pack<T,W>& x) {
+    return detail::map_kernel(x,
+        [](auto a) { return detail::sin_kernel(a); },
+        [](auto a) { return detail::trig_in_range(a); },
+        [](T a) { using std::sin; return sin(a); },
+        detail::has_pack_kernels<T>{});
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+cos(const simd_pack<T,W>& x) {
+    return detail::map_kernel(x,
+        [](auto a) { return detail::cos_kernel(a); },
+        [](auto a) { return detail::trig_in_range(a); },
+        [](T a) { using std::cos; return cos(a); },
+        detail::has_pack_kernels<T>{});
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+tan(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::tan; return tan(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+asin(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::asin; return asin(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+acos(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::acos; return acos(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+atan(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::atan; return atan(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+sinh(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::sinh; return sinh(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+cosh(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::cosh; return cosh(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+tanh(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::tanh; return tanh(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+asinh(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::asinh; return asinh(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+acosh(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::acosh; return acosh(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+atanh(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::atanh; return atanh(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+erf(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::erf; return erf(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+erfc(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::erfc; return erfc(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+tgamma(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::tgamma; return tgamma(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+lgamma(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::lgamma; return lgamma(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+digamma(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { return digamma(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+trunc(const simd_pack<T,W>& x) {
+    return map_lanes(x, [](T a) { using std::trunc; return trunc(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+atan2(const simd_pack<T,W>& y, const simd_pack<T,W>& x) {
+    return map_lanes(y, x, [](T a, T b) { using std::atan2; return atan2(a,b); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+hypot(const simd_pack<T,W>& x, const simd_pack<T,W>& y) {
+    return map_lanes(x, y, [](T a, T b) { using std::hypot; return hypot(a,b); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+fmod(const simd_pack<T,W>& x, const simd_pack<T,W>& y) {
+    return map_lanes(x, y, [](T a, T b) { using std::fmod; return fmod(a,b); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t W>
+inline auto
+fma(simd_pack<T,W> a, const simd_pack<T,W>& b, const simd_pack<T,W>& c) {
+    using std::fma;
+    for(std::size_t i = 0; i < W; ++i) a[i] = fma(a[i], b[i], c[i]);
+    return a;
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * TRAITS SPECIALIZATIONS
+ *
+ *****************************************************************************/
+template<class T, std::size_t W>
+struct is_number<simd_pack<T,W>> : std::true_type {};
+
+template<class T, std::size_t W>
+struct is_number<simd_pack<T,W>&> : std::true_type {};
+
+template<class T, std::size_t W>
+struct is_number<simd_pack<T,W>&&> : std::true_type {};
+
+template<class T, std::size_t W>
+struct is_number<const simd_pack<T,W>&> : std::true_type {};
+
+template<class T, std::size_t W>
+struct is_number<const simd_pack<T,W>> : std::true_type {};
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t W>
+struct is_floating_point<simd_pack<T,W>> :
+    std::integral_constant<bool, is_floating_point<T>::value>
+{};
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t W, class T2>
+struct common_numeric_type<simd_pack<T,W>,T2>
+{
+    using type = simd_pack<common_numeric_t<T,T2>,W>;
+};
+//---------------------------------------------------------
+template<class T, std::size_t W, class T2>
+struct common_numeric_type<T2,simd_pack<T,W>>
+{
+    using type = simd_pack<common_numeric_t<T,T2>,W>;
+};
+//---------------------------------------------------------
+template<class T1, class T2, std::size_t W>
+struct common_numeric_type<simd_pack<T1,W>,simd_pack<T2,W>>
+{
+    using type = simd_pack<common_numeric_t<T1,T2>,W>;
+};
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,112 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_SINCOS_H_
+#define AM_NUMERIC_SINCOS_H_
+
+#include <cmath>
+#include <type_traits>
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * FUSED EVALUATION HELPERS
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief computes sine and cosine of x in one go
+template<class T>
+inline void
+sin_cos(const T& x, T& s, T& c)
+{
+    using std::sin;
+    using std::cos;
+    s = sin(x);
+    c = cos(x);
+}
+
+#if defined(__GNUC__)
+inline void
+sin_cos(float x, float& s, float& c) {
+    __builtin_sincosf(x, &s, &c);
+}
+
+inline void
+sin_cos(double x, double& s, double& c) {
+    __builtin_sincos(x, &s, &c);
+}
+
+inline void
+sin_cos(long double x, long double& s, long double& c) {
+    __builtin_sincosl(x, &s, &c);
+}
+#endif
+
+
+//-------------------------------------------------------------------
+/// @brief computes hyperbolic sine and cosine of x
+template<class T>
+inline void
+sinh_cosh(const T& x, T& s, T& c, std::false_type)
+{
+    using std::sinh;
+    using std::cosh;
+    s = sinh(x);
+    c = cosh(x);
+}
+
+//---------------------------------------------------------
+/// @brief computes hyperbolic sine and cosine of x with one expm1 call
+template<class T>
+inline void
+sinh_cosh(const T& x, T& s, T& c, std::true_type)
+{
+    using std::expm1;
+    using std::abs;
+    using std::isfinite;
+
+    const auto ax = abs(x);
+    // e^|x| - 1; avoids cancellation in sinh for small arguments
+    const auto u = expm1(ax);
+
+    if(!isfinite(u)) {
+        sinh_cosh(x, s, c, std::false_type{});
+        return;
+    }
+    const auto e = u + T(1);
+    s = (u + (u / e)) / T(2);
+    c = (e + (T(1) / e)) / T(2);
+    if(x < T(0)) s = -s;
+}
+
+//---------------------------------------------------------
+/// @brief fused path only for builtin floating-point types;
+///        other number types (e.g. simd_pack) use their own sinh/cosh
+template<class T>
+inline void
+sinh_cosh(const T& x, T& s, T& c)
+{
+    sinh_cosh(x, s, c, std::is_floating_point<T>{});
+}
+
+}  // namespace detail
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,1151 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#ifndef AM_NUMERIC_SPARSE_DUAL_H_
+#define AM_NUMERIC_SPARSE_DUAL_H_
+
+#include <cmath>
+#include <cfloat>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "traits.h"
+#include "dual.h"
+#include "sincos.h"
+#include "block_pool.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class,std::size_t,class> class sparse_dual;
+
+template<class>
+struct is_sparse_dual :
+    std::false_type
+{};
+
+template<class T, std::size_t N, class I>
+struct is_sparse_dual<sparse_dual<T,N,I>> :
+    std::true_type
+{};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief
+ * dual number r + sum_i e_i * d_i with sparse tangent vector d
+ * (e_i are independent dual units with e_i*e_j = 0)
+ *
+ * Non-zero partial derivatives are stored as (index, value) pairs
+ * sorted by index; up to N pairs are kept inline, larger tangents are
+ * stored in pooled heap blocks.
+ *
+ *****************************************************************************/
+template<class NumberType, std::size_t N = 4, class IndexType = std::uint32_t>
+class sparse_dual
+{
+    static_assert(N > 0, "sparse_dual<T,N>: N must be at least 1");
+
+public:
+
+    static_assert(std::is_arithmetic<NumberType>::value,
+        "sparse_dual<T>: T must be a builtin arithmetic type");
+
+    static_assert(std::is_integral<IndexType>::value,
+        "sparse_dual<T,N,I>: I must be an integral type");
+
+
+    //---------------------------------------------------------------
+    using value_type      = NumberType;
+    using numeric_type    = value_type;
+    using index_type      = IndexType;
+    using size_type       = std::size_t;
+
+    struct entry {
+        index_type index;
+        value_type value;
+    };
+
+    using const_iterator  = const entry*;
+
+
+    //---------------------------------------------------------------
+    /// @brief default constructor
+    sparse_dual() noexcept :
+        r_(0), n_(0), cap_(N), heap_(nullptr)
+    {}
+
+    /// @brief constant
+    explicit
+    sparse_dual(const value_type& r) noexcept :
+        r_(r), n_(0), cap_(N), heap_(nullptr)
+    {}
+
+    /// @brief independent variable i with value r and seed d
+    sparse_dual(const value_type& r, index_type i,
+                const value_type& d = value_type(1)) noexcept
+    :
+        sparse_dual(r)
+    {
+        buf_[0] = entry{i, d};
+        n_ = 1;
+    }
+
+
+    //---------------------------------------------------------------
+    sparse_dual(const sparse_dual& o):
+        sparse_dual(o.r_)
+    {
+        assign_tangent(o);
+    }
+
+    sparse_dual(sparse_dual&& o) noexcept :
+        sparse_dual(o.r_)
+    {
+        steal_tangent(o);
+    }
+
+
+    //---------------------------------------------------------------
+    sparse_dual&
+    operator = (const sparse_dual& o)
+    {
+        if(this != &o) {
+            r_ = o.r_;
+            assign_tangent(o);
+        }
+        return *this;
+    }
+
+    sparse_dual&
+    operator = (sparse_dual&& o) noexcept
+    {
+        if(this != &o) {
+            r_ = o.r_;
+            release();
+            steal_tangent(o);
+        }
+        return *this;
+    }
+
+    //-----------------------------------------------------
+    sparse_dual&
+    operator = (const value_type& r) noexcept
+    {
+        r_ = r;
+        n_ = 0;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    ~sparse_dual() {
+        release();
+    }
+
+
+    //---------------------------------------------------------------
+    const value_type&
+    real() const noexcept {
+        return r_;
+    }
+
+    sparse_dual&
+    real(const value_type& v) noexcept {
+        r_ = v;
+        return *this;
+    }
+
+    /// @brief partial derivative with respect to variable i
+    value_type
+    imag(index_type i) const noexcept {
+        const auto e = std::lower_bound(begin(), end(), i,
+            [](const entry& a, index_type b) { return a.index < b; });
+        return (e != end() && e->index == i) ? e->value : value_type(0);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief number of stored partial derivatives
+    size_type
+    size() const noexcept {
+        return n_;
+    }
+
+    bool
+    empty() const noexcept {
+        return n_ == 0;
+    }
+
+    size_type
+    capacity() const noexcept {
+        return cap_;
+    }
+
+    static constexpr size_type
+    inline_capacity() noexcept {
+        return N;
+    }
+
+    //-----------------------------------------------------
+    const_iterator
+    begin() const noexcept {
+        return data();
+    }
+
+    const_iterator
+    end() const noexcept {
+        return data() + n_;
+    }
+
+
+    //---------------------------------------------------------------
+    void
+    reserve(size_type n)
+    {
+        if(n <= cap_) return;
+
+        auto p = detail::block_pool<entry>::allocate(n);
+        std::copy(begin(), end(), p);
+        if(heap_) detail::block_pool<entry>::deallocate(heap_, cap_);
+        heap_ = p;
+        cap_ = n;
+    }
+
+    //-----------------------------------------------------
+    /// @brief appends a partial derivative;
+    ///        i must be greater than all stored indices
+    void
+    append(index_type i, const value_type& d)
+    {
+        if(n_ == cap_) reserve(2 * cap_);
+        data()[n_] = entry{i, d};
+        ++n_;
+    }
+
+    //-----------------------------------------------------
+    /// @brief adds d to the partial derivative with respect to i
+    void
+    insert(index_type i, const value_type& d)
+    {
+        auto e = std::lower_bound(data(), data() + n_, i,
+            [](const entry& a, index_type b) { return a.index < b; });
+
+        if(e != data() + n_ && e->index == i) {
+            e->value += d;
+            return;
+        }
+        const auto pos = size_type(e - data());
+        if(n_ == cap_) reserve(2 * cap_);
+        std::copy_backward(data() + pos, data() + n_, data() + n_ + 1);
+        data()[pos] = entry{i, d};
+        ++n_;
+    }
+
+
+    //---------------------------------------------------------------
+    sparse_dual&
+    negate() noexcept {
+        r_ = -r_;
+        for(size_type k = 0; k < n_; ++k) data()[k].value = -data()[k].value;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // sparse_dual (op)= number
+    //---------------------------------------------------------------
+    sparse_dual&
+    operator += (const value_type& v) noexcept {
+        r_ += v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    sparse_dual&
+    operator -= (const value_type& v) noexcept {
+        r_ -= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    sparse_dual&
+    operator *= (const value_type& v) noexcept {
+        r_ *= v;
+        for(size_type k = 0; k < n_; ++k) data()[k].value *= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    sparse_dual&
+    operator /= (const value_type& v) noexcept {
+        r_ /= v;
+        for(size_type k = 0; k < n_; ++k) data()[k].value /= v;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // sparse_dual (op)= sparse_dual
+    //---------------------------------------------------------------
+    sparse_dual&
+    operator += (const sparse_dual& o) {
+        return (*this = chain(r_ + o.r_, value_type(1), *this,
+                                         value_type(1), o));
+    }
+    //-----------------------------------------------------
+    sparse_dual&
+    operator -= (const sparse_dual& o) {
+        return (*this = chain(r_ - o.r_, value_type( 1), *this,
+                                         value_type(-1), o));
+    }
+    //-----------------------------------------------------
+    sparse_dual&
+    operator *= (const sparse_dual& o) {
+        return (*this = chain(r_ * o.r_, o.r_, *this, r_, o));
+    }
+    //-----------------------------------------------------
+    sparse_dual&
+    operator /= (const sparse_dual& o) {
+        const auto inv = value_type(1) / o.r_;
+        return (*this = chain(r_ * inv, inv, *this, -r_ * inv * inv, o));
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief returns fr + a * x.tangent
+    static sparse_dual
+    chain(const value_type& fr, const value_type& a, const sparse_dual& x)
+    {
+        sparse_dual res {fr};
+        res.reserve(x.n_);
+        for(const auto& e : x) res.data()[res.n_++] = entry{e.index, a * e.value};
+        return res;
+    }
+
+    //-----------------------------------------------------
+    /// @brief returns fr + a * x.tangent + b * y.tangent
+    static sparse_dual
+    chain(const value_type& fr,
+          const value_type& a, const sparse_dual& x,
+          const value_type& b, const sparse_dual& y)
+    {
+        sparse_dual res {fr};
+        res.reserve(x.n_ + y.n_);
+
+        auto i = x.begin();
+        auto j = y.begin();
+        auto out = res.data();
+        while(i != x.end() && j != y.end()) {
+            if(i->index < j->index) {
+                *out++ = entry{i->index, a * i->value};
+                ++i;
+            } else if(j->index < i->index) {
+                *out++ = entry{j->index, b * j->value};
+                ++j;
+            } else {
+                *out++ = entry{i->index, (a * i->value) + (b * j->value)};
+                ++i;
+                ++j;
+            }
+        }
+        for(; i != x.end(); ++i) *out++ = entry{i->index, a * i->value};
+        for(; j != y.end(); ++j) *out++ = entry{j->index, b * j->value};
+
+        res.n_ = size_type(out - res.data());
+        return res;
+    }
+
+
+private:
+
+    //---------------------------------------------------------------
+    entry*
+    data() noexcept {
+        return heap_ ? heap_ : buf_;
+    }
+
+    const entry*
+    data() const noexcept {
+        return heap_ ? heap_ : buf_;
+    }
+
+    //---------------------------------------------------------------
+    void
+    assign_tangent(const sparse_dual& o)
+    {
+        n_ = 0;
+        reserve(o.n_);
+        std::copy(o.begin(), o.end(), data());
+        n_ = o.n_;
+    }
+
+    void
+    steal_tangent(sparse_dual& o) noexcept
+    {
+        if(o.heap_) {
+            heap_ = o.heap_;
+            cap_ = o.cap_;
+            o.heap_ = nullptr;
+            o.cap_ = N;
+        } else {
+            std::copy(o.begin(), o.end(), buf_);
+        }
+        n_ = o.n_;
+        o.n_ = 0;
+    }
+
+    void
+    release() noexcept
+    {
+        if(heap_) {
+            detail::block_pool<entry>::deallocate(heap_, cap_);
+            heap_ = nullptr;
+            cap_ = N;
+        }
+        n_ = 0;
+    }
+
+
+    //---------------------------------------------------------------
+    value_type r_;
+    size_type n_;
+    size_type cap_;
+    entry* heap_;
+    entry buf_[N];
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+/// @brief independent variable with index i
+template<class T, class I, class = std::enable_if_t<
+    std::is_arithmetic<T>::value && std::is_integral<I>::value>>
+inline auto
+make_sparse_dual(const T& x, I i)
+{
+    return sparse_dual<T>{x, typename sparse_dual<T>::index_type(i)};
+}
+
+
+
+//-------------------------------------------------------------------
+// I/O
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I, class Ostream>
+inline Ostream&
+print(Ostream& os, const sparse_dual<T,N,I>& x)
+{
+    os << "(" << x.real();
+    for(const auto& e : x) os << "," << e.index << ":" << e.value;
+    return (os << ")");
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * ACCESS
+ *
+ *****************************************************************************/
+template<class T, std::size_t N, class I>
+inline decltype(auto)
+real(const sparse_dual<T,N,I>& x) noexcept
+{
+    return x.real();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * COMPARISON
+ *
+ *****************************************************************************/
+template<class T, std::size_t N, class I>
+inline bool
+operator == (const sparse_dual<T,N,I>& a, const sparse_dual<T,N,I>& b)
+{
+    if(a.real() != b.real() || a.size() != b.size()) return false;
+
+    return std::equal(a.begin(), a.end(), b.begin(),
+        [](const auto& x, const auto& y) {
+            return x.index == y.index && x.value == y.value;
+        });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline bool
+operator != (const sparse_dual<T,N,I>& a, const sparse_dual<T,N,I>& b)
+{
+    return !(a == b);
+}
+
+
+
+//-------------------------------------------------------------------
+// COMPARISON WITH INTEGERS OR REAL NUMBERS
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I, class T2, class = std::enable_if_t<
+    !is_sparse_dual<T2>::value && is_number<T2>::value>>
+inline bool
+operator < (const sparse_dual<T,N,I>& x, const T2& r)
+{
+    return (x.real() < r);
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class I, class T2, class = std::enable_if_t<
+    !is_sparse_dual<T2>::value && is_number<T2>::value>>
+inline bool
+operator < (const T2& r, const sparse_dual<T,N,I>& x)
+{
+    return (r < x.real());
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I, class T2, class = std::enable_if_t<
+    !is_sparse_dual<T2>::value && is_number<T2>::value>>
+inline bool
+operator > (const sparse_dual<T,N,I>& x, const T2& r)
+{
+    return (x.real() > r);
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class I, class T2, class = std::enable_if_t<
+    !is_sparse_dual<T2>::value && is_number<T2>::value>>
+inline bool
+operator > (const T2& r, const sparse_dual<T,N,I>& x)
+{
+    return (r > x.real());
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * ARITHMETIC
+ *
+ *****************************************************************************/
+template<class T, std::size_t N, class I>
+inline auto
+operator + (const sparse_dual<T,N,I>& x, const sparse_dual<T,N,I>& y)
+{
+    return sparse_dual<T,N,I>::chain(x.real() + y.real(), T(1), x, T(1), y);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I, class T2, class = std::enable_if_t<
+    !is_sparse_dual<T2>::value && is_number<T2>::value>>
+inline auto
+operator + (sparse_dual<T,N,I> x, const T2& y)
+{
+    return x += T(y);
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class I, class T2, class = std::enable_if_t<
+    !is_sparse_dual<T2>::value && is_number<T2>::value>>
+inline auto
+operator + (const T2& y, sparse_dual<T,N,I> x)
+{
+    return x += T(y);
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+operator - (const sparse_dual<T,N,I>& x, const sparse_dual<T,N,I>& y)
+{
+    return sparse_dual<T,N,I>::chain(x.real() - y.real(), T(1), x, T(-1), y);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I, class T2, class = std::enable_if_t<
+    !is_sparse_dual<T2>::value && is_number<T2>::value>>
+inline auto
+operator - (sparse_dual<T,N,I> x, const T2& y)
+{
+    return x -= T(y);
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class I, class T2, class = std::enable_if_t<
+    !is_sparse_dual<T2>::value && is_number<T2>::value>>
+inline auto
+operator - (const T2& y, sparse_dual<T,N,I> x)
+{
+    return x.negate() += T(y);
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+operator * (const sparse_dual<T,N,I>& x, const sparse_dual<T,N,I>& y)
+{
+    return sparse_dual<T,N,I>::chain(
+        x.real() * y.real(), y.real(), x, x.real(), y);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I, class T2, class = std::enable_if_t<
+    !is_sparse_dual<T2>::value && is_number<T2>::value>>
+inline auto
+operator * (sparse_dual<T,N,I> x, const T2& y)
+{
+    return x *= T(y);
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class I, class T2, class = std::enable_if_t<
+    !is_sparse_dual<T2>::value && is_number<T2>::value>>
+inline auto
+operator * (const T2& y, sparse_dual<T,N,I> x)
+{
+    return x *= T(y);
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+operator / (const sparse_dual<T,N,I>& x, const sparse_dual<T,N,I>& y)
+{
+    const auto inv = T(1) / y.real();
+    return sparse_dual<T,N,I>::chain(
+        x.real() * inv, inv, x, -x.real() * inv * inv, y);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I, class T2, class = std::enable_if_t<
+    !is_sparse_dual<T2>::value && is_number<T2>::value>>
+inline auto
+operator / (sparse_dual<T,N,I> x, const T2& y)
+{
+    return x /= T(y);
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class I, class T2, class = std::enable_if_t<
+    !is_sparse_dual<T2>::value && is_number<T2>::value>>
+inline auto
+operator / (const T2& y, const sparse_dual<T,N,I>& x)
+{
+    const auto inv = T(1) / x.real();
+    return sparse_dual<T,N,I>::chain(T(y) * inv, -T(y) * inv * inv, x);
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+operator - (sparse_dual<T,N,I> x)
+{
+    return x.negate();
+}
+
+
+
+
+/*************************************************************************//***
+ *
+ *
+ * FUNCTIONS
+ *
+ * @note f(r + sum_i e_i*d_i) = f(r) + sum_i d_i*f'(r) * e_i
+ *
+ *
+ *****************************************************************************/
+template<class T, std::size_t N, class I>
+inline auto
+ceil(const sparse_dual<T,N,I>& x)
+{
+    using std::ceil;
+    return sparse_dual<T,N,I>{ceil(x.real())};
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+floor(const sparse_dual<T,N,I>& x)
+{
+    using std::floor;
+    return sparse_dual<T,N,I>{floor(x.real())};
+}
+
+
+//-------------------------------------------------------------------
+// ABSOLUTE
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+abs(const sparse_dual<T,N,I>& x)
+{
+    using std::abs;
+    return sparse_dual<T,N,I>::chain(abs(x.real()),
+        (x.real() < T(0)) ? T(-1) : T(1), x);
+}
+
+//---------------------------------------------------------
+/// @brief magnitude squared
+template<class T, std::size_t N, class I>
+inline auto
+abs2(const sparse_dual<T,N,I>& x)
+{
+    return sparse_dual<T,N,I>::chain(x.real() * x.real(), T(2) * x.real(), x);
+}
+
+
+
+//-------------------------------------------------------------------
+// ROOTS
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+sqrt(const sparse_dual<T,N,I>& x)
+{
+    using std::sqrt;
+    const auto sqrt_r = sqrt(x.real());
+    return sparse_dual<T,N,I>::chain(sqrt_r, T(1) / (T(2) * sqrt_r), x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+cbrt(const sparse_dual<T,N,I>& x)
+{
+    using std::cbrt;
+    const auto cbrt_r = cbrt(x.real());
+    return sparse_dual<T,N,I>::chain(cbrt_r,
+        T(1) / (T(3) * cbrt_r * cbrt_r), x);
+}
+
+
+
+//-------------------------------------------------------------------
+// EXPONENTIATION
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+pow(const sparse_dual<T,N,I>& b, const sparse_dual<T,N,I>& e)
+{
+    using std::pow;
+    using std::log;
+
+    const auto b_e_1 = pow(b.real(), e.real() - T(1));
+    const auto b_e = b_e_1 * b.real();
+    //only evaluate the logarithm if the exponent is not constant
+    const auto dfde = e.empty() ? T(0) : b_e * log(b.real());
+
+    return sparse_dual<T,N,I>::chain(b_e, e.real() * b_e_1, b, dfde, e);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+pow(const sparse_dual<T,N,I>& b, const T& e)
+{
+    using std::pow;
+    const auto b_e_1 = pow(b.real(), e - T(1));
+    return sparse_dual<T,N,I>::chain(b_e_1 * b.real(), e * b_e_1, b);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+exp(const sparse_dual<T,N,I>& x)
+{
+    using std::exp;
+    const auto expr = exp(x.real());
+    return sparse_dual<T,N,I>::chain(expr, expr, x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+exp2(const sparse_dual<T,N,I>& x)
+{
+    using std::exp2;
+    const auto exp2r = exp2(x.real());
+    return sparse_dual<T,N,I>::chain(exp2r,
+        exp2r * T(0.69314718055994530941723212145817656807550013436026), x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+expm1(const sparse_dual<T,N,I>& x)
+{
+    using std::expm1;
+    const auto expm1r = expm1(x.real());
+    return sparse_dual<T,N,I>::chain(expm1r, expm1r + T(1), x);
+}
+
+
+
+//-------------------------------------------------------------------
+// LOGARITHMS
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+log(const sparse_dual<T,N,I>& x)
+{
+    using std::log;
+    return sparse_dual<T,N,I>::chain(log(x.real()), T(1) / x.real(), x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+log10(const sparse_dual<T,N,I>& x)
+{
+    using std::log10;
+    return sparse_dual<T,N,I>::chain(log10(x.real()), T(1) /
+        (x.real() * T(2.3025850929940456840179914546843642076011014886288)), x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+log2(const sparse_dual<T,N,I>& x)
+{
+    using std::log2;
+    return sparse_dual<T,N,I>::chain(log2(x.real()), T(1) /
+        (x.real() * T(0.69314718055994530941723212145817656807550013436026)), x);
+}
+
+//---------------------------------------------------------
+/// @brief logarithm to floating-point basis (FLT_RADIX)
+template<class T, std::size_t N, class I>
+inline auto
+logb(const sparse_dual<T,N,I>& x)
+{
+    using std::logb;
+    using std::log;
+    return sparse_dual<T,N,I>::chain(logb(x.real()),
+        T(1) / (x.real() * log(T(FLT_RADIX))), x);
+}
+
+//---------------------------------------------------------
+/// @brief logarithm of 1 + x
+template<class T, std::size_t N, class I>
+inline auto
+log1p(const sparse_dual<T,N,I>& x)
+{
+    using std::log1p;
+    return sparse_dual<T,N,I>::chain(log1p(x.real()),
+        T(1) / (T(1) + x.real()), x);
+}
+
+//---------------------------------------------------------
+/// @brief logarithm to any base
+template<class T, std::size_t N, class I>
+inline auto
+log_base(const T& base, const sparse_dual<T,N,I>& x)
+{
+    using std::log;
+    const auto logbase_inv = T(1) / log(base);
+    return sparse_dual<T,N,I>::chain(log(x.real()) * logbase_inv,
+        logbase_inv / x.real(), x);
+}
+
+
+
+//-------------------------------------------------------------------
+// TRIGONOMETRIC
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+sin(const sparse_dual<T,N,I>& x)
+{
+    T s, c;
+    detail::sin_cos(x.real(), s, c);
+    return sparse_dual<T,N,I>::chain(s, c, x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+cos(const sparse_dual<T,N,I>& x)
+{
+    T s, c;
+    detail::sin_cos(x.real(), s, c);
+    return sparse_dual<T,N,I>::chain(c, -s, x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline void
+sincos(const sparse_dual<T,N,I>& x,
+       sparse_dual<T,N,I>& s, sparse_dual<T,N,I>& c)
+{
+    T sr, cr;
+    detail::sin_cos(x.real(), sr, cr);
+    s = sparse_dual<T,N,I>::chain(sr, cr, x);
+    c = sparse_dual<T,N,I>::chain(cr, -sr, x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+tan(const sparse_dual<T,N,I>& x)
+{
+    using std::tan;
+    const auto tanr = tan(x.real());
+    return sparse_dual<T,N,I>::chain(tanr, T(1) + (tanr * tanr), x);
+}
+
+
+
+//-------------------------------------------------------------------
+// INVERSE TRIGONOMETRIC
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+asin(const sparse_dual<T,N,I>& x)
+{
+    using std::asin;
+    using std::sqrt;
+    return sparse_dual<T,N,I>::chain(asin(x.real()),
+        T(1) / sqrt(T(1) - (x.real() * x.real())), x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+acos(const sparse_dual<T,N,I>& x)
+{
+    using std::acos;
+    using std::sqrt;
+    return sparse_dual<T,N,I>::chain(acos(x.real()),
+        T(-1) / sqrt(T(1) - (x.real() * x.real())), x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+atan(const sparse_dual<T,N,I>& x)
+{
+    using std::atan;
+    return sparse_dual<T,N,I>::chain(atan(x.real()),
+        T(1) / (T(1) + (x.real() * x.real())), x);
+}
+
+
+
+//-------------------------------------------------------------------
+// HYPERBOLIC
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+sinh(const sparse_dual<T,N,I>& x)
+{
+    T s, c;
+    detail::sinh_cosh(x.real(), s, c);
+    return sparse_dual<T,N,I>::chain(s, c, x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+cosh(const sparse_dual<T,N,I>& x)
+{
+    T s, c;
+    detail::sinh_cosh(x.real(), s, c);
+    return sparse_dual<T,N,I>::chain(c, s, x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline void
+sinhcosh(const sparse_dual<T,N,I>& x,
+         sparse_dual<T,N,I>& s, sparse_dual<T,N,I>& c)
+{
+    T sr, cr;
+    detail::sinh_cosh(x.real(), sr, cr);
+    s = sparse_dual<T,N,I>::chain(sr, cr, x);
+    c = sparse_dual<T,N,I>::chain(cr, sr, x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+tanh(const sparse_dual<T,N,I>& x)
+{
+    using std::tanh;
+    //s / c would give inf / inf for large |x|
+    const auto t = tanh(x.real());
+    return sparse_dual<T,N,I>::chain(t, T(1) - t * t, x);
+}
+
+
+
+//-------------------------------------------------------------------
+// INVERSE HYPERBOLIC
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+asinh(const sparse_dual<T,N,I>& x)
+{
+    using std::asinh;
+    using std::sqrt;
+    return sparse_dual<T,N,I>::chain(asinh(x.real()),
+        T(1) / sqrt((x.real() * x.real()) + T(1)), x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+acosh(const sparse_dual<T,N,I>& x)
+{
+    using std::acosh;
+    using std::sqrt;
+    return sparse_dual<T,N,I>::chain(acosh(x.real()),
+        T(1) / sqrt((x.real() * x.real()) - T(1)), x);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline auto
+atanh(const sparse_dual<T,N,I>& x)
+{
+    using std::atanh;
+    return sparse_dual<T,N,I>::chain(atanh(x.real()),
+        T(1) / (T(1) - (x.real() * x.real())), x);
+}
+
+
+
+//-------------------------------------------------------------------
+//
+//-------------------------------------------------------------------
+///@brief  error function
+template<class T, std::size_t N, class I>
+inline auto
+erf(const sparse_dual<T,N,I>& x)
+{
+    using std::erf;
+    using std::exp;
+    return sparse_dual<T,N,I>::chain(erf(x.real()),
+        exp(-x.real() * x.real()) *
+            T(1.1283791670955125738961589031215451716881012586580), x);
+}
+
+//---------------------------------------------------------
+///@brief complementary error function
+template<class T, std::size_t N, class I>
+inline auto
+erfc(const sparse_dual<T,N,I>& x)
+{
+    using std::erfc;
+    using std::exp;
+    return sparse_dual<T,N,I>::chain(erfc(x.real()),
+        -exp(-x.real() * x.real()) *
+            T(1.1283791670955125738961589031215451716881012586580), x);
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline bool
+isfinite(const sparse_dual<T,N,I>& x)
+{
+    using std::isfinite;
+    if(!isfinite(x.real())) return false;
+    for(const auto& e : x) {
+        if(!isfinite(e.value)) return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline bool
+isinf(const sparse_dual<T,N,I>& x)
+{
+    using std::isinf;
+    if(isinf(x.real())) return true;
+    for(const auto& e : x) {
+        if(isinf(e.value)) return true;
+    }
+    return false;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class I>
+inline bool
+isnan(const sparse_dual<T,N,I>& x)
+{
+    using std::isnan;
+    if(isnan(x.real())) return true;
+    for(const auto& e : x) {
+        if(isnan(e.value)) return true;
+    }
+    return false;
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * TRAITS SPECIALIZATIONS
+ *
+ *****************************************************************************/
+template<class T, std::size_t N, class I>
+struct is_number<sparse_dual<T,N,I>> : std::true_type {};
+
+template<class T, std::size_t N, class I>
+struct is_number<sparse_dual<T,N,I>&> : std::true_type {};
+
+template<class T, std::size_t N, class I>
+struct is_number<sparse_dual<T,N,I>&&> : std::true_type {};
+
+template<class T, std::size_t N, class I>
+struct is_number<const sparse_dual<T,N,I>&> : std::true_type {};
+
+template<class T, std::size_t N, class I>
+struct is_number<const sparse_dual<T,N,I>> : std::true_type {};
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class I>
+struct is_floating_point<sparse_dual<T,N,I>> :
+    std::integral_constant<bool, is_floating_point<T>::value>
+{};
+
+
+}  // namespace num
+}  // namespace am
+
+
+#endif
@@ -0,0 +1,274 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/big_integer.h"
+#include  "../include/rational.h"
+
+#include <stdexcept>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <system_error>
+#include <iostream>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+void test_small_values()
+{
+    const big_integer a {123456789};
+    const big_integer b {-987654321};
+
+    if(!a.is_small() || !b.is_small() ||
+       (a + b) != big_integer{-864197532} ||
+       (a - b) != big_integer{1111111110} ||
+       (a * b) != big_integer{-121932631112635269LL} ||
+       (b / a) != big_integer{-8} ||
+       (b % a) != big_integer{-9} ||
+       !(b < a) || !(a > 0) || a == b)
+    {
+        throw std::runtime_error{"big_integer: small values"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void test_spilling()
+{
+    constexpr auto max = std::numeric_limits<std::int64_t>::max();
+    constexpr auto min = std::numeric_limits<std::int64_t>::min();
+
+    big_integer a {max};
+    ++a;
+    if(a.is_small() || a.str() != "9223372036854775808") {
+        throw std::runtime_error{"big_integer: overflow into heap"};
+    }
+    --a;
+    if(!a.is_small() || a != big_integer{max}) {
+        throw std::runtime_error{"big_integer: back to inline storage"};
+    }
+
+    big_integer m {min};
+    if(!m.is_small() || (-m).is_small() || -(-m) != m ||
+       (m / big_integer{-1}).str() != "9223372036854775808" ||
+       m % big_integer{-1} != 0)
+    {
+        throw std::runtime_error{"big_integer: int64 minimum"};
+    }
+
+    big_integer u {std::uint64_t(18446744073709551615ULL)};
+    if(u.is_small() || u.str() != "18446744073709551615" ||
+       static_cast<std::uint64_t>(u) != 18446744073709551615ULL)
+    {
+        throw std::runtime_error{"big_integer: uint64 maximum"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void test_big_values()
+{
+    //30! = 265252859812191058636308480000000
+    big_integer f {1};
+    for(int i = 2; i <= 30; ++i) f *= i;
+    if(f.str() != "265252859812191058636308480000000") {
+        throw std::runtime_error{"big_integer: factorial"};
+    }
+    for(int i = 30; i >= 2; --i) f /= i;
+    if(f != 1 || !f.is_small()) {
+        throw std::runtime_error{"big_integer: factorial division"};
+    }
+
+    const big_integer p {"-123456789012345678901234567890123456789"};
+    if(p.str() != "-123456789012345678901234567890123456789") {
+        throw std::runtime_error{"big_integer: string conversion"};
+    }
+
+    const auto q = pow(big_integer{2}, 200) - 1;
+    if((q >> 190) != 1023 || (big_integer{1} << 200) != q + 1 ||
+       q.bit_length() != 200)
+    {
+        throw std::runtime_error{"big_integer: shifts"};
+    }
+
+    if(gcd(pow(big_integer{6}, 40), pow(big_integer{10}, 30)) != pow(big_integer{2}, 30) ||
+       lcm(big_integer{4}, big_integer{-6}) != 12)
+    {
+        throw std::runtime_error{"big_integer: gcd"};
+    }
+
+    std::stringstream ss;
+    ss << p;
+    big_integer r;
+    ss >> r;
+    if(r != p) throw std::runtime_error{"big_integer: stream I/O"};
+}
+
+
+
+//-------------------------------------------------------------------
+void test_division_identity()
+{
+    std::mt19937_64 urng {7};
+    std::uniform_int_distribution<std::int64_t> distr;
+
+    const auto random_big = [&](int limbs) {
+        big_integer x {0};
+        for(int i = 0; i < limbs; ++i) {
+            x = (x << 63) + big_integer{distr(urng)};
+        }
+        return ((distr(urng) % 2) ? -x : x);
+    };
+
+    for(int i = 0; i < 500; ++i) {
+        const auto a = random_big(1 + i % 7);
+        auto b = random_big(1 + (i / 7) % 4);
+        if(b == 0) b = 3;
+
+        big_integer q, r;
+        divmod(a, b, q, r);
+        if(q * b + r != a || abs(r) >= abs(b) ||
+           (r != 0 && r.sign() != a.sign()) ||
+           q != a / b || r != a % b)
+        {
+            throw std::runtime_error{"big_integer: division identity"};
+        }
+        if((a + b) - b != a || (a * b) / b != a) {
+            throw std::runtime_error{"big_integer: inverse operations"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+#ifdef __SIZEOF_INT128__
+void test_against_int128()
+{
+    using i128 = detail::int128_t;
+
+    std::mt19937_64 urng {11};
+    std::uniform_int_distribution<std::int64_t> distr;
+
+    const auto to_big = [](i128 x) {
+        const bool neg = x < 0;
+        const auto m = neg ? detail::uint128_t(0) - detail::uint128_t(x)
+                           : detail::uint128_t(x);
+        auto r = (big_integer{std::uint64_t(m >> 64)} << 64) +
+                  big_integer{std::uint64_t(m)};
+        return neg ? -r : r;
+    };
+
+    for(int i = 0; i < 2000; ++i) {
+        const i128 a = i128(distr(urng)) * (distr(urng) >> (i % 60));
+        const i128 b = i128(distr(urng) >> (i % 50)) + 1;
+        if(to_big(a) + to_big(b) != to_big(a + b) ||
+           to_big(a) - to_big(b) != to_big(a - b) ||
+           to_big(a) / to_big(b) != to_big(a / b) ||
+           to_big(a) % to_big(b) != to_big(a % b) ||
+           (to_big(a) < to_big(b)) != (a < b))
+        {
+            throw std::runtime_error{"big_integer: 128 bit reference"};
+        }
+    }
+}
+#endif
+
+
+
+//-------------------------------------------------------------------
+void test_rational()
+{
+    using rat = rational<big_integer,eager_normalization>;
+
+    //telescoping sum: sum 1/(i*(i+1)) = n/(n+1)
+    rat s {0};
+    for(int i = 1; i <= 200; ++i) {
+        s += rat{big_integer{1}, big_integer{i} * big_integer{i + 1}};
+    }
+    if(s.numer() != 200 || s.denom() != 201) {
+        throw std::runtime_error{"rational<big_integer>: telescoping sum"};
+    }
+
+    //harmonic number H(60) has a 25 digit denominator
+    rat h {0};
+    for(int i = 1; i <= 60; ++i) h += rat{big_integer{1}, big_integer{i}};
+    if(h.denom().str() != "3230237388259077233637600" ||
+       h.numer().str() != "15117092380124150817026911")
+    {
+        throw std::runtime_error{"rational<big_integer>: harmonic number"};
+    }
+    if(!(h > rat{big_integer{4}}) || !(h < 5) ||
+       static_cast<double>(h) < 4.6 || static_cast<double>(h) > 4.7)
+    {
+        throw std::runtime_error{"rational<big_integer>: comparison"};
+    }
+
+    std::vector<rational<big_integer>> hs;
+    for(int i = 1; i <= 60; ++i) hs.emplace_back(big_integer{1}, big_integer{i});
+    if(rational_sum(hs.begin(), hs.end()) != h) {
+        throw std::runtime_error{"rational<big_integer>: rational_sum"};
+    }
+
+    const std::string text = "-123456789012345678901234567890/7 1.0000000000000000000001";
+    std::vector<rational<big_integer>> parsed;
+    const auto res = parse_rationals(text.data(), text.data() + text.size(), parsed);
+    if(res.ec != std::errc{} || parsed.size() != 2 ||
+       parsed[0].numer().str() != "-123456789012345678901234567890" ||
+       parsed[0].denom() != 7 ||
+       parsed[1].numer().str() != "10000000000000000000001" ||
+       parsed[1].denom() != pow(big_integer{10}, 22))
+    {
+        throw std::runtime_error{"rational<big_integer>: parse_rationals"};
+    }
+    char buf[64];
+    const auto w = to_chars(buf, buf + sizeof(buf), parsed[0]);
+    if(w.ec != std::errc{} ||
+       std::string(buf, w.ptr) != "-123456789012345678901234567890/7")
+    {
+        throw std::runtime_error{"rational<big_integer>: to_chars"};
+    }
+
+    rational<big_integer> u {big_integer{6}, big_integer{8}};
+    u *= rational<big_integer>{big_integer{4}, big_integer{3}};
+    u.normalize();
+    if(u.numer() != 1 || u.denom() != 1) {
+        throw std::runtime_error{"rational<big_integer>: normalization"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_small_values();
+        test_spilling();
+        test_big_values();
+        test_division_identity();
+#ifdef __SIZEOF_INT128__
+        test_against_int128();
+#endif
+        test_rational();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,146 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#include  "../include/choice_array.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+/// @brief all kernels must give the same results as the choice operators
+template<class T, T n>
+void test_kernels()
+{
+    using ch  = choice<T,n>;
+    using arr = choice_array<T,n>;
+
+    //random values and all edge cases
+    std::mt19937_64 urng {std::uint64_t(n)};
+    arr a, b;
+    std::vector<ch> va, vb;
+    const auto edges = std::vector<T>{ T(0), T(1), T(n - 1), T(n / 2) };
+    for(auto x : edges) {
+        for(auto y : edges) {
+            va.push_back(ch{x});
+            vb.push_back(ch{y});
+        }
+    }
+    for(int i = 0; i < 2000; ++i) {
+        va.push_back(ch{T(urng())});
+        vb.push_back(ch{T(urng())});
+    }
+    for(std::size_t i = 0; i < va.size(); ++i) {
+        a.push_back(va[i]);
+        b.push_back(vb[i]);
+    }
+
+    arr s, d, p;
+    add(a, b, s);
+    subtract(a, b, d);
+    multiply(a, b, p);
+
+    if(s.size() != a.size() || d.size() != a.size() || p.size() != a.size()) {
+        throw std::logic_error("choice_array: output size");
+    }
+    for(std::size_t i = 0; i < va.size(); ++i) {
+        if(s[i] != va[i] + vb[i] ||
+           d[i] != va[i] - vb[i] ||
+           p[i] != va[i] * vb[i])
+        {
+            throw std::logic_error("choice_array: arithmetic");
+        }
+    }
+
+    for(auto f : { ch{T(0)}, ch{T(1)}, ch{T(n - 1)}, ch{T(urng())} }) {
+        arr c;
+        scale(a, f, c);
+        for(std::size_t i = 0; i < va.size(); ++i) {
+            if(c[i] != va[i] * f) throw std::logic_error("choice_array: scale");
+        }
+    }
+
+    //output identical to input
+    multiply(a, a, a);
+    subtract(b, a, b);
+    for(std::size_t i = 0; i < va.size(); ++i) {
+        if(a[i] != va[i] * va[i] || b[i] != vb[i] - a[i]) {
+            throw std::logic_error("choice_array: in-place");
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void test_container()
+{
+    using ch = choice<std::int16_t,360>;
+    using arr = choice_array<std::int16_t,360>;
+
+    auto a = arr{ch{1}, ch{-1}, ch{725}};
+    if(a.size() != 3 || a[0] != ch{1} || a[1] != ch{359} || a[2] != ch{5} ||
+       a.data()[1] != 359)
+    {
+        throw std::logic_error("choice_array: construction");
+    }
+
+    a.set(0, ch{400});
+    a.resize(5);
+    const auto b = arr(5, ch{10});
+    if(a[0] != ch{40} || a[4] != ch{0} || b[4] != ch{10}) {
+        throw std::logic_error("choice_array: modification");
+    }
+
+    arr c;
+    add(arr{}, arr{}, c);
+    if(!c.empty()) throw std::logic_error("choice_array: empty");
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_kernels<std::uint8_t,1>();
+        test_kernels<std::uint8_t,85>();
+        test_kernels<std::uint8_t,128>();
+        test_kernels<std::uint8_t,200>();
+        test_kernels<std::uint8_t,251>();
+        test_kernels<std::int8_t,100>();
+
+        test_kernels<std::uint16_t,360>();
+        test_kernels<std::int16_t,30011>();
+        test_kernels<std::uint16_t,65521>();
+
+        test_kernels<std::uint32_t,998244353>();
+        test_kernels<int,1000000007>();
+        test_kernels<std::uint32_t,2147483647>();
+        test_kernels<std::uint32_t,4294967291u>();
+        test_kernels<int,1 << 20>();
+
+        test_kernels<std::uint64_t,1000000007>();
+        test_kernels<std::int64_t,4611686018427387847LL>();
+
+        test_container();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
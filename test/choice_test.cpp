@@ -12,6 +12,10 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
 
 
 using namespace am;
@@ -79,12 +83,244 @@ void arithmetic()
 
 
 
+//-------------------------------------------------------------------
+int gcd_ref(int a, int b)
+{
+    while(b != 0) {
+        const int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief compares against floored remainders computed with 128 bit integers
+template<class T, T n>
+void test_reduction()
+{
+    using ch = choice<T,n>;
+    using lim = std::numeric_limits<T>;
+    using w_t = detail::int128_t;
+
+    const auto ref = [](w_t x) {
+        auto r = w_t(x % w_t(n));
+        return T((r < 0) ? r + w_t(n) : r);
+    };
+
+    std::vector<T> vals { T(0), T(1), T(n - 1), T(n), T(n/2), T(n/2 + 1),
+                          lim::max(), T(lim::max() - 1), lim::min() };
+    if(lim::is_signed) {
+        vals.push_back(T(-1));
+        vals.push_back(T(lim::min() + 1));
+    }
+    std::mt19937_64 urng {std::uint64_t(n)};
+    std::uniform_int_distribution<long long> distr {
+        static_cast<long long>(lim::min() / 2),
+        static_cast<long long>(lim::max() / 2) };
+    for(int i = 0; i < 200; ++i) vals.push_back(T(distr(urng)));
+
+    for(const auto& x : vals) {
+        const auto cx = ch{x};
+        if(cx.value() != ref(x)) {
+            throw std::logic_error("am::num::choice reduction");
+        }
+        for(const auto& y : vals) {
+            const auto cy = ch{y};
+            auto a = cx; a += cy;
+            auto b = cx; b -= cy;
+            auto c = cx; c += y;
+            auto d = cx; d -= y;
+            if(a.value() != ref(w_t(cx.value()) + w_t(cy.value())) ||
+               b.value() != ref(w_t(cx.value()) - w_t(cy.value())) ||
+               (cx + cy) != a || (cx - cy) != b ||
+               c != a || d != b)
+            {
+                throw std::logic_error("am::num::choice add/sub");
+            }
+        }
+        if((-cx).value() != ref(-w_t(cx.value()))) {
+            throw std::logic_error("am::num::choice negation");
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, T n>
+void test_multiplication()
+{
+    using ch = choice<T,n>;
+    using w_t = detail::uint128_t;
+    using lim = std::numeric_limits<T>;
+
+    std::vector<T> vals { T(0), T(1), T(2), T(n - 1), T(n - 2), T(n/2),
+                          lim::max(), lim::min() };
+    std::mt19937_64 urng {std::uint64_t(n) + 1};
+    for(int i = 0; i < 100; ++i) vals.push_back(T(urng()));
+
+    for(const auto& x : vals) {
+        const auto cx = ch{x};
+        for(const auto& y : vals) {
+            const auto cy = ch{y};
+            const auto p = T((w_t(cx.value()) * w_t(cy.value())) % w_t(n));
+            auto a = cx; a *= cy;
+            auto b = cx; b *= y;
+            if(a.value() != p || b.value() != p || (cx * cy).value() != p ||
+               (x * cy).value() != p || (cy * x).value() != p)
+            {
+                throw std::logic_error("am::num::choice multiplication");
+            }
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief n must be prime
+template<class T, T n>
+void test_prime_field()
+{
+    using ch = choice<T,n>;
+
+    std::mt19937_64 urng {std::uint64_t(n) + 2};
+    std::vector<ch> vals;
+    for(int i = 0; i < 200; ++i) {
+        auto x = ch{T(urng() >> 1)};
+        if(x.value() == 0) x = ch{T(1)};
+        vals.push_back(x);
+    }
+    vals.push_back(ch{T(1)});
+    vals.push_back(ch{T(n - 1)});
+
+    const auto one = ch{T(1)};
+    for(const auto& x : vals) {
+        const auto i = inverse(x);
+        if(x * i != one ||
+           pow(x, T(n - 1)) != one ||        //Fermat
+           pow(x, T(n - 2)) != i ||
+           pow(x, -1) != i ||
+           pow(x, 0) != one ||
+           pow(x, 3) != x * x * x)
+        {
+            throw std::logic_error("am::num::choice inverse / pow");
+        }
+    }
+
+    auto inv = vals;
+    batch_inverse(inv.begin(), inv.end());
+    for(std::size_t i = 0; i < vals.size(); ++i) {
+        if(inv[i] != inverse(vals[i])) {
+            throw std::logic_error("am::num::choice batch_inverse");
+        }
+    }
+
+    //not invertible -> unchanged
+    inv = vals;
+    inv[7] = ch{T(0)};
+    bool thrown = false;
+    try {
+        batch_inverse(inv.begin(), inv.end());
+    } catch(std::domain_error&) {
+        thrown = true;
+    }
+    if(!thrown || inv[0] != vals[0] || inv[7] != ch{T(0)}) {
+        throw std::logic_error("am::num::choice batch_inverse zero");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void test_composite_inverse()
+{
+    using ch = choice<int,360>;
+
+    for(int i = 0; i < 360; ++i) {
+        const auto c = ch{i};
+        bool invertible = true;
+        ch inv {0};
+        try {
+            inv = inverse(c);
+        } catch(std::domain_error&) {
+            invertible = false;
+        }
+        if(invertible != (gcd_ref(i, 360) == 1) ||
+           (invertible && (c * inv).value() != 1))
+        {
+            throw std::logic_error("am::num::choice composite inverse");
+        }
+    }
+
+    if(inverse(choice<int,1024>{3}).value() != 683 ||
+       inverse(choice<int,9>{2}).value() != 5)
+    {
+        throw std::logic_error("am::num::choice inverse");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void increment()
+{
+    auto c = choice<int,3>{0};
+    if((c--).value() != 0 || c.value() != 2 ||
+       (c++).value() != 2 || c.value() != 0 ||
+       (-c).value() != 0)
+    {
+        throw std::logic_error("am::num::choice increment");
+    }
+
+    const auto d = choice<int,5>{choice<int,3>{2}};
+    if(d.value() != 2) throw std::logic_error("am::num::choice conversion");
+}
+
+
+
 //-------------------------------------------------------------------
 int main()
 {
     try {
         initialization();
         arithmetic();
+        increment();
+
+        test_reduction<std::int8_t,8>();
+        test_reduction<std::int8_t,100>();
+        test_reduction<std::uint8_t,255>();
+        test_reduction<std::int16_t,360>();
+        test_reduction<std::uint16_t,65521>();
+        test_reduction<int,1>();
+        test_reduction<int,1024>();
+        test_reduction<int,1000000007>();
+        test_reduction<int,2147483647>();
+        test_reduction<unsigned,4294967291u>();
+        test_reduction<long long,(1LL << 40)>();
+        test_reduction<long long,998244353>();
+        test_reduction<long long,9223372036854775783LL>();
+        test_reduction<std::uint64_t,18446744073709551557ULL>();
+
+        test_multiplication<std::int8_t,100>();
+        test_multiplication<std::uint16_t,65521>();
+        test_multiplication<int,360>();
+        test_multiplication<int,65536>();
+        test_multiplication<int,2147483647>();
+        test_multiplication<unsigned,4294967291u>();
+        test_multiplication<long long,(1LL << 40)>();
+        test_multiplication<long long,9223372036854775783LL>();
+        test_multiplication<std::uint64_t,18446744073709551557ULL>();
+
+        test_prime_field<std::int16_t,32749>();
+        test_prime_field<int,998244353>();
+        test_prime_field<unsigned,4294967291u>();
+        test_prime_field<long long,9223372036854775783LL>();
+        test_prime_field<std::uint64_t,18446744073709551557ULL>();
+        test_composite_inverse();
     }
     catch(std::exception& e) {
         std::cerr << e.what();
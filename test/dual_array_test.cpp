@@ -0,0 +1,198 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/dual_array.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <iostream>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+template<class T>
+struct test_function {
+    template<class D>
+    D operator () (const D& x) const {
+        return (sin(x) * exp(x)) + (sqrt(x) / (T(1) + (x * x))) - tanh(x);
+    }
+};
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t W>
+void test_pack_dual()
+{
+    using P = simd_pack<T,W>;
+
+    P r, i;
+    for(std::size_t k = 0; k < W; ++k) {
+        r[k] = T(0.25) + T(k);
+        i[k] = T(1) - T(k);
+    }
+
+    const auto f = test_function<T>{};
+    const auto y = f(dual<P>{r, i});
+
+    for(std::size_t k = 0; k < W; ++k) {
+        const auto ys = f(dual<T>{r[k], i[k]});
+        if(!approx_equal(ys, dual<T>{y.real()[k], y.imag()[k]})) {
+            throw std::runtime_error{"dual<simd_pack>"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief polynomial kernels of exp, log, sin, cos vs. the C library
+template<class T, std::size_t W>
+void test_pack_kernels()
+{
+    using P = simd_pack<T,W>;
+    using std::abs;
+
+    const auto check = [](const P& x, auto f, auto g, const char* name) {
+        const auto y = f(x);
+        for(std::size_t k = 0; k < W; ++k) {
+            const T r = g(x[k]);
+            const T tol = T(4) * std::numeric_limits<T>::epsilon();
+            if(r != r ? y[k] == y[k] :
+               abs(y[k] - r) > tol * std::max(T(1), abs(r)))
+            {
+                throw std::runtime_error{name};
+            }
+        }
+    };
+
+    const auto checkAll = [&](const P& x, const P& pos) {
+        check(x,   [](const P& a) { return exp(a); }, [](T a) { return std::exp(a); }, "simd_pack exp");
+        check(pos, [](const P& a) { return log(a); }, [](T a) { return std::log(a); }, "simd_pack log");
+        check(x,   [](const P& a) { return sin(a); }, [](T a) { return std::sin(a); }, "simd_pack sin");
+        check(x,   [](const P& a) { return cos(a); }, [](T a) { return std::cos(a); }, "simd_pack cos");
+    };
+
+    //inside of the kernels' domains
+    for(T s : {T(-80), T(-3.3), T(-0.01), T(0), T(0.7), T(2.5), T(45), T(1000)}) {
+        P x, pos;
+        for(std::size_t k = 0; k < W; ++k) {
+            x[k] = s + T(0.37) * T(k);
+            pos[k] = abs(x[k]) + std::numeric_limits<T>::min();
+        }
+        checkAll(x, pos);
+    }
+
+    //lanes outside of the kernels' domains
+    for(T s : {std::numeric_limits<T>::infinity(),
+               std::numeric_limits<T>::quiet_NaN(),
+               -std::numeric_limits<T>::infinity(),
+               T(-1), T(0), std::numeric_limits<T>::denorm_min(), T(1e30)})
+    {
+        P x {T(0.5)};
+        x[W/2] = s;
+        checkAll(x, x);
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief special and two-argument functions on dual<simd_pack>
+template<class T, std::size_t W>
+void test_pack_special()
+{
+    using P = simd_pack<T,W>;
+
+    P r, i;
+    for(std::size_t k = 0; k < W; ++k) {
+        r[k] = T(0.75) + T(k);
+        i[k] = T(1) - T(k);
+    }
+
+    const auto f = [](const auto& x) {
+        const auto y = x * T(0.5) + T(0.25);
+        return tgamma(x) + lgamma(y) + beta(x, y) + atan2(y, -x) +
+               hypot(x, y) + fmod(x, y) + fma(x, y, x);
+    };
+    const auto y = f(dual<P>{r, i});
+
+    for(std::size_t k = 0; k < W; ++k) {
+        const auto ys = f(dual<T>{r[k], i[k]});
+        if(!approx_equal(ys, dual<T>{y.real()[k], y.imag()[k]})) {
+            throw std::runtime_error{"dual<simd_pack> special functions"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_dual_array()
+{
+    dual_array<T> a;
+    for(int k = 0; k < 13; ++k) {
+        a.push_back(dual<T>{T(0.1) * T(k+1), T(k % 3)});
+    }
+
+    dual_array<T> b;
+    transform<4>(a, b, [](const auto& x) { return test_function<T>{}(x); });
+
+    if(b.size() != a.size()) {
+        throw std::runtime_error{"dual_array size"};
+    }
+    for(std::size_t k = 0; k < a.size(); ++k) {
+        if(!approx_equal(b[k], test_function<T>{}(a[k]))) {
+            throw std::runtime_error{"dual_array transform"};
+        }
+    }
+
+    dual_array<T> c {dual<T>{T(1), T(2)}, dual<T>{T(3), T(4)}};
+    if(c.size() != 2 || c[1] != dual<T>{T(3), T(4)} ||
+       c.real_data()[0] != T(1) || c.imag_data()[0] != T(2))
+    {
+        throw std::runtime_error{"dual_array construction"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    using namespace am::num;
+
+    try {
+        test_pack_dual<float,8>();
+        test_pack_dual<double,4>();
+        test_pack_dual<double,1>();
+        test_pack_special<float,8>();
+        test_pack_special<double,4>();
+        test_pack_kernels<float,8>();
+        test_pack_kernels<double,4>();
+        test_pack_kernels<double,1>();
+        test_pack_kernels<long double,2>();
+
+        test_dual_array<float>();
+        test_dual_array<double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -14,6 +14,7 @@
 #include <stdexcept>
 #include <cstdint>
 #include <iostream>
+#include <vector>
 
 
 using namespace am;
@@ -54,6 +55,143 @@ void test()
 
 
 
+//-------------------------------------------------------------------
+template<class T>
+void test_trig()
+{
+    using std::sin;
+    using std::cos;
+    using std::tan;
+    using std::sinh;
+    using std::cosh;
+    using std::tanh;
+    using std::abs;
+
+    for(T r : {T(-3.5), T(-0.75), T(0), T(1e-3), T(0.5), T(2.25), T(30)}) {
+        const auto x = dual<T>{r, T(2)};
+        const auto tol = T(10) * tolerance<T>;
+
+        if(!approx_equal(sin(x), dual<T>{sin(r), T(2)*cos(r)}, tol) ||
+           !approx_equal(cos(x), dual<T>{cos(r), -T(2)*sin(r)}, tol))
+        {
+            throw std::runtime_error{"sin/cos"};
+        }
+        if(abs(r) < T(3) &&
+           !approx_equal(tan(x), dual<T>{tan(r), T(2)/(cos(r)*cos(r))}, tol))
+        {
+            throw std::runtime_error{"tan"};
+        }
+
+        const auto rtol = tol * cosh(r);
+        if(!approx_equal(sinh(x), dual<T>{sinh(r), T(2)*cosh(r)}, rtol) ||
+           !approx_equal(cosh(x), dual<T>{cosh(r), T(2)*sinh(r)}, rtol) ||
+           !approx_equal(tanh(x), dual<T>{tanh(r), T(2)/(cosh(r)*cosh(r))}, tol))
+        {
+            throw std::runtime_error{"sinh/cosh/tanh"};
+        }
+
+        dual<T> s, c;
+        sincos(x, s, c);
+        if(s != sin(x) || c != cos(x)) {
+            throw std::runtime_error{"sincos"};
+        }
+        sinhcosh(x, s, c);
+        if(s != sinh(x) || c != cosh(x)) {
+            throw std::runtime_error{"sinhcosh"};
+        }
+    }
+
+    //sinh and cosh overflow
+    for(T r : {T(-800), T(800)}) {
+        const auto t = tanh(dual<T>{r, T(1)});
+        if(t.real() != tanh(r) || t.imag() != T(0)) {
+            throw std::runtime_error{"tanh overflow"};
+        }
+    }
+
+    std::vector<dual<T>> in {{T(0.1), T(1)}, {T(-1.2), T(0.5)}, {T(2), T(-3)}};
+    std::vector<dual<T>> out1(in.size()), out2(in.size());
+    sin(in.begin(), in.end(), out1.begin());
+    cosh(in.begin(), in.end(), out2.begin());
+    for(std::size_t i = 0; i < in.size(); ++i) {
+        if(out1[i] != sin(in[i]) || out2[i] != cosh(in[i])) {
+            throw std::runtime_error{"batched trig"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_special()
+{
+    using std::abs;
+    using std::tgamma;
+    using std::lgamma;
+
+    const T h = T(1e-6);
+    const T tol = T(1e-6);
+
+    //central finite differences w.r.t. first and second argument
+    const auto check = [&](T x0, T y0, auto f, const char* name) {
+        const auto d = f(dual<T>{x0, T(1)}, dual<T>{y0, T(0)});
+        const auto e = f(dual<T>{x0, T(0)}, dual<T>{y0, T(1)});
+        const auto fx = (f(dual<T>{x0 + h}, dual<T>{y0}).real() -
+                         f(dual<T>{x0 - h}, dual<T>{y0}).real()) / (T(2)*h);
+        const auto fy = (f(dual<T>{x0}, dual<T>{y0 + h}).real() -
+                         f(dual<T>{x0}, dual<T>{y0 - h}).real()) / (T(2)*h);
+        if(abs(d.imag() - fx) > tol * (T(1) + abs(fx)) ||
+           abs(e.imag() - fy) > tol * (T(1) + abs(fy)))
+        {
+            throw std::runtime_error{name};
+        }
+    };
+
+    for(T x0 : {T(-2.5), T(-0.3), T(0.2), T(1), T(3.7), T(12.25)}) {
+        check(x0, T(0), [](const auto& x, const auto&) { return tgamma(x); }, "tgamma");
+        check(x0, T(0), [](const auto& x, const auto&) { return lgamma(x); }, "lgamma");
+    }
+
+    for(T x0 : {T(0.5), T(2), T(7.5)}) {
+        for(T y0 : {T(0.25), T(1.5), T(4)}) {
+            check(x0, y0, [](const auto& x, const auto& y) { return beta(x, y); }, "beta");
+            check(x0, -y0, [](const auto& x, const auto& y) { return atan2(x, y); }, "atan2");
+            check(-x0, y0, [](const auto& x, const auto& y) { return hypot(x, y); }, "hypot");
+            check(x0, y0 + T(0.07), [](const auto& x, const auto& y) { return fmod(x, y); }, "fmod");
+            check(x0, y0, [](const auto& x, const auto& y) { return fma(x, y, x); }, "fma");
+        }
+    }
+
+    //digamma at known values
+    const T euler = T(0.57721566490153286060651209008240243104215933593992);
+    if(abs(digamma(T(1)) + euler) > tolerance<T> ||
+       abs(digamma(T(0.5)) + euler + T(2)*T(0.69314718055994530941723212145817656807550013436026)) > tolerance<T>)
+    {
+        throw std::runtime_error{"digamma"};
+    }
+
+    std::vector<dual<T>> in {{T(0.5), T(1)}, {T(2.5), T(2)}, {T(4), T(-1)}};
+    std::vector<dual<T>> out1(in.size()), out2(in.size());
+    std::vector<dual<T>> out3(in.size()), out4(in.size());
+    lgamma(in.begin(), in.end(), out1.begin());
+    atan2(in.begin(), in.end(), in.rbegin(), out2.begin());
+    fmod(in.begin(), in.end(), in.rbegin(), out3.begin());
+    fma(in.begin(), in.end(), in.rbegin(), in.begin(), out4.begin());
+    for(std::size_t i = 0; i < in.size(); ++i) {
+        const auto& r = in[in.size()-1-i];
+        if(out1[i] != lgamma(in[i]) ||
+           out2[i] != atan2(in[i], r) ||
+           out3[i] != fmod(in[i], r) ||
+           out4[i] != fma(in[i], r, in[i]))
+        {
+            throw std::runtime_error{"batched special functions"};
+        }
+    }
+}
+
+
+
 //-------------------------------------------------------------------
 int main()
 {
@@ -63,6 +201,13 @@ int main()
         test<float>();
         test<double>();
         test<long double>();
+
+        test_trig<float>();
+        test_trig<double>();
+        test_trig<long double>();
+
+        test_special<double>();
+        test_special<long double>();
     }
     catch(std::exception& e) {
         std::cerr << e.what() << std::endl;
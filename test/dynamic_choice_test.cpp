@@ -0,0 +1,185 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#include  "../include/dynamic_choice.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+/// @brief all operations must give the same results as choice<T,n>
+template<class T, T n>
+void test_against_static()
+{
+    using sch = choice<T,n>;
+    using dch = dynamic_choice<T>;
+    using lim = std::numeric_limits<T>;
+
+    dch::set_modulus(n);
+    if(dch::choices() != n || dch::max() != sch::max()) {
+        throw std::logic_error("dynamic_choice: modulus");
+    }
+
+    std::vector<T> vals { T(0), T(1), T(2), T(n - 1), T(n), T(n/2),
+                          lim::max(), T(lim::max() - 1), lim::min() };
+    if(lim::is_signed) vals.push_back(T(-1));
+
+    std::mt19937_64 urng {std::uint64_t(n)};
+    for(int i = 0; i < 100; ++i) vals.push_back(T(urng()));
+
+    for(const auto& x : vals) {
+        const auto sx = sch{x};
+        const auto dx = dch{x};
+        if(dx.value() != sx.value() || (-dx).value() != (-sx).value()) {
+            throw std::logic_error("dynamic_choice: reduction");
+        }
+        for(const auto& y : vals) {
+            const auto sy = sch{y};
+            const auto dy = dch{y};
+            auto a = dx; a += dy;
+            auto b = dx; b -= dy;
+            auto c = dx; c *= dy;
+            auto d = dx; d *= y;
+            if(a.value() != (sx + sy).value() ||
+               b.value() != (sx - sy).value() ||
+               c.value() != (sx * sy).value() ||
+               d.value() != (sx * y).value() ||
+               (dx + dy) != a || (dx - dy) != b || (dx * dy) != c ||
+               (y - dx).value() != (y - sx).value())
+            {
+                throw std::logic_error("dynamic_choice: arithmetic");
+            }
+        }
+    }
+
+    //wider inputs
+    const auto big = std::int64_t(-123456789012345LL);
+    auto e = dch{T(0)}; e += big;
+    auto f = sch{T(0)}; f += big;
+    if(e.value() != f.value()) {
+        throw std::logic_error("dynamic_choice: wide reduction");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief n must be prime
+template<class T>
+void test_prime_field(T n)
+{
+    using dch = dynamic_choice<T>;
+    dch::set_modulus(n);
+
+    std::mt19937_64 urng {std::uint64_t(n) + 2};
+    std::vector<dch> vals;
+    for(int i = 0; i < 100; ++i) {
+        auto x = dch{T(urng() >> 1)};
+        if(x.value() == 0) x = dch{T(1)};
+        vals.push_back(x);
+    }
+
+    const auto one = dch{T(1)};
+    for(const auto& x : vals) {
+        const auto i = inverse(x);
+        if(x * i != one ||
+           pow(x, T(n - 1)) != one ||        //Fermat
+           pow(x, -1) != i)
+        {
+            throw std::logic_error("dynamic_choice: inverse / pow");
+        }
+    }
+
+    auto inv = vals;
+    batch_inverse(inv.begin(), inv.end());
+    for(std::size_t i = 0; i < vals.size(); ++i) {
+        if(inv[i] != inverse(vals[i])) {
+            throw std::logic_error("dynamic_choice: batch_inverse");
+        }
+    }
+
+    bool thrown = false;
+    try {
+        inverse(dch{T(0)});
+    } catch(std::domain_error&) {
+        thrown = true;
+    }
+    if(!thrown) throw std::logic_error("dynamic_choice: inverse of zero");
+}
+
+
+
+//-------------------------------------------------------------------
+struct tag_a {};
+struct tag_b {};
+
+void test_tags()
+{
+    using ca = dynamic_choice<int,tag_a>;
+    using cb = dynamic_choice<int,tag_b>;
+
+    ca::set_modulus(7);
+    cb::set_modulus(360);
+
+    auto a = ca{10};
+    auto b = cb{370};
+    ++a; --b;
+    if(a.value() != 4 || b.value() != 9 || sizeof(a) != sizeof(int)) {
+        throw std::logic_error("dynamic_choice: tags");
+    }
+
+    //raw residues
+    const auto m = dynamic_modulus<std::uint64_t>{1000000007};
+    if(m.mul(m.reduce(123456789), 987654321) != 259106859 ||
+       m.add(1000000006, 5) != 4 || m.sub(3, 5) != 1000000005)
+    {
+        throw std::logic_error("dynamic_modulus");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_against_static<std::int8_t,100>();
+        test_against_static<std::uint8_t,255>();
+        test_against_static<std::int16_t,360>();
+        test_against_static<int,1>();
+        test_against_static<int,1024>();
+        test_against_static<int,1000000007>();
+        test_against_static<std::uint32_t,4294967291u>();
+        test_against_static<std::uint32_t,2147483648u>();
+        test_against_static<std::int64_t,1000000007>();
+        test_against_static<std::uint64_t,18446744073709551557ull>();
+        test_against_static<std::uint64_t,9223372036854775808ull>();
+        test_against_static<std::int64_t,4611686018427387847LL>();
+
+        test_prime_field<int>(1000000007);
+        test_prime_field<std::uint32_t>(4294967291u);
+        test_prime_field<std::uint64_t>(18446744073709551557ull);
+
+        test_tags();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
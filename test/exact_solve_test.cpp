@@ -0,0 +1,208 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/exact_solve.h"
+#include  "../include/big_integer.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_integer_determinant()
+{
+    //needs pivoting
+    const std::vector<T> a {
+        0,  2,  1,
+        3, -1,  4,
+        5,  6, -2 };
+
+    if(exact_determinant(a, 3) != T(75)) {
+        throw std::runtime_error{"integer determinant"};
+    }
+
+    const std::vector<T> s {
+        1, 2, 3,
+        4, 5, 6,
+        7, 8, 9 };
+
+    if(exact_determinant(s, 3) != T(0)) {
+        throw std::runtime_error{"singular determinant"};
+    }
+
+    if(exact_determinant(std::vector<T>{}, 0) != T(1)) {
+        throw std::runtime_error{"empty determinant"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_hilbert()
+{
+    using rat = rational<T>;
+
+    //Hilbert matrix: det(H_6) = 1 / 186313420339200000
+    const std::size_t n = 6;
+    std::vector<rat> h;
+    for(std::size_t i = 0; i < n; ++i) {
+        for(std::size_t j = 0; j < n; ++j) {
+            h.emplace_back(T(1), T(int(i + j + 1)));
+        }
+    }
+
+    const auto det = exact_determinant(h, n);
+    if(det.numer() != T(1) || det.denom() != T(186313420339200000LL)) {
+        throw std::runtime_error{"Hilbert determinant"};
+    }
+
+    //H x = H * (1,...,1)  =>  x = (1,...,1)
+    std::vector<rat> b;
+    for(std::size_t i = 0; i < n; ++i) {
+        using erat = rational<T,eager_normalization>;
+        erat s {0};
+        for(std::size_t j = 0; j < n; ++j) s += erat{h[i*n + j]};
+        b.emplace_back(s.numer(), s.denom());
+    }
+
+    const auto x = exact_solve(h, b, n);
+    if(x.size() != n) {
+        throw std::runtime_error{"Hilbert system"};
+    }
+    for(const auto& xi : x) {
+        if(xi.numer() != T(1) || xi.denom() != T(1)) {
+            throw std::runtime_error{"Hilbert system solution"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_random_systems()
+{
+    using rat = rational<T,eager_normalization>;
+
+    std::mt19937_64 urng {17};
+    std::uniform_int_distribution<int> num {-20, 20};
+    std::uniform_int_distribution<int> den {1, 9};
+
+    for(std::size_t n = 1; n <= 12; ++n) {
+        std::vector<rat> a, x;
+        for(std::size_t i = 0; i < n*n; ++i) {
+            a.emplace_back(T(num(urng)), T(den(urng)));
+        }
+        for(std::size_t i = 0; i < n; ++i) {
+            x.emplace_back(T(num(urng)), T(den(urng)));
+        }
+
+        std::vector<rat> b;
+        for(std::size_t i = 0; i < n; ++i) {
+            rat s {0};
+            for(std::size_t j = 0; j < n; ++j) s += a[i*n + j] * x[j];
+            b.push_back(s);
+        }
+
+        const auto sol = exact_solve(a, b, n);
+        if(sol.empty() && exact_determinant(a, n) != rat{0}) {
+            throw std::runtime_error{"random system: not solved"};
+        }
+        for(std::size_t i = 0; i < sol.size(); ++i) {
+            if(sol[i].numer() != x[i].numer() ||
+               sol[i].denom() != x[i].denom())
+            {
+                throw std::runtime_error{"random system: solution"};
+            }
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void test_integer_system()
+{
+    const std::vector<long long> a {
+        2,  1, -1,
+       -3, -1,  2,
+       -2,  1,  2 };
+    const std::vector<long long> b { 8, -11, -3 };
+
+    const auto x = exact_solve(a, b, 3);
+    if(x.size() != 3 ||
+       x[0] != rational<long long>{2} ||
+       x[1] != rational<long long>{3} ||
+       x[2] != rational<long long>{-1})
+    {
+        throw std::runtime_error{"integer system"};
+    }
+
+    const std::vector<long long> s {
+        1, 2,
+        2, 4 };
+    if(!exact_solve(s, std::vector<long long>{1, 2}, 2).empty()) {
+        throw std::runtime_error{"singular system"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void test_overflow()
+{
+    //minors of this matrix don't fit into 32 bits
+    const std::size_t n = 8;
+    std::vector<int> a;
+    std::mt19937 urng {5};
+    std::uniform_int_distribution<int> distr {-100000, 100000};
+    for(std::size_t i = 0; i < n*n; ++i) a.push_back(distr(urng));
+
+    bool thrown = false;
+    try {
+        exact_determinant(a, n);
+    } catch(std::overflow_error&) {
+        thrown = true;
+    }
+    if(!thrown) throw std::runtime_error{"overflow not detected"};
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_integer_determinant<int>();
+        test_integer_determinant<long long int>();
+        test_integer_determinant<big_integer>();
+
+        test_hilbert<long long int>();
+        test_hilbert<big_integer>();
+
+        test_random_systems<big_integer>();
+
+        test_integer_system();
+        test_overflow();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,149 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/gcd.h"
+
+#include <stdexcept>
+#include <cstdint>
+#include <random>
+#include <iostream>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+template<class T>
+T euclid_gcd(T a, T b)
+{
+    while(b != T(0)) {
+        const T m = T(a % b);
+        a = b;
+        b = m;
+    }
+    return a;
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_small()
+{
+    if(gcd(T(0), T(0)) != T(0) ||
+       gcd(T(0), T(7)) != T(7) ||
+       gcd(T(7), T(0)) != T(7) ||
+       gcd(T(12), T(18)) != T(6) ||
+       gcd(T(17), T(5)) != T(1) ||
+       gcd(T(64), T(48)) != T(16))
+    {
+        throw std::runtime_error{"gcd: small values"};
+    }
+    if(lcm(T(4), T(6)) != T(12) || lcm(T(0), T(6)) != T(0)) {
+        throw std::runtime_error{"lcm: small values"};
+    }
+}
+
+template<class T>
+void test_signed()
+{
+    if(gcd(T(-12), T(18)) != T(6) ||
+       gcd(T(12), T(-18)) != T(6) ||
+       gcd(T(-12), T(-18)) != T(6) ||
+       lcm(T(-4), T(6)) != T(12))
+    {
+        throw std::runtime_error{"gcd: signed values"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void test_random_64()
+{
+    std::mt19937_64 urng {42};
+    std::uniform_int_distribution<std::uint64_t> distr;
+
+    for(int i = 0; i < 10000; ++i) {
+        auto a = distr(urng);
+        auto b = distr(urng);
+        //force common factors
+        if(i % 2) {
+            const auto f = (distr(urng) >> 40) + 1;
+            a = (a >> 24) * f;
+            b = (b >> 24) * f;
+        }
+        if(gcd(a, b) != euclid_gcd(a, b)) {
+            throw std::runtime_error{"gcd: random 64 bit values"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+#ifdef __SIZEOF_INT128__
+void test_random_128()
+{
+    using u128 = detail::uint128_t;
+
+    std::mt19937_64 urng {13};
+    std::uniform_int_distribution<std::uint64_t> distr;
+
+    const auto random_u128 = [&] {
+        return (u128(distr(urng)) << 64) | u128(distr(urng));
+    };
+
+    for(int i = 0; i < 2000; ++i) {
+        auto a = random_u128();
+        auto b = random_u128();
+        if(i % 2) {
+            const auto f = u128(distr(urng) >> 4) + 1;
+            a = (a >> 64) * f;
+            b = (b >> 65) * f;
+        }
+        if(gcd(a, b) != euclid_gcd(a, b)) {
+            throw std::runtime_error{"gcd: random 128 bit values"};
+        }
+    }
+
+    const auto a = detail::int128_t(-1) * detail::int128_t(u128(1) << 100);
+    if(gcd(a, detail::int128_t(6)) != detail::int128_t(2)) {
+        throw std::runtime_error{"gcd: signed 128 bit values"};
+    }
+}
+#endif
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_small<short>();
+        test_small<unsigned int>();
+        test_small<long>();
+        test_small<unsigned long long>();
+
+        test_signed<int>();
+        test_signed<long long>();
+
+        test_random_64();
+#ifdef __SIZEOF_INT128__
+        test_random_128();
+#endif
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
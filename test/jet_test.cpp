@@ -0,0 +1,175 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/jet.h"
+
+#include <stdexcept>
+#include <cstdint>
+#include <iostream>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_construction()
+{
+    auto x = make_jet<4>(T(2), T(1));
+    if(x.size() != 4 || x[0] != T(2) || x[1] != T(1) ||
+       x[2] != T(0) || x[3] != T(0))
+    {
+        throw std::runtime_error{"construction"};
+    }
+
+    auto d = make_dual(x);
+    if(d.real() != real(x) || d.imag() != imag(x)) {
+        throw std::runtime_error{"conversion to dual"};
+    }
+
+    auto y = make_jet<3>(dual<T>{T(1), T(5)});
+    if(y[0] != T(1) || y[1] != T(5) || y[2] != T(0)) {
+        throw std::runtime_error{"conversion from dual"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_arithmetic()
+{
+    const auto tol = T(10) * tolerance<T>;
+    const auto x = make_jet<5>(T(3));
+
+    //x^3 around 3: 27 + 27t + 9t^2 + t^3
+    const auto p = x * x * x;
+    if(!approx_equal(p[0], T(27), tol) || !approx_equal(p[1], T(27), tol) ||
+       !approx_equal(p[2], T( 9), tol) || !approx_equal(p[3], T( 1), tol) ||
+       !approx_equal(p[4], T( 0), tol))
+    {
+        throw std::runtime_error{"multiplication"};
+    }
+
+    const auto q = p / x;
+    if(!approx_equal(q, x * x, tol)) {
+        throw std::runtime_error{"division"};
+    }
+
+    const auto r = pow(x, T(3));
+    if(!approx_equal(r, p, tol)) {
+        throw std::runtime_error{"pow"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_functions()
+{
+    using std::exp;
+    using std::sin;
+    using std::cos;
+    using std::log;
+
+    const auto tol = T(100) * tolerance<T>;
+    const T x0 = T(0.7);
+    const auto x = make_jet<6>(x0);
+
+    //exp: a_k = e^x0 / k!
+    const auto e = exp(x);
+    T fact = T(1);
+    for(std::size_t k = 0; k < 6; ++k) {
+        if(k > 0) fact *= T(k);
+        if(!approx_equal(e[k], exp(x0) / fact, tol) ||
+           !approx_equal(e.derivative(k), exp(x0), tol))
+        {
+            throw std::runtime_error{"exp"};
+        }
+    }
+
+    //derivatives of sin cycle through cos, -sin, -cos, sin
+    const auto s = sin(x);
+    const T ds[] {sin(x0), cos(x0), -sin(x0), -cos(x0), sin(x0), cos(x0)};
+    for(std::size_t k = 0; k < 6; ++k) {
+        if(!approx_equal(s.derivative(k), ds[k], tol)) {
+            throw std::runtime_error{"sin"};
+        }
+    }
+
+    //inverse functions
+    if(!approx_equal(log(e), x, tol) ||
+       !approx_equal(exp(log(x)), x, tol) ||
+       !approx_equal(sqrt(x) * sqrt(x), x, tol) ||
+       !approx_equal(atan(tan(x)), x, tol) ||
+       !approx_equal(asin(sin(x)), x, tol) ||
+       !approx_equal(acos(cos(x)), x, tol) ||
+       !approx_equal(asinh(sinh(x)), x, tol) ||
+       !approx_equal(atanh(tanh(x)), x, tol) ||
+       !approx_equal(log1p(expm1(x)), x, tol) ||
+       !approx_equal(cbrt(x * x * x), x, tol) ||
+       !approx_equal(pow(x, x), exp(x * log(x)), tol))
+    {
+        throw std::runtime_error{"inverse functions"};
+    }
+
+    //real cube root of negative arguments
+    const auto nx = jet<T,6>{-x0, T(1)};
+    if(!approx_equal(cbrt(nx), -cbrt(-nx), tol) ||
+       !approx_equal(cbrt(nx * nx * nx), nx, tol))
+    {
+        throw std::runtime_error{"cbrt of negative argument"};
+    }
+
+    //identities
+    const auto c = cos(x);
+    const auto ch = cosh(x);
+    const auto sh = sinh(x);
+    if(!approx_equal((s * s) + (c * c), jet<T,6>{T(1)}, tol) ||
+       !approx_equal((ch * ch) - (sh * sh), jet<T,6>{T(1)}, tol) ||
+       !approx_equal(erf(x) + erfc(x), jet<T,6>{T(1)}, tol))
+    {
+        throw std::runtime_error{"identities"};
+    }
+
+    //first order part agrees with dual numbers
+    const auto d = make_dual(sin(exp(x) * x));
+    const auto dd = sin(exp(dual<T>{x0, T(1)}) * dual<T>{x0, T(1)});
+    if(!approx_equal(d, dd, tol)) {
+        throw std::runtime_error{"dual compatibility"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    using namespace am::num;
+
+    try {
+        test_construction<float>();
+        test_construction<double>();
+        test_construction<long double>();
+
+        test_arithmetic<double>();
+        test_arithmetic<long double>();
+
+        test_functions<double>();
+        test_functions<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
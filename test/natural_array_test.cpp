@@ -0,0 +1,140 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/natural_array.h"
+
+#include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <iostream>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+/// @brief all pairs of a set of (edge case) values in a and b
+template<class T>
+void make_pairs(natural_array<T>& a, natural_array<T>& b)
+{
+    using nat = natural<T>;
+    using lim = std::numeric_limits<T>;
+
+    std::vector<nat> vals {
+        nat{0}, nat{1}, nat{2}, nat{3}, nat{T(lim::max() / 2)},
+        nat{T(lim::max() / 2 + 1)}, nat{T(lim::max() - 1)}, nat{lim::max()},
+        nat::infinity() };
+
+    std::mt19937_64 urng {7};
+    std::uniform_int_distribution<long long> distr {0, lim::max()};
+    for(int i = 0; i < 20; ++i) vals.push_back(nat{T(distr(urng))});
+
+    a.clear();
+    b.clear();
+    for(const auto& x : vals) {
+        for(const auto& y : vals) {
+            a.push_back(x);
+            b.push_back(y);
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_against_scalar()
+{
+    natural_array<T> a, b, r;
+    make_pairs(a, b);
+
+    const auto check = [&](auto op, const char* name) {
+        for(std::size_t i = 0; i < a.size(); ++i) {
+            auto x = a[i];
+            op(x, b[i]);
+            if(r[i] != x || isinf(r[i]) != isinf(x)) {
+                throw std::logic_error(name);
+            }
+        }
+    };
+
+    add_saturate(a, b, r);
+    check([](auto& x, const auto& y) { x += y; }, "natural_array: add");
+
+    sub_saturate(a, b, r);
+    check([](auto& x, const auto& y) { x -= y; }, "natural_array: sub");
+
+    mul_saturate(a, b, r);
+    check([](auto& x, const auto& y) { x *= y; }, "natural_array: mul");
+
+    min(a, b, r);
+    check([](auto& x, const auto& y) { if(y < x) x = y; }, "natural_array: min");
+
+    max(a, b, r);
+    check([](auto& x, const auto& y) { if(y > x) x = y; }, "natural_array: max");
+
+    //in-place
+    r = a;
+    add_saturate(r, b, r);
+    check([](auto& x, const auto& y) { x += y; }, "natural_array: in-place");
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_sum()
+{
+    using nat = natural<T>;
+
+    natural_array<T> a;
+    if(sum(a) != 0) throw std::logic_error("natural_array: empty sum");
+
+    for(int i = 1; i <= 10; ++i) a.push_back(nat{T(i)});
+    if(sum(a) != 55) throw std::logic_error("natural_array: sum");
+
+    a.push_back(nat::max());
+    if(sum(a) != nat::max() || isinf(sum(a))) {
+        throw std::logic_error("natural_array: saturated sum");
+    }
+
+    a.set(3, nat::infinity());
+    if(!isinf(sum(a))) throw std::logic_error("natural_array: infinite sum");
+
+    const natural_array<T> c (1000, nat{T(3)});
+    auto s = nat{0};
+    for(std::size_t i = 0; i < c.size(); ++i) s += c[i];
+    if(sum(c) != s) throw std::logic_error("natural_array: long sum");
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_against_scalar<std::int8_t>();
+        test_against_scalar<std::int16_t>();
+        test_against_scalar<std::int32_t>();
+        test_against_scalar<std::int64_t>();
+
+        test_sum<std::int8_t>();
+        test_sum<std::int16_t>();
+        test_sum<std::int32_t>();
+        test_sum<std::int64_t>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
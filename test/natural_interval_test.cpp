@@ -0,0 +1,144 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/natural_interval.h"
+
+#include <stdexcept>
+#include <limits>
+#include <vector>
+#include <iostream>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+void test_set_algebra()
+{
+    using nat = natural<int>;
+    using ivl = natural_interval<int>;
+
+    const auto a = ivl{nat{2}, nat{8}};
+    const auto b = ivl{nat{5}, nat::infinity()};
+    const auto c = ivl{nat{10}, nat{12}};
+    const auto e = ivl::empty_set();
+
+    if(!e.empty() || a.empty() || ivl{}.empty() || e.contains(nat{0})) {
+        throw std::logic_error("natural_interval: empty");
+    }
+
+    if(intersection(a, b) != ivl{nat{5}, nat{8}} ||
+       !intersection(a, c).empty() ||
+       !intersection(a, e).empty() ||
+       intersection(a, c) != e)
+    {
+        throw std::logic_error("natural_interval: intersection");
+    }
+
+    if(hull(a, c) != ivl{nat{2}, nat{12}} ||
+       hull(c, b) != ivl{nat{5}, nat::infinity()} ||
+       hull(a, e) != a || hull(e, a) != a)
+    {
+        throw std::logic_error("natural_interval: hull");
+    }
+
+    if(!intersects(a, b) || intersects(a, c) || !disjoint(a, e) ||
+       !intersects(b, c) || !a.contains(e) || e.contains(a))
+    {
+        throw std::logic_error("natural_interval: intersects");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief bounds must be equal to the natural<T> results on the bounds
+template<class T>
+void test_arithmetic()
+{
+    using nat = natural<T>;
+    using ivl = natural_interval<T>;
+    constexpr auto m = std::numeric_limits<T>::max();
+
+    const std::vector<nat> vals {
+        nat{0}, nat{1}, nat{2}, nat{5}, nat{T(m / 2)},
+        nat{T(m - 1)}, nat{m}, nat::infinity() };
+
+    std::vector<ivl> ivls {ivl::empty_set()};
+    for(const auto& l : vals) {
+        for(const auto& r : vals) {
+            if(l <= r) ivls.push_back(ivl{l, r});
+        }
+    }
+
+    for(const auto& a : ivls) {
+        for(const auto& b : ivls) {
+            const auto s = a + b;
+            const auto d = a - b;
+            const auto p = a * b;
+
+            if(a.empty() || b.empty()) {
+                if(!s.empty() || !d.empty() || !p.empty()) {
+                    throw std::logic_error("natural_interval: empty operand");
+                }
+                continue;
+            }
+            if(s != ivl{a.min() + b.min(), a.max() + b.max()} ||
+               d != ivl{a.min() - b.max(), a.max() - b.min()} ||
+               p != ivl{a.min() * b.min(), a.max() * b.max()})
+            {
+                throw std::logic_error("natural_interval: arithmetic bounds");
+            }
+            //all pointwise results must be contained
+            for(const auto& x : vals) {
+                if(!a.contains(x)) continue;
+                for(const auto& y : vals) {
+                    if(!b.contains(y)) continue;
+                    if(!s.contains(x + y) || !d.contains(x - y) ||
+                       !p.contains(x * y))
+                    {
+                        throw std::logic_error("natural_interval: containment");
+                    }
+                }
+            }
+        }
+    }
+
+    //with scalars
+    const auto a = ivl{nat{2}, nat{5}};
+    if((a + nat{3}) != ivl{nat{5}, nat{8}} ||
+       (nat{3} + a) != ivl{nat{5}, nat{8}} ||
+       (a - nat{3}) != ivl{nat{0}, nat{2}} ||
+       (nat{6} - a) != ivl{nat{1}, nat{4}} ||
+       (a * nat{2}) != ivl{nat{4}, nat{10}} ||
+       (nat::infinity() * a) != ivl{nat::infinity(), nat::infinity()})
+    {
+        throw std::logic_error("natural_interval: scalar arithmetic");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_set_algebra();
+
+        test_arithmetic<int>();
+        test_arithmetic<long long>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,140 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/natural_propagation.h"
+
+#include <stdexcept>
+#include <vector>
+#include <iostream>
+
+
+using namespace am;
+using namespace am::num;
+
+using nat = natural<int>;
+using ivl = natural_interval<int>;
+
+
+//-------------------------------------------------------------------
+void test_precedences()
+{
+    // task start times; two independent chains:
+    //   0 -(3)-> 1 -(2)-> 2,  0 -(4)-> 2,  deadline(2) = 10
+    //   3 -(5)-> 4
+    natural_propagator<int> p {5};
+    p.add_less_equal(0, 1, nat{3});
+    p.add_less_equal(1, 2, nat{2});
+    p.add_less_equal(0, 2, nat{4});
+    p.add_less_equal(3, 4, nat{5});
+
+    if(p.component_count() != 2 ||
+       p.component_size(0) != 3 || p.component_size(1) != 2)
+    {
+        throw std::logic_error("natural_propagator: components");
+    }
+
+    std::vector<ivl> dom (5, ivl{});
+    dom[2] = ivl{nat{10}};
+    if(p.propagate(dom) != propagation_status::fixpoint) {
+        throw std::logic_error("natural_propagator: no fixpoint");
+    }
+    if(dom[0] != ivl{nat{0}, nat{5}} ||
+       dom[1] != ivl{nat{3}, nat{8}} ||
+       dom[2] != ivl{nat{5}, nat{10}} ||
+       dom[3] != ivl{nat{0}, nat::infinity()} ||
+       dom[4] != ivl{nat{5}, nat::infinity()})
+    {
+        throw std::logic_error("natural_propagator: precedence bounds");
+    }
+
+    //components separately -> same result
+    std::vector<ivl> dom2 (5, ivl{});
+    dom2[2] = ivl{nat{10}};
+    for(std::size_t c = 0; c < p.component_count(); ++c) {
+        p.propagate_component(c, dom2);
+    }
+    if(dom2 != dom) {
+        throw std::logic_error("natural_propagator: component-wise");
+    }
+
+    //deadline too tight
+    dom.assign(5, ivl{});
+    dom[2] = ivl{nat{4}};
+    if(p.propagate(dom) != propagation_status::inconsistent) {
+        throw std::logic_error("natural_propagator: inconsistency");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void test_sum()
+{
+    natural_propagator<int> p {3};
+    p.add_sum(2, 0, 1);
+
+    std::vector<ivl> dom {
+        ivl{nat{2}, nat{5}}, ivl{nat{3}, nat{4}}, ivl{nat{7}, nat{7}} };
+
+    if(p.propagate(dom) != propagation_status::fixpoint ||
+       dom[0] != ivl{nat{3}, nat{4}} ||
+       dom[1] != ivl{nat{3}, nat{4}} ||
+       dom[2] != ivl{nat{7}, nat{7}})
+    {
+        throw std::logic_error("natural_propagator: sum");
+    }
+
+    //infinite summand: nothing known about the other one
+    dom = { ivl{}, ivl{nat::infinity(), nat::infinity()}, ivl{} };
+    if(p.propagate(dom) != propagation_status::fixpoint ||
+       dom[0] != ivl{} || !isinf(dom[2].min()))
+    {
+        throw std::logic_error("natural_propagator: infinite sum");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+void test_cycle()
+{
+    natural_propagator<int> p {2};
+    p.add_less_equal(0, 1, nat{1});
+    p.add_less_equal(1, 0, nat{1});
+
+    //unbounded domains: lower bounds would grow up to saturation
+    std::vector<ivl> dom (2, ivl{});
+    if(p.propagate(dom) != propagation_status::sweep_limit) {
+        throw std::logic_error("natural_propagator: positive cycle");
+    }
+
+    //bounded domains run empty
+    dom.assign(2, ivl{nat{3}});
+    if(p.propagate(dom) != propagation_status::inconsistent) {
+        throw std::logic_error("natural_propagator: bounded positive cycle");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_precedences();
+        test_sum();
+        test_cycle();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -14,6 +14,7 @@
 #include <stdexcept>
 #include <cstdint>
 #include <iostream>
+#include <limits>
 
 
 using namespace am;
@@ -156,6 +157,84 @@ void natural_comparison()
 
 
 
+//-------------------------------------------------------------------
+template<class T>
+void natural_compound()
+{
+    using nat = natural<T>;
+    using lim = std::numeric_limits<T>;
+    using w_t = detail::int128_t;
+
+    //reference semantics: saturate at max, 0 * inf = 0
+    const auto inf = nat::infinity();
+    const T vals[] {0, 1, 2, 3, T(lim::max() / 2), T(lim::max() / 2 + 1),
+                    T(lim::max() - 1), lim::max()};
+
+    const auto check = [](const nat& x, bool xinf, w_t expected) {
+        if(xinf) return isinf(x);
+        const auto e = (expected > w_t(lim::max())) ? w_t(lim::max())
+                     : (expected < 0) ? w_t(0) : expected;
+        return !isinf(x) && w_t(x.value()) == e;
+    };
+
+    for(const auto a : vals) {
+        for(const auto b : vals) {
+            auto x = nat{a}; x += nat{b};
+            auto y = nat{a}; y -= nat{b};
+            auto z = nat{a}; z *= nat{b};
+            auto u = nat{a}; u += b;
+            auto v = nat{a}; v -= b;
+            auto w = nat{a}; w *= b;
+            if(!check(x, false, w_t(a) + w_t(b)) ||
+               !check(y, false, w_t(a) - w_t(b)) ||
+               !check(z, false, w_t(a) * w_t(b)) ||
+               !check(u, false, w_t(a) + w_t(b)) ||
+               !check(v, false, w_t(a) - w_t(b)) ||
+               !check(w, false, w_t(a) * w_t(b)) )
+            {
+                throw std::logic_error("am::num::natural compound ops");
+            }
+        }
+        //negative scalars
+        auto x = nat{a}; x += T(-1);
+        auto y = nat{a}; y -= lim::min();
+        auto z = nat{a}; z *= T(-2);
+        if(!check(x, false, w_t(a) - 1) ||
+           !check(y, false, w_t(lim::max())) ||
+           !check(z, false, 0))
+        {
+            throw std::logic_error("am::num::natural compound ops: negative");
+        }
+
+        //infinity
+        auto i1 = nat{a}; i1 += inf;
+        auto i2 = inf;    i2 += nat{a};
+        auto i3 = nat{a}; i3 -= inf;
+        auto i4 = inf;    i4 -= nat{a};
+        auto i5 = nat{a}; i5 *= inf;
+        auto i6 = inf;    i6 *= nat{a};
+        auto i7 = inf;    i7 += a;
+        auto i8 = inf;    i8 -= a;
+        auto i9 = inf;    i9 *= a;
+        if(!isinf(i1) || !isinf(i2) || i3 != 0 || !isinf(i4) ||
+           !check(i5, a != 0, 0) || !check(i6, a != 0, 0) ||
+           !isinf(i7) || !isinf(i8) || !check(i9, a != 0, 0))
+        {
+            throw std::logic_error("am::num::natural compound ops: infinity");
+        }
+    }
+
+    auto i = inf;
+    i -= inf;
+    if(i != 0) throw std::logic_error("am::num::natural inf - inf");
+
+    auto d = nat{5};
+    const auto old = d--;
+    if(old != 5 || d != 4) throw std::logic_error("am::num::natural postfix --");
+}
+
+
+
 //-------------------------------------------------------------------
 int main()
 {
@@ -163,6 +242,11 @@ int main()
         natural_init();
         natural_arithmetic();
         natural_comparison();
+
+        natural_compound<std::int8_t>();
+        natural_compound<std::int16_t>();
+        natural_compound<int>();
+        natural_compound<long long int>();
     }
     catch(std::exception& e) {
         std::cerr << e.what();
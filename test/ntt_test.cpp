@@ -0,0 +1,231 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#include  "../include/ntt.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+template<std::uint32_t p>
+std::vector<choice<std::uint32_t,p>>
+random_poly(std::size_t n, std::mt19937& urng)
+{
+    std::uniform_int_distribution<std::uint32_t> distr {0, p - 1};
+    std::vector<choice<std::uint32_t,p>> a;
+    a.reserve(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        a.push_back(choice<std::uint32_t,p>{distr(urng)});
+    }
+    return a;
+}
+
+
+//-------------------------------------------------------------------
+template<std::uint32_t p>
+void test_montgomery()
+{
+    using mont = detail::montgomery32<p>;
+
+    if(std::uint32_t(p * mont::pinv) != 1) {
+        throw std::logic_error("ntt: montgomery inverse");
+    }
+
+    std::mt19937 urng {p};
+    std::uniform_int_distribution<std::uint32_t> distr {0, p - 1};
+    for(int i = 0; i < 10000; ++i) {
+        const auto a = distr(urng);
+        const auto b = distr(urng);
+        const auto r = mont::from_mont(mont::mul(mont::to_mont(a),
+                                                 mont::to_mont(b)));
+        if(r != std::uint32_t((std::uint64_t(a) * b) % p) ||
+           mont::from_mont(mont::to_mont(a)) != a)
+        {
+            throw std::logic_error("ntt: montgomery multiplication");
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------
+template<std::uint32_t p>
+void test_transform()
+{
+    using ch = choice<std::uint32_t,p>;
+
+    std::mt19937 urng {13};
+
+    for(std::size_t n = 1; n <= 64; n *= 2) {
+        const auto a = random_poly<p>(n, urng);
+        const ntt_plan<p> plan {n};
+
+        auto t = a;
+        plan.forward(t);
+
+        //naive DFT; forward output is in bit-reversed order
+        const auto w = pow(detail::primitive_root<p>(),
+                           (p - 1) / std::uint32_t(n));
+        int lg = 0;
+        while((std::size_t(1) << lg) < n) ++lg;
+        for(std::size_t k = 0; k < n; ++k) {
+            std::size_t r = 0;
+            for(int b = 0; b < lg; ++b) {
+                if(k & (std::size_t(1) << b)) r |= std::size_t(1) << (lg - 1 - b);
+            }
+            auto s = ch{std::uint32_t(0)};
+            const auto wk = pow(w, r);
+            auto x = ch{std::uint32_t(1)};
+            for(std::size_t j = 0; j < n; ++j) {
+                s += a[j] * x;
+                x *= wk;
+            }
+            if(t[k] != s) throw std::logic_error("ntt: forward transform");
+        }
+
+        plan.inverse(t);
+        if(t != a) throw std::logic_error("ntt: inverse transform");
+    }
+
+    //sizes beyond the cache block
+    for(std::size_t n : {std::size_t(1) << 16, std::size_t(1) << 17}) {
+        const auto a = random_poly<p>(n, urng);
+        const ntt_plan<p> plan {n};
+        auto t = a;
+        plan.forward(t);
+        plan.inverse(t);
+        if(t != a) throw std::logic_error("ntt: roundtrip");
+    }
+}
+
+
+//-------------------------------------------------------------------
+template<std::uint32_t p>
+void test_poly_multiply(std::size_t maxlen)
+{
+    using ch = choice<std::uint32_t,p>;
+
+    std::mt19937 urng {17};
+    std::uniform_int_distribution<std::size_t> len {1, maxlen};
+
+    for(int i = 0; i < 30; ++i) {
+        const auto a = random_poly<p>(len(urng), urng);
+        const auto b = random_poly<p>(len(urng), urng);
+
+        std::vector<ch> ref (a.size() + b.size() - 1, ch{std::uint32_t(0)});
+        for(std::size_t j = 0; j < a.size(); ++j) {
+            for(std::size_t k = 0; k < b.size(); ++k) {
+                ref[j+k] += a[j] * b[k];
+            }
+        }
+        if(poly_multiply(a, b) != ref) {
+            throw std::logic_error("ntt: poly_multiply");
+        }
+    }
+
+    if(!poly_multiply(std::vector<ch>{}, random_poly<p>(5, urng)).empty()) {
+        throw std::logic_error("ntt: poly_multiply empty");
+    }
+}
+
+
+//-------------------------------------------------------------------
+template<std::uint32_t p>
+choice<std::uint32_t,p>
+horner(const std::vector<choice<std::uint32_t,p>>& a, choice<std::uint32_t,p> x)
+{
+    auto y = choice<std::uint32_t,p>{std::uint32_t(0)};
+    for(auto i = a.rbegin(); i != a.rend(); ++i) y = y * x + *i;
+    return y;
+}
+
+
+//-------------------------------------------------------------------
+/// @brief products with transforms larger than the block size (2^15);
+///        checked by evaluation at random points instead of schoolbook
+template<std::uint32_t p>
+void test_large_poly_multiply()
+{
+    using ch = choice<std::uint32_t,p>;
+
+    std::mt19937 urng {23};
+    std::uniform_int_distribution<std::uint32_t> distr {0, p - 1};
+
+    for(auto n : {std::size_t(40000), std::size_t(70001)}) {
+        const auto a = random_poly<p>(n, urng);
+        const auto b = random_poly<p>(n / 2 + 3, urng);
+        const auto c = poly_multiply(a, b);
+
+        if(c.size() != a.size() + b.size() - 1) {
+            throw std::logic_error("ntt: large poly_multiply size");
+        }
+        for(int i = 0; i < 5; ++i) {
+            const auto x = ch{distr(urng)};
+            if(horner(c, x) != horner(a, x) * horner(b, x)) {
+                throw std::logic_error("ntt: large poly_multiply");
+            }
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------
+void test_size_limit()
+{
+    //7681 - 1 = 2^9 * 15
+    constexpr std::uint32_t p = 7681;
+    if(ntt_plan<p>::max_size() != 512) {
+        throw std::logic_error("ntt: max_size");
+    }
+
+    bool thrown = false;
+    try {
+        ntt_plan<p> plan {1024};
+    }
+    catch(std::length_error&) {
+        thrown = true;
+    }
+    if(!thrown) throw std::logic_error("ntt: size limit");
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_montgomery<998244353>();
+        test_montgomery<469762049>();
+        test_montgomery<7681>();
+
+        test_transform<998244353>();
+        test_transform<469762049>();
+
+        test_poly_multiply<998244353>(3000);
+        test_poly_multiply<469762049>(300);
+        test_poly_multiply<7681>(256);
+
+        test_large_poly_multiply<998244353>();
+        test_large_poly_multiply<469762049>();
+
+        test_size_limit();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,121 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/packed_natural_array.h"
+
+#include <stdexcept>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <iostream>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+template<int Bits>
+void test_access()
+{
+    using pack_t = packed_natural_array<Bits>;
+    using nat = natural<int>;
+
+    const int m = (1 << Bits) - 2;
+    if(pack_t::max() != m) throw std::logic_error("packed: max");
+
+    const std::size_t n = 1003;
+    pack_t a (n);
+    if(a.size() != n || a.byte_size() < (n * Bits) / 8) {
+        throw std::logic_error("packed: size");
+    }
+
+    //reference values
+    std::vector<nat> ref;
+    std::mt19937 urng {Bits};
+    std::uniform_int_distribution<int> distr {0, m + 5};
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto v = distr(urng);
+        ref.push_back((v == m + 5) ? nat::infinity() : nat{v});
+        a[i] = ref.back();
+        //saturation
+        if(v > m && v < m + 5) ref.back() = nat{m};
+    }
+    //neighbours must not be overwritten
+    const auto& ca = a;
+    for(std::size_t i = 0; i < n; ++i) {
+        if(ca[i] != ref[i] || isinf(ca[i]) != isinf(ref[i])) {
+            throw std::logic_error("packed: element access");
+        }
+    }
+
+    //proxy arithmetic
+    a[5] = nat{3};
+    a[5] += nat{4};
+    a[5] *= nat{2};
+    a[5] -= nat{1};
+    a[6] = a[5];
+    a[7] = nat{m};
+    a[7] += nat{1};
+    a[8] = nat::infinity();
+    a[8] -= nat{1};
+    if(ca[5] != 13 || ca[6] != 13 || ca[7] != m || !isinf(ca[8])) {
+        throw std::logic_error("packed: proxy arithmetic");
+    }
+
+    //bulk codecs
+    natural_array<int> u;
+    decode(a, u);
+    pack_t b;
+    encode(u, b);
+    if(u.size() != n || b.size() != n) {
+        throw std::logic_error("packed: bulk size");
+    }
+    for(std::size_t i = 0; i < n; ++i) {
+        const nat x = a[i];
+        const nat y = b[i];
+        if(u[i] != x || y != x || isinf(y) != isinf(x)) {
+            throw std::logic_error("packed: bulk decode/encode");
+        }
+    }
+
+    //resize and push_back
+    b.resize(10);
+    b.resize(20);
+    b.push_back(nat{1});
+    const auto& cb = b;
+    if(cb.size() != 21 || cb[15] != 0 || cb[20] != 1 || cb[9] != ca[9]) {
+        throw std::logic_error("packed: resize");
+    }
+
+    const pack_t c {nat{1}, nat::infinity(), nat{2}};
+    if(c.size() != 3 || c[0] != 1 || !isinf(c[1]) || c[2] != 2) {
+        throw std::logic_error("packed: initializer list");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_access<8>();
+        test_access<12>();
+        test_access<16>();
+        test_access<5>();
+        test_access<24>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
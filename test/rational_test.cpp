@@ -14,6 +14,12 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <limits>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <string>
+#include <system_error>
 
 
 using namespace am;
@@ -64,6 +70,369 @@ void test()
 
 
 
+//-------------------------------------------------------------------
+template<class T>
+void test_eager_normalization()
+{
+    using rat = rational<T,eager_normalization>;
+
+    rat r1 {2, 8};
+    rat r2 {-3, 24};
+    if(r1.numer() != 1 || r1.denom() != 4 ||
+       r2.numer() != -1 || r2.denom() != 8)
+    {
+        throw std::runtime_error{"eager: construction"};
+    }
+
+    auto r3 = r1 + r2;
+    if(r3.numer() != 1 || r3.denom() != 8) {
+        throw std::runtime_error{"eager: addition"};
+    }
+
+    auto r4 = r1 - r2;
+    if(r4.numer() != 3 || r4.denom() != 8) {
+        throw std::runtime_error{"eager: subtraction"};
+    }
+
+    auto r5 = rat{6, 35} * rat{14, 9};
+    if(r5.numer() != 4 || r5.denom() != 15) {
+        throw std::runtime_error{"eager: multiplication"};
+    }
+
+    auto r6 = r1 / r2;
+    if(r6.numer() != -2 || r6.denom() != 1) {
+        throw std::runtime_error{"eager: division"};
+    }
+
+    auto r7 = (r1 - r1) * r2;
+    if(r7.numer() != 0 || r7.denom() != 1) {
+        throw std::runtime_error{"eager: zero"};
+    }
+
+    //harmonic number H(20) = 55835135 / 15519504 would overflow
+    //without normalization for 32 bit types
+    if(sizeof(T) >= 4) {
+        rat h {0};
+        for(int i = 1; i <= 20; ++i) h += rat{1, T(i)};
+        if(h.numer() != T(55835135) || h.denom() != T(15519504)) {
+            throw std::runtime_error{"eager: accumulation"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_threshold_normalization()
+{
+    using rat = rational<T,threshold_normalization<10>>;
+
+    //small values are left alone
+    auto r1 = rat{1, 4} + rat{1, 8};
+    if(r1.numer() != 12 || r1.denom() != 32) {
+        throw std::runtime_error{"threshold: below"};
+    }
+
+    //reduced as soon as a component reaches 2^10
+    auto r2 = rat{1, 32} * rat{2, 32};
+    if(r2.numer() != 1 || r2.denom() != 512) {
+        throw std::runtime_error{"threshold: above"};
+    }
+
+    rat s {0};
+    for(int i = 0; i < 100; ++i) s += rat{1, 6};
+    if(s != rat{50, 3} || s.denom() >= T(1024)) {
+        throw std::runtime_error{"threshold: accumulation"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_comparison_overflow()
+{
+    constexpr auto m = std::numeric_limits<T>::max();
+
+    //cross products don't fit into T
+    const rational<T> x {T(m - 1), m};
+    const rational<T> y {T(m - 2), T(m - 1)};
+
+    if(!(x > y) || !(y < x) || x <= y || y >= x || x == y || !(x != y)) {
+        throw std::runtime_error{"comparison overflow"};
+    }
+    if(!(x < T(1)) || !(T(1) > x) || x > T(1) || T(1) < x) {
+        throw std::runtime_error{"comparison with integer"};
+    }
+    if(rational<T>{T(m - 1), T(m - 3)} != rational<T>{T((m - 1) / 2), T((m - 3) / 2)}) {
+        throw std::runtime_error{"equality overflow"};
+    }
+
+    if(detail::compare_fractions_cf(T(m - 1), m, T(m - 2), T(m - 1)) != 1 ||
+       detail::compare_fractions_cf(T(-7), T(3), T(-9), T(4)) != -1 ||
+       detail::compare_fractions_cf(T(14), T(6), T(7), T(3)) != 0)
+    {
+        throw std::runtime_error{"continued fraction comparison"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_overflow_checks()
+{
+    using rat = rational<T,overflow_checked<>>;
+    constexpr auto m = std::numeric_limits<T>::max();
+    constexpr auto h = T(T(1) << (std::numeric_limits<T>::digits / 2 + 1));
+
+    //intermediate denominator overflows, reduced result fits
+    auto r1 = rat{T(1), T(3 * h)} + rat{T(1), T(5 * h)};
+    if(r1 != rat{T(8), T(15 * h)} || r1.denom() != T(15 * h / 8)) {
+        throw std::runtime_error{"checked addition"};
+    }
+
+    auto r2 = rat{h, T(3)} * rat{h, T(6 * h)};
+    if(r2.numer() != T(h / 2) || r2.denom() != T(9)) {
+        throw std::runtime_error{"checked multiplication"};
+    }
+
+    auto r3 = rat{h, T(7)} / rat{T(-2 * h), h};
+    if(r3.numer() != T(-h / 2) || r3.denom() != T(7)) {
+        throw std::runtime_error{"checked division"};
+    }
+
+    //no overflow: native path, policy decides about normalization
+    auto r4 = rat{T(1), T(4)} + rat{T(1), T(8)};
+    if(r4.numer() != T(12) || r4.denom() != T(32)) {
+        throw std::runtime_error{"checked fast path"};
+    }
+
+    bool thrown = false;
+    try {
+        auto r5 = rat{m} * rat{T(2)};
+        r5.normalize();
+    } catch(std::overflow_error&) {
+        thrown = true;
+    }
+    if(!thrown) throw std::runtime_error{"checked overflow exception"};
+
+    using erat = rational<T,overflow_checked<eager_normalization>>;
+    auto r6 = erat{T(m - 1), T(m)} - erat{T(m - 2), T(m)};
+    if(r6.numer() != T(1) || r6.denom() != m) {
+        throw std::runtime_error{"checked eager subtraction"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_best_rational()
+{
+    const auto check = [](double x, T maxd, T n, T d) {
+        const auto r = best_rational(x, maxd);
+        if(r.numer() != n || r.denom() != d) {
+            throw std::runtime_error{"best_rational"};
+        }
+    };
+
+    check(3.141592653589793, T(1000), T(355), T(113));
+    check(2.718281828459045, T(10), T(19), T(7));
+    check(-2.718281828459045, T(10), T(-19), T(7));
+    check(0.333333, T(100), T(1), T(3));
+    check(2.6, T(1), T(3), T(1));
+    check(2.05, T(5), T(2), T(1));
+    check(0.0, T(7), T(0), T(1));
+    check(1.4142135623730951, T(30000), T(19601), T(13860));
+
+    //compare against exhaustive search
+    std::mt19937 urng {5};
+    std::uniform_real_distribution<double> distr {-10.0, 10.0};
+    for(int i = 0; i < 1000; ++i) {
+        const auto x = distr(urng);
+        const auto maxd = T(1 + i % 60);
+        const auto r = best_rational(x, maxd);
+
+        double best = std::numeric_limits<double>::max();
+        for(T q = 1; q <= maxd; ++q) {
+            const auto p = std::round(x * double(q));
+            best = std::min(best, std::abs(x - p / double(q)));
+        }
+        const auto err = std::abs(x - double(r.numer()) / double(r.denom()));
+        if(r.denom() > maxd || err > best + 1e-15) {
+            throw std::runtime_error{"best_rational: not optimal"};
+        }
+    }
+
+    const std::vector<double> xs {0.5, 0.25, 1.0/3.0, 0.2};
+    std::vector<rational<T>> rs (xs.size());
+    best_rational(xs.begin(), xs.end(), rs.begin(), T(16));
+    if(rs[0] != rational<T>{1,2} || rs[1] != rational<T>{1,4} ||
+       rs[2] != rational<T>{1,3} || rs[3] != rational<T>{1,5})
+    {
+        throw std::runtime_error{"best_rational: batch"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_rational_sum()
+{
+    using rat = rational<T>;
+
+    //denominators with few distinct prime factors
+    const T dens[] {1, 2, 3, 4, 6, 8, 12, 16, 24, 36, 48, 72};
+    std::mt19937 urng {3};
+    std::uniform_int_distribution<int> num {-50, 50};
+    std::uniform_int_distribution<std::size_t> den {0, 11};
+
+    for(std::size_t n : {0, 1, 5, 16, 17, 100, 1000, 5000}) {
+        std::vector<rat> xs;
+        rational<T,eager_normalization> ref {0};
+        for(std::size_t i = 0; i < n; ++i) {
+            const T d = dens[den(urng)];
+            //unnormalized and negative denominators
+            const T f = (i % 3 == 0) ? T(-2) : T(1);
+            xs.emplace_back(T(T(num(urng)) * f), T(d * f));
+            ref += rational<T,eager_normalization>{xs.back()};
+        }
+        const auto s = rational_sum(xs.begin(), xs.end());
+        if(s.numer() != ref.numer() || s.denom() != ref.denom()) {
+            throw std::runtime_error{"rational_sum"};
+        }
+        for(std::size_t t : {1, 2, 3, 8}) {
+            const auto sp = rational_sum(xs.begin(), xs.end(), t);
+            if(sp.numer() != ref.numer() || sp.denom() != ref.denom()) {
+                throw std::runtime_error{"parallel rational_sum"};
+            }
+        }
+    }
+
+    //lcm of 1...60 doesn't fit into 64 bits
+    using crat = rational<T,overflow_checked<>>;
+    std::vector<crat> hs;
+    for(int i = 1; i <= 60; ++i) hs.emplace_back(T(1), T(i));
+    bool thrown = false;
+    try {
+        rational_sum(hs.begin(), hs.end());
+    } catch(std::overflow_error&) {
+        thrown = true;
+    }
+    if(!thrown) throw std::runtime_error{"rational_sum: overflow"};
+
+    //overflow in a chunk summed by another thread
+    std::vector<crat> ps (3000, crat{T(1)});
+    ps.insert(ps.end(), hs.begin(), hs.end());
+    thrown = false;
+    try {
+        rational_sum(ps.begin(), ps.end(), 2);
+    } catch(std::overflow_error&) {
+        thrown = true;
+    }
+    if(!thrown) throw std::runtime_error{"parallel rational_sum: overflow"};
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_chars()
+{
+    using rat = rational<T>;
+
+    const auto parse = [](const std::string& str, T n, T d, std::size_t len) {
+        rat r {7};
+        const auto res = parse_rational(str.data(), str.data() + str.size(), r);
+        if(res.ec != std::errc{} || res.ptr != str.data() + len ||
+           r.numer() != n || r.denom() != d)
+        {
+            throw std::runtime_error{"parse_rational: " + str};
+        }
+    };
+
+    parse("42", 42, 1, 2);
+    parse("-42 ", -42, 1, 3);
+    parse("3/4", 3, 4, 3);
+    parse("-6/8x", -6, 8, 4);
+    parse("2/", 2, 1, 1);
+    parse("1.25", 125, 100, 4);
+    parse("-0.5", -5, 10, 4);
+    parse(".5", 5, 10, 2);
+    parse("5.", 5, 1, 2);
+    parse("2.5e-3", 25, 10000, 6);
+    parse("-1.5E2", -150, 1, 6);
+    parse("7e", 7, 1, 1);
+
+    const auto fail = [](const std::string& str, std::errc ec) {
+        rat r {7};
+        const auto res = parse_rational(str.data(), str.data() + str.size(), r);
+        if(res.ec != ec || r != rat{7}) {
+            throw std::runtime_error{"parse_rational: error " + str};
+        }
+    };
+
+    fail("", std::errc::invalid_argument);
+    fail("-", std::errc::invalid_argument);
+    fail("+1", std::errc::invalid_argument);
+    fail(" 1", std::errc::invalid_argument);
+    fail("1/0", std::errc::invalid_argument);
+    fail("99999999999999999999999", std::errc::result_out_of_range);
+    fail("1e40", std::errc::result_out_of_range);
+
+    //lowest value
+    const auto lo = std::to_string(std::numeric_limits<T>::lowest());
+    parse(lo, std::numeric_limits<T>::lowest(), 1, lo.size());
+
+    //round trip
+    char buf[64];
+    for(const auto& x : {rat{-3, 4}, rat{5}, rat{0}, rat{1, -2},
+                         rat{std::numeric_limits<T>::lowest(), 3}})
+    {
+        const auto w = to_chars(buf, buf + sizeof(buf), x);
+        rat y;
+        const auto r = parse_rational(buf, w.ptr, y);
+        if(w.ec != std::errc{} || r.ec != std::errc{} || r.ptr != w.ptr ||
+           y != x)
+        {
+            throw std::runtime_error{"to_chars / parse_rational round trip"};
+        }
+    }
+    const auto w = to_chars(buf, buf + 3, rat{-3, 4});
+    if(w.ec != std::errc::value_too_large || w.ptr != buf + 3) {
+        throw std::runtime_error{"to_chars: buffer too small"};
+    }
+    const auto w2 = to_chars(buf, buf + 4, rat{-3, 4});
+    if(w2.ec != std::errc{} || std::string(buf, w2.ptr) != "-3/4") {
+        throw std::runtime_error{"to_chars"};
+    }
+
+    //bulk
+    const std::string text = " 1/2, -3\n0.25;\t7/8\r\n";
+    std::vector<rat> rs;
+    const auto res = parse_rationals(text.data(), text.data() + text.size(), rs);
+    if(res.ec != std::errc{} || rs.size() != 4 ||
+       rs[0] != rat{1,2} || rs[1] != rat{-3} ||
+       rs[2] != rat{1,4} || rs[3] != rat{7,8})
+    {
+        throw std::runtime_error{"parse_rationals"};
+    }
+
+    const std::string bad = "1/2 3x 4";
+    rs.clear();
+    const auto resb = parse_rationals(bad.data(), bad.data() + bad.size(), rs);
+    if(resb.ec != std::errc::invalid_argument ||
+       resb.ptr != bad.data() + 5 || rs.size() != 1)
+    {
+        throw std::runtime_error{"parse_rationals: invalid token"};
+    }
+}
+
+
+
 //-------------------------------------------------------------------
 int main()
 {
@@ -72,6 +441,29 @@ int main()
         test<int>();
         test<long int>();
         test<long long int>();
+
+        test_eager_normalization<short>();
+        test_eager_normalization<int>();
+        test_eager_normalization<long long int>();
+
+        test_threshold_normalization<short>();
+        test_threshold_normalization<int>();
+        test_threshold_normalization<long long int>();
+
+        test_comparison_overflow<int>();
+        test_comparison_overflow<long long int>();
+
+        test_overflow_checks<int>();
+        test_overflow_checks<long long int>();
+
+        test_best_rational<int>();
+        test_best_rational<long long int>();
+
+        test_rational_sum<int>();
+        test_rational_sum<long long int>();
+
+        test_chars<int>();
+        test_chars<long long int>();
     }
     catch(std::exception& e) {
         std::cerr << e.what();
@@ -0,0 +1,209 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#include  "../include/rns.h"
+#include  "../include/exact_solve.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+using namespace am;
+using namespace am::num;
+
+
+using rns4 = rns<choice<std::uint32_t,998244353>,
+                 choice<std::uint32_t,1000000007>,
+                 choice<std::uint32_t,469762049>,
+                 choice<std::uint32_t,167772161>>;
+
+using rns_small = rns<choice<std::uint8_t,255>,
+                      choice<std::uint16_t,256>,
+                      choice<int,7>>;
+
+
+//-------------------------------------------------------------------
+/// @brief reference: exact value reduced to [0,M)
+big_integer
+reduced(const big_integer& x, const big_integer& m)
+{
+    auto r = x % m;
+    if(r < big_integer{0}) r += m;
+    return r;
+}
+
+
+//-------------------------------------------------------------------
+template<class R>
+void test_arithmetic()
+{
+    const auto& m = R::modulus();
+
+    std::mt19937_64 urng {7};
+    std::uniform_int_distribution<std::int64_t> distr {-1000000000, 1000000000};
+
+    for(int i = 0; i < 500; ++i) {
+        const auto x = distr(urng);
+        const auto y = distr(urng);
+        const auto bx = big_integer{x};
+        const auto by = big_integer{y};
+        const auto rx = R{x};
+        const auto ry = R{y};
+
+        if(rx.value() != reduced(bx, m) ||
+           (rx + ry).value() != reduced(bx + by, m) ||
+           (rx - ry).value() != reduced(bx - by, m) ||
+           (rx * ry).value() != reduced(bx * by, m) ||
+           (-rx).value() != reduced(-bx, m) ||
+           R{bx} != rx)
+        {
+            throw std::logic_error("rns: arithmetic");
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------
+void test_product()
+{
+    std::mt19937_64 urng {11};
+    std::uniform_int_distribution<std::int64_t> distr {-100000, 100000};
+
+    //|product| < 2^68 < M/2 ~ 2^117
+    auto p = rns4{1};
+    big_integer ref {1};
+    for(int i = 0; i < 4; ++i) {
+        const auto x = distr(urng);
+        p *= x;
+        ref *= big_integer{x};
+    }
+    if(p.signed_value() != ref) {
+        throw std::logic_error("rns: product");
+    }
+
+    const auto big = big_integer{"-12345678901234567890123456789"};
+    if(rns4{big}.signed_value() != big) {
+        throw std::logic_error("rns: big_integer conversion");
+    }
+
+    //mixed-radix digits are reduced w.r.t. their moduli
+    const auto d = rns4{big}.mixed_radix_digits();
+    if(d[0] >= 998244353u || d[1] >= 1000000007u ||
+       d[2] >= 469762049u || d[3] >= 167772161u)
+    {
+        throw std::logic_error("rns: mixed-radix digits");
+    }
+}
+
+
+//-------------------------------------------------------------------
+/// @brief Gaussian elimination with all computations done lane-wise
+template<class R>
+big_integer
+rns_determinant(const std::vector<long long>& a, std::size_t n)
+{
+    std::vector<R> m;
+    for(auto x : a) m.push_back(R{x});
+
+    const auto zero = R{0};
+    auto det = R{1};
+    for(std::size_t c = 0; c < n; ++c) {
+        std::size_t p = c;
+        while(p < n && m[p*n + c] == zero) ++p;
+        if(p == n) return big_integer{0};
+        if(p != c) {
+            for(std::size_t j = 0; j < n; ++j) std::swap(m[c*n + j], m[p*n + j]);
+            det = -det;
+        }
+        det *= m[c*n + c];
+        const auto inv = inverse(m[c*n + c]);
+        for(std::size_t i = c + 1; i < n; ++i) {
+            const auto f = m[i*n + c] * inv;
+            for(std::size_t j = c; j < n; ++j) m[i*n + j] -= f * m[c*n + j];
+        }
+    }
+    return det.signed_value();
+}
+
+
+void test_determinant()
+{
+    const std::size_t n = 8;
+    std::mt19937_64 urng {5};
+    std::uniform_int_distribution<long long> distr {-1000, 1000};
+
+    for(int k = 0; k < 10; ++k) {
+        std::vector<long long> a;
+        std::vector<big_integer> b;
+        for(std::size_t i = 0; i < n*n; ++i) {
+            a.push_back(distr(urng));
+            b.push_back(big_integer{a.back()});
+        }
+        //|det| <= (sqrt(8) * 1000)^8 < 2^104
+        if(rns_determinant<rns4>(a, n) != exact_determinant(b, n)) {
+            throw std::logic_error("rns: determinant");
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------
+void test_small_moduli()
+{
+    //M = 255 * 256 * 7
+    if(rns_small::modulus() != big_integer{456960}) {
+        throw std::logic_error("rns: modulus");
+    }
+
+    const auto x = rns_small{123456};
+    if(x.residue<0>().value() != 123456 % 255 ||
+       x.residue<1>().value() != 123456 % 256 ||
+       x.residue<2>().value() != 123456 % 7 ||
+       x.value() != big_integer{123456} ||
+       rns_small{-1}.value() != big_integer{456959})
+    {
+        throw std::logic_error("rns: small moduli");
+    }
+
+    bool thrown = false;
+    try {
+        inverse(rns_small{2});      //2 | 256
+    } catch(std::domain_error&) {
+        thrown = true;
+    }
+    if(!thrown) throw std::logic_error("rns: inverse of non-unit");
+
+    const auto y = rns_small{11};
+    if(y * inverse(y) != rns_small{1}) {
+        throw std::logic_error("rns: inverse");
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_arithmetic<rns4>();
+        test_arithmetic<rns<choice<std::uint32_t,4294967291u>,
+                            choice<std::uint32_t,4294967279u>>>();
+        test_product();
+        test_determinant();
+        test_small_moduli();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
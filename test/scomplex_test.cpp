@@ -0,0 +1,230 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/scomplex_array.h"
+
+#include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include <iostream>
+#include <vector>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_arithmetic()
+{
+    const scomplex<T> a {T(3), T(1)};
+    const scomplex<T> b {T(2), T(-1)};
+
+    const auto p = a * b;
+    if(!approx_equal(p, scomplex<T>{T(5), T(-1)})) {
+        throw std::runtime_error{"multiplication"};
+    }
+
+    if(!approx_equal(p / b, a) || !approx_equal((a / b) * b, a)) {
+        throw std::runtime_error{"division"};
+    }
+
+    auto c = p;
+    c /= a;
+    if(!approx_equal(c, b)) {
+        throw std::runtime_error{"division assignment"};
+    }
+
+    if(!approx_equal((T(1) / a) * a, scomplex<T>{T(1), T(0)})) {
+        throw std::runtime_error{"scalar division"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_lightcone()
+{
+    const scomplex<T> a {T(3), T(1)};
+    const scomplex<T> b {T(2), T(-1)};
+
+    const auto la = make_lightcone(a);
+    const auto lb = make_lightcone(b);
+
+    if(la.plus() != T(4) || la.minus() != T(2) ||
+       !approx_equal(make_scomplex(la), a))
+    {
+        throw std::runtime_error{"lightcone conversion"};
+    }
+
+    if(!approx_equal(make_scomplex(la * lb), a * b) ||
+       !approx_equal(make_scomplex(la / lb), a / b) ||
+       !approx_equal(make_scomplex(la + lb), a + b) ||
+       !approx_equal(make_scomplex(la - lb), a - b) ||
+       !approx_equal(make_scomplex(conj(la)), conj(a)) ||
+       !approx_equal(abs2(la), abs2(a)))
+    {
+        throw std::runtime_error{"lightcone arithmetic"};
+    }
+
+    if(!approx_equal(make_scomplex(pow(la, T(3))), a * a * a) ||
+       !approx_equal(make_scomplex(inverse(la) * la), scomplex<T>{T(1), T(0)}))
+    {
+        throw std::runtime_error{"lightcone power"};
+    }
+
+    std::vector<scomplex<T>> in {a, b, a * b};
+    std::vector<lightcone_scomplex<T>> lc(in.size());
+    std::vector<scomplex<T>> out(in.size());
+    to_lightcone(in.begin(), in.end(), lc.begin());
+    pow(lc.begin(), lc.end(), T(2), lc.begin());
+    to_scomplex(lc.begin(), lc.end(), out.begin());
+    for(std::size_t i = 0; i < in.size(); ++i) {
+        if(!approx_equal(out[i], in[i] * in[i])) {
+            throw std::runtime_error{"batched lightcone"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_rapidity()
+{
+    using std::cosh;
+    using std::sinh;
+
+    for(T phi : {T(-3), T(-1e-4), T(0), T(1e-6), T(0.5), T(2)}) {
+        const auto b = from_rapidity(phi);
+        if(!approx_equal(b, scomplex<T>{cosh(phi), sinh(phi)}) ||
+           !approx_equal(abs2(b), T(1)) ||
+           !approx_equal(rapidity(b), phi))
+        {
+            throw std::runtime_error{"from_rapidity"};
+        }
+    }
+
+    //expm1 overflows
+    for(T phi : {T(-800), T(800)}) {
+        const auto b = from_rapidity(phi);
+        if(b.real() != cosh(phi) || b.imag() != sinh(phi)) {
+            throw std::runtime_error{"from_rapidity overflow"};
+        }
+    }
+    //expm1 overflows, cosh doesn't
+    {
+        using std::log;
+        const T phi = log(std::numeric_limits<T>::max()) + T(0.5);
+        const auto b = from_rapidity(phi);
+        scomplex_array<T> bs;
+        from_rapidity(&phi, &phi + 1, bs);
+        auto a = scomplex_array<T>{{T(1), T(0)}};
+        boost(a, phi);
+        if(!approx_equal(b.real() / cosh(phi), T(1)) ||
+           !approx_equal(b.imag() / sinh(phi), T(1)) ||
+           bs[0] != b || a[0] != b)
+        {
+            throw std::runtime_error{"bulk from_rapidity overflow"};
+        }
+    }
+
+    //boosts compose by adding rapidities
+    if(!approx_equal(from_rapidity(T(0.25)) * from_rapidity(T(0.5)),
+                     from_rapidity(T(0.75))))
+    {
+        throw std::runtime_error{"boost composition"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_array()
+{
+    scomplex_array<T> a {{T(3), T(1)}, {T(2), T(-1)}, {T(5), T(4)}};
+    scomplex_array<T> b {{T(1), T(0.5)}, {T(4), T(1)}, {T(-2), T(1)}};
+
+    scomplex_array<T> c;
+    multiply(a, b, c);
+    for(std::size_t k = 0; k < a.size(); ++k) {
+        if(!approx_equal(c[k], a[k] * b[k])) {
+            throw std::runtime_error{"bulk multiplication"};
+        }
+    }
+
+    divide(c, b, c);
+    for(std::size_t k = 0; k < a.size(); ++k) {
+        if(!approx_equal(c[k], a[k])) {
+            throw std::runtime_error{"bulk division"};
+        }
+    }
+
+    std::vector<T> n2;
+    abs2(a, n2);
+    conjugate(c);
+    for(std::size_t k = 0; k < a.size(); ++k) {
+        if(!approx_equal(n2[k], abs2(a[k])) ||
+           !approx_equal(c[k], conj(a[k])))
+        {
+            throw std::runtime_error{"bulk abs2/conjugate"};
+        }
+    }
+
+    const T phis[] {T(0.1), T(-0.7), T(1.5)};
+    scomplex_array<T> bs;
+    from_rapidity(phis, phis + 3, bs);
+
+    auto d = a;
+    boost(d, phis);
+    auto e = a;
+    boost(e, T(0.3));
+    for(std::size_t k = 0; k < a.size(); ++k) {
+        if(!approx_equal(bs[k], from_rapidity(phis[k])) ||
+           !approx_equal(d[k], a[k] * from_rapidity(phis[k])) ||
+           !approx_equal(e[k], a[k] * from_rapidity(T(0.3))))
+        {
+            throw std::runtime_error{"bulk boost"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    using namespace am::num;
+
+    try {
+        test_arithmetic<float>();
+        test_arithmetic<double>();
+        test_arithmetic<long double>();
+
+        test_lightcone<float>();
+        test_lightcone<double>();
+        test_lightcone<long double>();
+
+        test_rapidity<float>();
+        test_rapidity<double>();
+        test_rapidity<long double>();
+
+        test_array<float>();
+        test_array<double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
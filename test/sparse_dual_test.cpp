@@ -0,0 +1,199 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/sparse_dual.h"
+
+#include <stdexcept>
+#include <cstdint>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+
+using namespace am;
+using namespace am::num;
+
+
+//-------------------------------------------------------------------
+template<class D>
+D test_function(const D& x, const D& y)
+{
+    return (sin(x) * exp(y)) + (sqrt(x * y) / atan(y)) - tanh(x / y) +
+            cosh(y) * log(x);
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_against_dual()
+{
+    using sd = sparse_dual<T>;
+
+    const T x0 = T(0.75);
+    const T y0 = T(1.5);
+
+    const auto f = test_function(sd{x0, 3}, sd{y0, 7});
+    const auto fx = test_function(dual<T>{x0, T(1)}, dual<T>{y0, T(0)});
+    const auto fy = test_function(dual<T>{x0, T(0)}, dual<T>{y0, T(1)});
+
+    if(f.size() != 2 ||
+       !approx_equal(f.real(), fx.real()) ||
+       !approx_equal(f.imag(3), fx.imag()) ||
+       !approx_equal(f.imag(7), fy.imag()) ||
+       f.imag(5) != T(0))
+    {
+        throw std::runtime_error{"sparse_dual vs. dual"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_functions()
+{
+    using sd = sparse_dual<T>;
+    using std::abs;
+
+    const T x0 = T(0.4);
+    const T h = T(1e-6);
+    const sd x {x0, 0};
+
+    //central finite differences
+    const auto check = [&](auto f, const char* name) {
+        const auto fd = (f(sd{x0 + h}).real() - f(sd{x0 - h}).real()) / (T(2)*h);
+        if(abs(f(x).imag(0) - fd) > T(1e-6)) throw std::runtime_error{name};
+    };
+
+    check([](const sd& a) { return sin(a); }, "sin");
+    check([](const sd& a) { return cos(a); }, "cos");
+    check([](const sd& a) { return tan(a); }, "tan");
+    check([](const sd& a) { return asin(a); }, "asin");
+    check([](const sd& a) { return acos(a); }, "acos");
+    check([](const sd& a) { return atan(a); }, "atan");
+    check([](const sd& a) { return sinh(a); }, "sinh");
+    check([](const sd& a) { return cosh(a); }, "cosh");
+    check([](const sd& a) { return tanh(a); }, "tanh");
+    check([](const sd& a) { return asinh(a); }, "asinh");
+    check([](const sd& a) { return acosh(a + T(1)); }, "acosh");
+    check([](const sd& a) { return atanh(a); }, "atanh");
+    check([](const sd& a) { return exp(a); }, "exp");
+    check([](const sd& a) { return exp2(a); }, "exp2");
+    check([](const sd& a) { return expm1(a); }, "expm1");
+    check([](const sd& a) { return log(a); }, "log");
+    check([](const sd& a) { return log2(a); }, "log2");
+    check([](const sd& a) { return log10(a); }, "log10");
+    check([](const sd& a) { return log1p(a); }, "log1p");
+    check([](const sd& a) { return sqrt(a); }, "sqrt");
+    check([](const sd& a) { return cbrt(a); }, "cbrt");
+    check([](const sd& a) { return erf(a); }, "erf");
+    check([](const sd& a) { return erfc(a); }, "erfc");
+    check([](const sd& a) { return pow(a, T(2.5)); }, "pow");
+    check([](const sd& a) { return pow(a, a); }, "pow");
+    check([](const sd& a) { return T(2) / a - a; }, "division");
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_mixed_operands()
+{
+    using sd = sparse_dual<T>;
+
+    const sd x {T(2), 0};
+    if((x + 1) != (x + T(1)) || (1 + x) != (T(1) + x) ||
+       (x - 1) != (x - T(1)) || (1 - x) != (T(1) - x) ||
+       (2 * x) != (T(2) * x) || (x * 2) != (x * T(2)) ||
+       (x / 2) != (x / T(2)) || (1 / x) != (T(1) / x))
+    {
+        throw std::runtime_error{"integer operands"};
+    }
+
+    //sinh and cosh overflow
+    for(T r : {T(-800), T(800)}) {
+        const auto t = tanh(sd{r, 0});
+        if(t.real() != std::tanh(r) || t.imag(0) != T(0)) {
+            throw std::runtime_error{"tanh overflow"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_many_variables()
+{
+    using sd = sparse_dual<T,2>;
+
+    //sum of squares: gradient 2*x_i, more entries than inline capacity
+    const int n = 100;
+    std::vector<sd> xs;
+    for(int i = n; i > 0; --i) xs.emplace_back(T(i), typename sd::index_type(i));
+
+    sd s {T(0)};
+    for(const auto& x : xs) s += x * x;
+
+    if(s.size() != std::size_t(n)) {
+        throw std::runtime_error{"number of partials"};
+    }
+    for(int i = 1; i <= n; ++i) {
+        if(s.imag(typename sd::index_type(i)) != T(2*i)) {
+            throw std::runtime_error{"gradient"};
+        }
+    }
+
+    //storage is released from destructors
+    static_assert(noexcept(detail::block_pool<int>::deallocate(nullptr, 1)),
+                  "block_pool::deallocate must not throw");
+
+    //copy & move
+    auto c = s;
+    auto m = std::move(c);
+    if(m != s || !c.empty()) {
+        throw std::runtime_error{"copy/move"};
+    }
+
+    sd p {T(1)};
+    p.insert(5, T(1));
+    p.insert(2, T(2));
+    p.insert(5, T(3));
+    if(p.size() != 2 || p.imag(2) != T(2) || p.imag(5) != T(4)) {
+        throw std::runtime_error{"insert"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    using namespace am::num;
+
+    try {
+        test_against_dual<double>();
+        test_against_dual<long double>();
+
+        test_functions<double>();
+
+        test_mixed_operands<float>();
+        test_mixed_operands<double>();
+
+        test_many_variables<float>();
+        test_many_variables<double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}